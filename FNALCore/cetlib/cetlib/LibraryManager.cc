@@ -8,6 +8,8 @@
 
 extern "C" {
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
 }
 
 #include <algorithm>
@@ -20,17 +22,32 @@ extern "C" {
 #include <sstream>
 #include <vector>
 
+namespace {
+  // Ask the kernel to start reading the file into the page cache.
+  void read_ahead(std::string const & path)
+  {
+#ifdef POSIX_FADV_WILLNEED
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd != -1) {
+      ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+      ::close(fd);
+    }
+#else
+    (void) path;
+#endif
+  }
+}
+
 cet::LibraryManager::LibraryManager(std::string const & lib_type,
                                     std::string pattern)
   :
   lib_type_(lib_type),
-  lib_loc_map_(),
-  spec_trans_map_(),
-  good_spec_trans_map_(),
-  lib_ptr_map_()
+  index_(),
+  lib_ptr_map_(),
+  lib_ptr_mutex_(),
+  prefetch_mutex_(),
+  prefetch_future_()
 {
-  using std::placeholders::_1;
-
   // TODO: We could also consider searching the ld.so.conf list, if
   // anyone asks for it.
   static search_path const
@@ -39,28 +56,67 @@ cet::LibraryManager::LibraryManager(std::string const & lib_type,
       "DY"
 #endif
       "LD_LIBRARY_PATH");
-  std::vector<std::string> matches;
-  ld_lib_path.find_files(shlib_prefix() + pattern +
-                         lib_type + dllExtPattern(),
-                         matches);
+  index_ = library_index::get(ld_lib_path, lib_type, pattern,
+                              [&](library_index::entry & index) {
+                                std::vector<std::string> matches;
+                                ld_lib_path.find_files(shlib_prefix() + pattern +
+                                                       lib_type + dllExtPattern(),
+                                                       matches);
+                                scan(index, matches);
+                              });
+}
+
+void
+cet::LibraryManager::scan(library_index::entry & index,
+                          std::vector<std::string> const & matches) const
+{
   // Note the use of reverse iterators here: files found earlier in the
   // vector will therefore overwrite those found later, which is what
   // we want from "search path"-type behavior.
-  std::for_each(matches.rbegin(), matches.rend(),
-                std::bind(&LibraryManager::lib_loc_map_inserter,
-                          this,
-                          _1));
+  for (auto i = matches.rbegin(), e = matches.rend(); i != e; ++i) {
+#if BOOST_FILESYSTEM_VERSION == 2
+    index.lib_loc_map[boost::filesystem::path(*i).filename()] = *i;
+#elif BOOST_FILESYSTEM_VERSION == 3
+    index.lib_loc_map[boost::filesystem::path(*i).filename().native()] = *i;
+#else
+#error unknown BOOST_FILESYSTEM_VERSION!
+#endif
+  }
   // Build the spec to long library name translation table.
-  std::for_each(lib_loc_map_.begin(), lib_loc_map_.end(),
-                std::bind(&LibraryManager::spec_trans_map_inserter,
-                          this,
-                          _1,
-                          std::ref(lib_type)));
-  // Build the fast good-translation table.
-  std::for_each(spec_trans_map_.begin(), spec_trans_map_.end(),
-                std::bind(&LibraryManager::good_spec_trans_map_inserter,
-                          this,
-                          _1));
+  boost::regex const short_spec("([^_]+)_" + lib_type_ + dllExtPattern() + '$');
+  boost::regex const underscores("(_+)");
+  boost::regex const stripper("^lib(.*)/" + lib_type_ + "\\..*$");
+  for (auto const & entry : index.lib_loc_map) {
+    // First obtain short spec.
+    boost::match_results<std::string::const_iterator> match_results;
+    if (boost::regex_search(entry.first, match_results, short_spec)) {
+      index.spec_trans_map[match_results[1]].insert(entry.second);
+    }
+    else {
+      throw exception("LogicError")
+          << "Internal error in LibraryManager::scan for entry "
+          << entry.first
+          << " with pattern "
+          <<  short_spec.str();
+    }
+    // Next, convert library filename to full libspec.
+    std::ostringstream lib_name;
+    std::ostream_iterator<char, char> oi(lib_name);
+    boost::regex_replace(oi, entry.first.begin(),
+                         entry.first.end(),
+                         underscores,
+                         std::string("(?1/)"),
+                         boost::match_default | boost::format_all);
+    std::string lib_name_str = lib_name.str();
+    if (boost::regex_search(lib_name_str, match_results, stripper)) {
+      index.spec_trans_map[match_results[1]].insert(entry.second);
+    }
+    else {
+      throw exception("LogicError")
+          << "Internal error in LibraryManager::scan stripping "
+          << lib_name.str();
+    }
+  }
 }
 
 size_t
@@ -86,8 +142,8 @@ void
 cet::LibraryManager::loadAllLibraries() const
 {
   for (lib_loc_map_t::const_iterator
-       i = lib_loc_map_.begin(),
-       end_iter = lib_loc_map_.end();
+       i = index_->lib_loc_map.begin(),
+       end_iter = index_->lib_loc_map.end();
        i != end_iter;
        ++i) {
     if (get_lib_ptr(i->second) == nullptr) {
@@ -101,9 +157,58 @@ cet::LibraryManager::loadAllLibraries() const
   }
 }
 
+void
+cet::LibraryManager::prefetch(std::vector<std::string> libspecs,
+                              prefetch_mode mode) const
+{
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  if (prefetch_future_.valid()) {
+    prefetch_future_.wait();
+  }
+  prefetch_future_ =
+    std::async(std::launch::async,
+               [this, mode](std::vector<std::string> const & specs) {
+                 prefetch_(specs, mode);
+               },
+               std::move(libspecs));
+}
+
+void
+cet::LibraryManager::waitForPrefetch() const
+{
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  if (prefetch_future_.valid()) {
+    prefetch_future_.wait();
+  }
+}
+
+void
+cet::LibraryManager::prefetch_(std::vector<std::string> const & libspecs,
+                               prefetch_mode mode) const
+{
+  // The index is not changed after construction, so needs no guard.
+  std::vector<std::string> paths;
+  for (auto const & libspec : libspecs) {
+    auto const trans = index_->good_spec_trans_map.find(libspec);
+    if (trans != index_->good_spec_trans_map.end()) {
+      paths.push_back(trans->second);
+    }
+  }
+  // Start all the reads before waiting for any of them in dlopen().
+  for (auto const & path : paths) {
+    read_ahead(path);
+  }
+  if (mode == prefetch_mode::load) {
+    for (auto const & path : paths) {
+      get_lib_ptr(path);
+    }
+  }
+}
+
 bool
 cet::LibraryManager::libraryIsLoaded(std::string const & path) const
 {
+  std::lock_guard<std::mutex> lock(lib_ptr_mutex_);
   return (lib_ptr_map_.find(path) != lib_ptr_map_.end());
 }
 
@@ -113,8 +218,8 @@ cet::LibraryManager::libraryIsLoadable(std::string const & path) const
   // TODO: If called with any frequency, this should be made more
   // efficient.
   lib_loc_map_t::const_iterator
-  i = lib_loc_map_.begin(),
-  end_iter = lib_loc_map_.end();
+  i = index_->lib_loc_map.begin(),
+  end_iter = index_->lib_loc_map.end();
   for (;
        i != end_iter;
        ++i) {
@@ -123,76 +228,26 @@ cet::LibraryManager::libraryIsLoadable(std::string const & path) const
   return false;
 }
 
-void
-cet::LibraryManager::
-lib_loc_map_inserter(std::string const & path)
-{
-#if BOOST_FILESYSTEM_VERSION == 2
-  lib_loc_map_[boost::filesystem::path(path).filename()] = path;
-#elif BOOST_FILESYSTEM_VERSION == 3
-  lib_loc_map_[boost::filesystem::path(path).filename().native()] = path;
-#else
-#error unknown BOOST_FILESYSTEM_VERSION!
-#endif
-}
-
-void
-cet::LibraryManager::
-spec_trans_map_inserter(lib_loc_map_t::value_type const & entry,
-                        std::string const & lib_type)
-{
-  // First obtain short spec.
-  boost::regex e("([^_]+)_" + lib_type + dllExtPattern() + '$');
-  boost::match_results<std::string::const_iterator> match_results;
-  if (boost::regex_search(entry.first, match_results, e)) {
-    spec_trans_map_[match_results[1]].insert(entry.second);
-  }
-  else {
-    throw exception("LogicError")
-        << "Internal error in spec_trans_map_inserter for entry "
-        << entry.first
-        << " with pattern "
-        <<  e.str();
-  }
-  // Next, convert library filename to full libspec.
-  std::ostringstream lib_name;
-  std::ostream_iterator<char, char> oi(lib_name);
-  boost::regex_replace(oi, entry.first.begin(),
-                       entry.first.end(),
-                       boost::regex("(_+)"),
-                       std::string("(?1/)"),
-                       boost::match_default | boost::format_all);
-  boost::regex stripper("^lib(.*)/" + lib_type + "\\..*$");
-  std::string lib_name_str = lib_name.str();
-  if (boost::regex_search(lib_name_str, match_results, stripper)) {
-    spec_trans_map_[match_results[1]].insert(entry.second);
-  }
-  else {
-    throw exception("LogicError")
-        << "Internal error in spec_trans_map_inserter stripping "
-        << lib_name.str();
-  }
-}
-
-void
-cet::LibraryManager::
-good_spec_trans_map_inserter(spec_trans_map_t::value_type const & entry)
-{
-  if (entry.second.size() == 1) {
-    good_spec_trans_map_[entry.first] = *(entry.second.begin());
-  }
-}
-
 void * cet::LibraryManager::get_lib_ptr(std::string const & lib_loc) const
 {
-  lib_ptr_map_t::iterator it = lib_ptr_map_.find(lib_loc);
-  if (it == lib_ptr_map_.end() || it->second == nullptr) {
-    dlerror();
-    void * ptr = dlopen(lib_loc.c_str(), RTLD_LAZY | RTLD_GLOBAL);
-    lib_ptr_map_[lib_loc] = ptr;
-    return ptr;
+  {
+    std::lock_guard<std::mutex> lock(lib_ptr_mutex_);
+    lib_ptr_map_t::iterator it = lib_ptr_map_.find(lib_loc);
+    if (it != lib_ptr_map_.end() && it->second != nullptr) {
+      return it->second;
+    }
+  }
+  // Not under the lock, so that a prefetch loading other libraries
+  // doesn't hold us up; if both load this one, dlopen() returns the
+  // same handle to each.
+  dlerror();
+  void * ptr = dlopen(lib_loc.c_str(), RTLD_LAZY | RTLD_GLOBAL);
+  std::lock_guard<std::mutex> lock(lib_ptr_mutex_);
+  void * & entry = lib_ptr_map_[lib_loc];
+  if (entry == nullptr) {
+    entry = ptr;
   }
-  return it->second;
+  return ptr;
 }
 
 void *
@@ -214,16 +269,16 @@ getSymbolByLibspec_(std::string const & libspec,
         << "must be rectified.\n";
   }
   good_spec_trans_map_t::const_iterator trans =
-    good_spec_trans_map_.find(libspec);
-  if (trans == good_spec_trans_map_.end()) {
+    index_->good_spec_trans_map.find(libspec);
+  if (trans == index_->good_spec_trans_map.end()) {
     // No good translation => zero or too many
     std::ostringstream error_msg;
     error_msg
         << "Library specificaton \""
         << libspec << "\":";
     spec_trans_map_t::const_iterator bad_trans =
-      spec_trans_map_.find(libspec);
-    if (bad_trans != spec_trans_map_.end()) {
+      index_->spec_trans_map.find(libspec);
+    if (bad_trans != index_->spec_trans_map.end()) {
       error_msg << " corresponds to multiple libraries:\n";
       std::copy(bad_trans->second.begin(),
                 bad_trans->second.end(),
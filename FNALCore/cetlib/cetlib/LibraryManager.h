@@ -2,10 +2,13 @@
 #define art_Utilities_LibraryManager_h
 
 #include "cetlib/hard_cast.h"
+#include "cetlib/library_index.h"
 #include "cetlib/shlib_utils.h"
 
 #include <cstring>
+#include <future>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -19,6 +22,8 @@ public:
   // Create a LibraryManager that searches through LD_LIBRARY_PATH
   // for dynamically loadable libraries having the given lib_type.
   // If LD_LIBRARY_PATH is not defined, then no libraries are found.
+  // The search is shared with other LibraryManagers, and may be
+  // served from an index cache file: see cetlib/library_index.h.
   // Library names are expected to be of the form:
   //      libaa_bb_cc_xyz_<lib_type>.<ext>
   //  and where <ext> is provided automatically as appropriate for
@@ -109,6 +114,19 @@ public:
   // efficient the implementation will need to be improved.
   bool libraryIsLoadable(std::string const & path) const;
 
+  // Load the libraries of the given libspecs on a background thread,
+  // so that later requests for their symbols find them ready. Each
+  // library's file is first read ahead into the page cache and, with
+  // prefetch_mode::load, then dlopen()ed. Libspecs not corresponding to
+  // exactly one library, and libraries which fail to load, are skipped:
+  // they are reported when their symbols are requested. Returns at
+  // once, after any earlier prefetch has finished.
+  enum class prefetch_mode { readahead, load };
+  void prefetch(std::vector<std::string> libspecs,
+                prefetch_mode mode = prefetch_mode::load) const;
+  // Wait for the prefetch in progress, if any, to finish.
+  void waitForPrefetch() const;
+
   // This manager's library type
   std::string libType() const { return lib_type_; }
 
@@ -122,11 +140,11 @@ private:
   // Private helper functions.
   static std::string dllExtPattern();
 
-  void lib_loc_map_inserter(std::string const & path);
-  void spec_trans_map_inserter(lib_loc_map_t::value_type const & entry,
-                               std::string const & lib_type);
-  void good_spec_trans_map_inserter(spec_trans_map_t::value_type const & entry);
+  void scan(library_index::entry & index,
+            std::vector<std::string> const & matches) const;
   void * get_lib_ptr(std::string const & lib_loc) const;
+  void prefetch_(std::vector<std::string> const & libspecs,
+                 prefetch_mode mode) const;
   void * getSymbolByLibspec_(std::string const & libspec,
                              std::string const & sym_name,
                              bool should_throw_on_dlsym = true) const;
@@ -135,14 +153,17 @@ private:
                           bool should_throw_on_dlsym = true) const;
 
   std::string lib_type_; // eg _plugin.
-  // Map of library filename -> full path.
-  lib_loc_map_t lib_loc_map_;
-  // Map of spec -> full path.
-  spec_trans_map_t spec_trans_map_;
-  // Map of only good translations.
-  good_spec_trans_map_t good_spec_trans_map_;
-  // Cache of already-loaded libraries.
+  // Library filename -> full path, spec -> full paths, and only good
+  // translations; shared with other LibraryManagers.
+  library_index::entry_ptr index_;
+  // Cache of already-loaded libraries, and its guard: a prefetch may
+  // be loading libraries while symbols are requested.
   mutable lib_ptr_map_t lib_ptr_map_;
+  mutable std::mutex lib_ptr_mutex_;
+  // The prefetch in progress, if any; declared last so that it is
+  // finished before the other members are destroyed.
+  mutable std::mutex prefetch_mutex_;
+  mutable std::future<void> prefetch_future_;
 };
 
 inline
@@ -202,8 +223,8 @@ size_t cet::LibraryManager::getLoadableLibraries(OutIter dest) const
 {
   size_t count = 0;
   lib_loc_map_t::const_iterator
-  i = lib_loc_map_.begin(),
-  end_iter = lib_loc_map_.end();
+  i = index_->lib_loc_map.begin(),
+  end_iter = index_->lib_loc_map.end();
   for (;
        i != end_iter;
        ++i, ++count) {
@@ -263,6 +284,7 @@ template <class OutIter>
 size_t cet::LibraryManager::getLoadedLibraries(OutIter dest) const
 {
   size_t count = 0;
+  std::lock_guard<std::mutex> lock(lib_ptr_mutex_);
   lib_ptr_map_t::const_iterator
   i = lib_ptr_map_.begin(),
   end_iter = lib_ptr_map_.end();
@@ -279,8 +301,8 @@ size_t cet::LibraryManager::getValidLibspecs(OutIter dest) const
 {
   size_t count = 0;
   spec_trans_map_t::const_iterator
-  i = spec_trans_map_.begin(),
-  end_iter = spec_trans_map_.end();
+  i = index_->spec_trans_map.begin(),
+  end_iter = index_->spec_trans_map.end();
   for (;
        i != end_iter;
        ++i, ++count) {
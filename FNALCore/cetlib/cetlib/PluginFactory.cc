@@ -8,9 +8,13 @@
 cet::PluginFactory::
 PluginFactory(std::string const & suffix)
   :
-  lm_(suffix),
+  suffix_(suffix),
+  lmOnce_(),
+  lm_(),
   releaseVersionString_(),
-  releaseVersionFunc_()
+  releaseVersionFunc_(),
+  symbolsMutex_(),
+  symbols_()
 {
 }
 
@@ -28,3 +32,49 @@ releaseVersion_()
   }
   return result;
 }
+
+void *
+cet::PluginFactory::
+symbol_(std::string const & libspec,
+        std::string const & funcname,
+        bool should_throw_on_dlsym)
+{
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(symbolsMutex_);
+    auto const lib = symbols_.find(libspec);
+    if (lib != symbols_.end()) {
+      auto const it = lib->second.find(funcname);
+      if (it != lib->second.end()) {
+        return it->second;
+      }
+    }
+  }
+  // Not found: search without the lock, since loading a library runs
+  // its static initializers.
+  void * symbol = nullptr;
+  if (StaticPluginRegistry::has(suffix_, libspec)) {
+    symbol = StaticPluginRegistry::find(suffix_, libspec, funcname);
+    if (symbol == nullptr && should_throw_on_dlsym) {
+      throw exception("Configuration")
+        << "Unable to find requested symbol "
+        << funcname
+        << " in statically linked plugin "
+        << libspec
+        << " of type \""
+        << suffix_
+        << "\"\n";
+    }
+  }
+  else {
+    std::call_once(lmOnce_, [this]{ lm_.reset(new LibraryManager(suffix_)); });
+    symbol = should_throw_on_dlsym ?
+             lm_->getSymbolByLibspec<void *>(libspec, funcname) :
+             lm_->getSymbolByLibspec<void *>(libspec, funcname, LibraryManager::nothrow);
+  }
+  if (symbol == nullptr) {
+    return symbol;
+  }
+  // Another thread may have found it meanwhile: keep the first.
+  std::lock_guard<std::shared_timed_mutex> lock(symbolsMutex_);
+  return symbols_[libspec].emplace(funcname, symbol).first->second;
+}
@@ -18,14 +18,31 @@
 // dynamic libraries, there is no type safety: a found symbol of the
 // correct name will be coerced to the desired function type. If that
 // type is inccorrect, chaos is likely to ensue.
+//
+// Plugins linked into the program and registered with
+// cet::StaticPluginRegistry are found first, without any search of
+// LD_LIBRARY_PATH; the search is made only when a plugin is not so
+// registered.
+//
+// Each factory remembers the functions it has found, so repeated calls
+// for the same libspec and function name cost one hash lookup rather
+// than a library search and a dlsym(); callers needing even less may
+// resolve() a function once and call the pointer directly. Failed
+// lookups are not remembered. Lookups share a reader lock; no lock is
+// held while a library is searched for or loaded, so a plugin's static
+// initializers may themselves use the factory.
 ////////////////////////////////////////////////////////////////////////
 
 #include "cetlib/LibraryManager.h"
+#include "cetlib/StaticPluginRegistry.h"
 #include "cetlib/detail/wrapLibraryManagerException.h"
 #include "cetlib/exception.h"
 
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 namespace cet {
   class PluginFactory;
@@ -69,6 +86,19 @@ public:
         LibraryManager::nothrow_t)
 -> RESULT_TYPE (*) (ARGS...);
 
+  // Find a function once, to call it many times, e.g.:
+  //
+  //   auto maker = pf.resolve<std::unique_ptr<Base>, int>(libspec,
+  //                                                       "makePlugin");
+  //   for (int i = 0; i != n; ++i) { plugins.push_back(maker(i)); }
+  //
+  // Throws as find() does.
+  template <typename RESULT_TYPE, typename...ARGS>
+  auto
+  resolve(std::string const & libspec,
+          std::string const & funcname)
+-> RESULT_TYPE (*) (ARGS...);
+
   // May define subclasses.
   virtual ~PluginFactory() = default;
 
@@ -79,9 +109,24 @@ private:
 
   std::string releaseVersion_();
 
-  LibraryManager lm_;
+  // The address of funcname in the library for libspec, found once.
+  // The address doesn't depend on the type the caller wants, so the
+  // cache is keyed by libspec and name alone.
+  void * symbol_(std::string const & libspec,
+                 std::string const & funcname,
+                 bool should_throw_on_dlsym);
+
+  typedef std::unordered_map<std::string,
+                             std::unordered_map<std::string, void *> >
+    symbol_map_t;
+
+  std::string const suffix_;
+  std::once_flag lmOnce_;
+  std::unique_ptr<LibraryManager> lm_; // Made when first needed.
   std::string releaseVersionString_;
   std::function<std::string ()> releaseVersionFunc_;
+  std::shared_timed_mutex symbolsMutex_;
+  symbol_map_t symbols_; // libspec -> funcname -> address
 };
 
 inline
@@ -118,9 +163,9 @@ find(std::string const & libspec,
      std::string const & funcname)
 -> RESULT_TYPE (*) (ARGS...)
 {
-  RESULT_TYPE (*symbol) (ARGS...)  = nullptr;
+  void * symbol = nullptr;
   try {
-    lm_.getSymbolByLibspec(libspec, funcname, symbol);
+    symbol = symbol_(libspec, funcname, true);
   }
   catch (exception & e) {
     detail::wrapLibraryManagerException(e,
@@ -134,7 +179,7 @@ find(std::string const & libspec,
       << " with version " << releaseVersion_()
       << " has internal symbol definition problems: consult an expert.";
   }
-  return symbol;
+  return hard_cast<RESULT_TYPE (*) (ARGS...)>(symbol);
 }
 
 template <typename RESULT_TYPE, typename... ARGS>
@@ -143,10 +188,21 @@ auto
 cet::PluginFactory::
 find(std::string const & libspec,
      std::string const & funcname,
-     LibraryManager::nothrow_t nothrow)
+     LibraryManager::nothrow_t)
+-> RESULT_TYPE (*) (ARGS...)
+{
+  return hard_cast<RESULT_TYPE (*) (ARGS...)>(symbol_(libspec, funcname, false));
+}
+
+template <typename RESULT_TYPE, typename... ARGS>
+inline
+auto
+cet::PluginFactory::
+resolve(std::string const & libspec,
+        std::string const & funcname)
 -> RESULT_TYPE (*) (ARGS...)
 {
-  return lm_.getSymbolByLibspec<RESULT_TYPE (*) (ARGS...)>(libspec, funcname, nothrow);
+  return find<RESULT_TYPE, ARGS...>(libspec, funcname);
 }
 #endif /* cetlib_PluginFactory_h */
 
@@ -0,0 +1,85 @@
+#include "cetlib/StaticPluginRegistry.h"
+
+#include <map>
+#include <mutex>
+
+namespace {
+  // lib_type -> libspec -> funcname -> address
+  typedef std::map<std::string,
+                   std::map<std::string,
+                            std::map<std::string, void *> > > registry_t;
+
+  struct registry_state {
+    std::mutex mutex;
+    registry_t functions;
+  };
+
+  // Constructed on first use, so registrations from any translation
+  // unit's static initialization find it ready.
+  registry_state &
+  state()
+  {
+    static registry_state s;
+    return s;
+  }
+}
+
+void
+cet::StaticPluginRegistry::
+add(std::string const & lib_type,
+    std::string const & libspec,
+    std::string const & funcname,
+    void * address)
+{
+  registry_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.functions[lib_type][libspec][funcname] = address;
+}
+
+bool
+cet::StaticPluginRegistry::
+has(std::string const & lib_type,
+    std::string const & libspec)
+{
+  registry_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto const type = s.functions.find(lib_type);
+  return type != s.functions.end() &&
+         type->second.find(libspec) != type->second.end();
+}
+
+void *
+cet::StaticPluginRegistry::
+find(std::string const & lib_type,
+     std::string const & libspec,
+     std::string const & funcname)
+{
+  registry_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto const type = s.functions.find(lib_type);
+  if (type == s.functions.end()) {
+    return nullptr;
+  }
+  auto const spec = type->second.find(libspec);
+  if (spec == type->second.end()) {
+    return nullptr;
+  }
+  auto const func = spec->second.find(funcname);
+  return func == spec->second.end() ? nullptr : func->second;
+}
+
+std::vector<std::string>
+cet::StaticPluginRegistry::
+libspecs(std::string const & lib_type)
+{
+  std::vector<std::string> result;
+  registry_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto const type = s.functions.find(lib_type);
+  if (type != s.functions.end()) {
+    for (auto const & spec : type->second) {
+      result.push_back(spec.first);
+    }
+  }
+  return result;
+}
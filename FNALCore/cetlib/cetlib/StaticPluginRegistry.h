@@ -0,0 +1,119 @@
+#ifndef cetlib_StaticPluginRegistry_h
+#define cetlib_StaticPluginRegistry_h
+////////////////////////////////////////////////////////////////////////
+// StaticPluginRegistry
+//
+// Process-wide registry of plugin functions linked into the program,
+// consulted by cet::PluginFactory before it searches LD_LIBRARY_PATH
+// for a plugin library. A plugin found here is created without any
+// filesystem access or dlopen().
+//
+// A plugin translation unit linked into a program or library registers
+// its functions at static-initialization time:
+//
+//   namespace {
+//     std::unique_ptr<Base> makeThing(std::string const & name) { ... }
+//   }
+//   CET_REGISTER_STATIC_PLUGIN_FUNC(plugin, thing, makePlugin, makeThing)
+//   DEFINE_STATIC_BASIC_PLUGINTYPE_FUNC(plugin, thing, Base)
+//
+// after which BasicPluginFactory("plugin").makePlugin<...>("thing", ...)
+// calls makeThing. The first two arguments are the factory's suffix
+// (library type) and the plugin's libspec; the functions should have
+// internal linkage, so several plugins may be linked together. When
+// linking such a unit from a static archive, make sure the linker keeps
+// it (e.g. with --whole-archive).
+//
+// The same source may also be built as a plugin library by defining its
+// extern "C" functions instead; see MessageService/plugins in
+// messagefacility for sources which do either, according to
+// CET_STATIC_PLUGINS.
+////////////////////////////////////////////////////////////////////////
+
+#include "cetlib/PluginTypeDeducer.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace cet {
+  class StaticPluginRegistry;
+}
+
+class cet::StaticPluginRegistry {
+public:
+  StaticPluginRegistry() = delete;
+
+  // Register address as funcname of the plugin libspec of lib_type.
+  static void add(std::string const & lib_type,
+                  std::string const & libspec,
+                  std::string const & funcname,
+                  void * address);
+  template <typename F>
+  static void add(std::string const & lib_type,
+                  std::string const & libspec,
+                  std::string const & funcname,
+                  F * function);
+
+  // Whether any function of libspec is registered.
+  static bool has(std::string const & lib_type,
+                  std::string const & libspec);
+
+  // The address of funcname of libspec, or nullptr.
+  static void * find(std::string const & lib_type,
+                     std::string const & libspec,
+                     std::string const & funcname);
+
+  // The registered libspecs of lib_type, sorted.
+  static std::vector<std::string> libspecs(std::string const & lib_type);
+
+  // Registers a function on construction, for use at namespace scope.
+  struct registrar {
+    template <typename F>
+    registrar(char const * lib_type,
+              char const * libspec,
+              char const * funcname,
+              F * function)
+    {
+      add(lib_type, libspec, funcname, function);
+    }
+  };
+};
+
+template <typename F>
+inline
+void
+cet::StaticPluginRegistry::
+add(std::string const & lib_type,
+    std::string const & libspec,
+    std::string const & funcname,
+    F * function)
+{
+  // The inverse of hard_cast.
+  void * address;
+  static_assert(sizeof(address) == sizeof(function),
+                "function pointers must be the size of void *");
+  std::memcpy(&address, &function, sizeof(address));
+  add(lib_type, libspec, funcname, address);
+}
+
+#define CET_STATIC_PLUGIN_CAT_(a, b) a ## b
+#define CET_STATIC_PLUGIN_CAT(a, b) CET_STATIC_PLUGIN_CAT_(a, b)
+
+#define CET_REGISTER_STATIC_PLUGIN_FUNC(lib_type, libspec, funcname, function) \
+  namespace {                                                           \
+    cet::StaticPluginRegistry::registrar const                          \
+    CET_STATIC_PLUGIN_CAT(cet_static_plugin_, __LINE__)                 \
+      (#lib_type, #libspec, #funcname, function);                       \
+  }
+
+// The static counterpart of DEFINE_BASIC_PLUGINTYPE_FUNC.
+#define DEFINE_STATIC_BASIC_PLUGINTYPE_FUNC(lib_type, libspec, base)     \
+  CET_REGISTER_STATIC_PLUGIN_FUNC(lib_type, libspec, pluginType,        \
+    +[]() -> std::string { return cet::PluginTypeDeducer<base>::value; })
+
+#endif /* cetlib_StaticPluginRegistry_h */
+
+// Local Variables:
+// mode: c++
+// End:
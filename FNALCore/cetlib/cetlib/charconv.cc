@@ -0,0 +1,484 @@
+// ======================================================================
+//
+// charconv: locale-independent conversions between numbers and
+//           characters, into and out of caller-supplied buffers
+//
+// ======================================================================
+
+#include "cetlib/charconv.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <locale.h>
+#include <string>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+using cet::chars_format;
+using cet::from_chars_result;
+using cet::to_chars_result;
+
+char const cet::detail::digit_pairs[201] =
+  "00010203040506070809" "10111213141516171819"
+  "20212223242526272829" "30313233343536373839"
+  "40414243444546474849" "50515253545556575859"
+  "60616263646566676869" "70717273747576777879"
+  "80818283848586878889" "90919293949596979899";
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  // Puts the calling thread in the "C" locale for the scope's lifetime,
+  // whatever the global locale.
+  class c_locale_scope
+  {
+  public:
+    c_locale_scope( )
+      : old_( ::uselocale(c_locale()) )
+    { }
+    ~c_locale_scope( )
+    { ::uselocale(old_); }
+
+    c_locale_scope( c_locale_scope const & ) = delete;
+    c_locale_scope & operator = ( c_locale_scope const & ) = delete;
+
+  private:
+    static locale_t
+      c_locale( )
+    {
+      static locale_t const c = ::newlocale(LC_ALL_MASK, "C", locale_t(0));
+      return c;
+    }
+
+    locale_t  old_;
+  };
+
+  inline float        strto( char const * s, char ** e, float       * ) { return std::strtof (s, e); }
+  inline double       strto( char const * s, char ** e, double      * ) { return std::strtod (s, e); }
+  inline long double  strto( char const * s, char ** e, long double * ) { return std::strtold(s, e); }
+
+  // The printf format for T in the given conversion.
+  template< class T >
+  void
+    make_format( char (&fmt)[8], char conversion )
+  {
+    char * p = fmt;
+    *p++ = '%';  *p++ = '.';  *p++ = '*';
+    if( std::is_same<T, long double>::value )
+      *p++ = 'L';
+    *p++ = conversion;
+    *p = '\0';
+  }
+
+  inline char
+    conversion( chars_format fmt )
+  {
+    switch( fmt ) {
+      case chars_format::scientific: return 'e';
+      case chars_format::fixed:      return 'f';
+      default:                       return 'g';
+    }
+  }
+
+  // Copy the n characters of buf to [first, last), if they fit.
+  to_chars_result
+    emit( char const * buf, int n, char * first, char * last )
+  {
+    if( n < 0 || n > last - first )
+      return { last, std::errc::value_too_large };
+    std::memcpy(first, buf, n);
+    return { first + n, std::errc() };
+  }
+
+  template< class T >
+  to_chars_result
+    format( char * first, char * last, T value, char conv, int precision )
+  {
+    char fmt[8];
+    make_format<T>(fmt, conv);
+    c_locale_scope c;
+    char buf[128];
+    int const n = std::snprintf(buf, sizeof buf, fmt, precision, value);
+    if( n < int(sizeof buf) )
+      return emit(buf, n, first, last);
+
+    // Long fixed-point output: room is needed for snprintf's '\0' too.
+    if( n < last - first ) {
+      std::snprintf(first, n + 1, fmt, precision, value);
+      return { first + n, std::errc() };
+    }
+    if( n > last - first )
+      return { last, std::errc::value_too_large };
+    std::string s(n + 1, '\0');
+    std::snprintf(&s[0], n + 1, fmt, precision, value);
+    return emit(s.data(), n, first, last);
+  }
+
+  inline bool
+    is_digit( char c )
+  { return c >= '0' && c <= '9'; }
+
+  // Powers of ten that are exact in T, and mantissas that are: one
+  // multiplication or division of the two rounds correctly (Clinger's
+  // fast path).
+  template< class T >
+  struct exact
+  {
+    static int const digits    = std::numeric_limits<T>::digits;
+    static int const max_pow10 = digits >= 64 ? 27 : digits >= 53 ? 22 : 10;
+
+    static std::uint64_t
+      max_mantissa( )
+    { return digits >= 64 ? ~std::uint64_t(0) : std::uint64_t(1) << digits; }
+
+    static T
+      pow10( int i )
+    {
+      static long double const p[] = {
+        1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+        1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+        1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L };
+      return T(p[i]);
+    }
+
+    // m x 10^exp10, correctly rounded, if the fast path applies.
+    static bool
+      convert( std::uint64_t m, int exp10, T & result )
+    {
+      if( m > max_mantissa() || exp10 < -max_pow10 || exp10 > max_pow10 )
+        return false;
+      result = exp10 < 0 ? T(m) / pow10(-exp10) : T(m) * pow10(exp10);
+      return true;
+    }
+  };
+
+  // The type in which T's fast path may be extended.
+  template< class T > struct wider         { typedef T            type; };
+  template< >         struct wider<float>  { typedef double       type; };
+  template< >         struct wider<double> { typedef long double  type; };
+
+  // The value of the decimal number at first, if it converts exactly;
+  // otherwise false, and strto* has the last word.
+  template< class T >
+  bool
+    fast_parse( char const * first, char const * last
+              , T & value, char const * & end )
+  {
+    char const * p = first;
+    bool const negative = p != last && *p == '-';
+    if( p != last && (*p == '-' || *p == '+') )
+      ++p;
+
+    std::uint64_t m = 0u;
+    int ndig = 0, exp10 = 0;
+    bool any = false;
+    for( ; p != last && is_digit(*p); ++p ) {
+      any = true;
+      if( m == 0u && *p == '0' )
+        continue;
+      if( ++ndig > 19 )
+        return false;
+      m = 10u * m + unsigned(*p - '0');
+    }
+    if( p != last && *p == '.' ) {
+      for( ++p; p != last && is_digit(*p); ++p ) {
+        any = true;
+        --exp10;
+        if( m == 0u && *p == '0' )
+          continue;
+        if( ++ndig > 19 )
+          return false;
+        m = 10u * m + unsigned(*p - '0');
+      }
+    }
+    if( ! any || (p != last && (*p == 'x' || *p == 'X')) )
+      return false;
+    if( p != last && (*p == 'e' || *p == 'E') ) {
+      char const * q = p + 1;
+      bool const negexp = q != last && *q == '-';
+      if( q != last && (*q == '-' || *q == '+') )
+        ++q;
+      if( q == last || ! is_digit(*q) )
+        return false;
+      int e = 0;
+      for( ; q != last && is_digit(*q); ++q )
+        if( e < 100000 )
+          e = 10 * e + (*q - '0');
+      exp10 += negexp ? -e : e;
+      p = q;
+    }
+
+    T v = T(0);
+    if( m != 0u && ! exact<T>::convert(m, exp10, v) ) {
+      // In a wider type, and then rounded to T: the double rounding is
+      // only wrong if the first rounding lands on a midpoint of T.
+      typedef  typename wider<T>::type  W;
+      int const extra = exact<W>::digits - exact<T>::digits;
+      W w;
+      if( extra <= 0 || extra > 32 || exact<W>::digits > 64
+                     || ! exact<W>::convert(m, exp10, w) )
+        return false;
+      int k;
+      std::uint64_t const significand
+        = std::uint64_t(std::ldexp(std::frexp(w, &k), exact<W>::digits));
+      std::uint64_t const half = std::uint64_t(1) << ((extra - 1) & 31);
+      if( (significand & (2u * half - 1u)) == half )
+        return false;
+      v = T(w);
+    }
+    value = negative ? -v : v;
+    end = p;
+    return true;
+  }
+
+  // Conversion of a terminated string, fast or by strto* in the "C"
+  // locale.
+  template< class T >
+  T
+    read_back( char const * s, char const * e )
+  {
+    T v;
+    char const * end;
+    if( fast_parse(s, e, v, end) && end == e )
+      return v;
+    c_locale_scope c;
+    return strto(s, nullptr, (T *)nullptr);
+  }
+
+  // The significant digits of a %e conversion, and its exponent.
+  int
+    split_scientific( char const * s, char * digits, int & exp10 )
+  {
+    int n = 0;
+    for( ; *s != 'e'; ++s )
+      if( is_digit(*s) )
+        digits[n++] = *s;
+    exp10 = std::atoi(s + 1);
+    return n;
+  }
+
+  // Round the n digits to p; false if they end in a tie, which only the
+  // exact value can settle.
+  bool
+    round_digits( char const * digits, int n, int p
+                , char * out, int & exp10 )
+  {
+    std::memcpy(out, digits, p);
+    char const * const tail = digits + p;
+    bool up = tail[0] > '5';
+    if( tail[0] == '5' ) {
+      for( int i = 1; i != n - p && ! up; ++i )
+        up = tail[i] != '0';
+      if( ! up )
+        return false;
+    }
+    if( up ) {
+      int i = p - 1;
+      for( ; i >= 0 && out[i] == '9'; --i )
+        out[i] = '0';
+      if( i >= 0 )
+        ++out[i];
+      else {
+        out[0] = '1';
+        ++exp10;
+      }
+    }
+    return true;
+  }
+
+  // Write the p significant digits as printf's %.*g would; return the
+  // end of the text.
+  char *
+    write_general( bool negative, char const * digits, int p, int exp10
+                 , char * out )
+  {
+    int n = p;
+    while( n > 1 && digits[n - 1] == '0' )
+      --n;
+    if( negative )
+      *out++ = '-';
+
+    if( exp10 < -4 || exp10 >= p ) {
+      *out++ = digits[0];
+      if( n > 1 ) {
+        *out++ = '.';
+        out = std::copy(digits + 1, digits + n, out);
+      }
+      *out++ = 'e';
+      *out++ = exp10 < 0 ? '-' : '+';
+      unsigned e = exp10 < 0 ? -exp10 : exp10;
+      if( e < 10u )
+        *out++ = '0';
+      char buf[8];
+      char * q = buf + sizeof buf;
+      do {
+        *--q = char('0' + e % 10u);
+        e /= 10u;
+      } while( e != 0u );
+      return std::copy(q, buf + sizeof buf, out);
+    }
+
+    if( exp10 >= 0 ) {
+      int const whole = exp10 + 1;
+      for( int i = 0; i != whole; ++i )
+        *out++ = i < n ? digits[i] : '0';
+      if( n > whole ) {
+        *out++ = '.';
+        out = std::copy(digits + whole, digits + n, out);
+      }
+      return out;
+    }
+
+    *out++ = '0';
+    *out++ = '.';
+    out = std::fill_n(out, -exp10 - 1, '0');
+    return std::copy(digits, digits + n, out);
+  }
+
+  // The shortest %g form that reads back as value: every number has one
+  // of max_digits10 significant digits, and one of digits10 if it has
+  // one that short. The candidates are rounded from a single %e
+  // conversion.
+  template< class T >
+  to_chars_result
+    shortest( char * first, char * last, T value )
+  {
+    if( ! std::isfinite(value) )
+      return format(first, last, value, 'g', 0);
+
+    int const max = std::numeric_limits<T>::max_digits10;
+    char fmt[8];
+    make_format<T>(fmt, 'e');
+    char sci[64];
+    {
+      c_locale_scope c;
+      std::snprintf(sci, sizeof sci, fmt, max - 1, value);
+    }
+    bool const negative = sci[0] == '-';
+    char digits[40];
+    int exp10 = 0;
+    split_scientific(sci, digits, exp10);
+
+    char buf[64];
+    char * end = buf;
+    for( int p = std::numeric_limits<T>::digits10; p <= max; ++p ) {
+      char rounded[40];
+      int e = exp10;
+      if( p == max )
+        std::memcpy(rounded, digits, max);
+      else if( ! round_digits(digits, max, p, rounded, e) ) {
+        c_locale_scope c;
+        std::snprintf(sci, sizeof sci, fmt, p - 1, value);
+        split_scientific(sci, rounded, e);
+      }
+      end = write_general(negative, rounded, p, e, buf);
+      if( p == max )
+        break;
+      *end = '\0';
+      if( read_back<T>(buf, end) == value )
+        break;
+    }
+    return emit(buf, end - buf, first, last);
+  }
+
+  template< class T >
+  from_chars_result
+    parse( char const * first, char const * last, T & value )
+  {
+    if( first == last || std::isspace(static_cast<unsigned char>(*first)) )
+      return { first, std::errc::invalid_argument };
+    char const * fast_end;
+    if( fast_parse(first, last, value, fast_end) )
+      return { fast_end, std::errc() };
+
+    // strto* need a terminated string.
+    std::size_t const n = last - first;
+    char buf[64];
+    std::string long_input;
+    char const * s = buf;
+    if( n < sizeof buf ) {
+      std::memcpy(buf, first, n);
+      buf[n] = '\0';
+    }
+    else {
+      long_input.assign(first, last);
+      s = long_input.c_str();
+    }
+
+    int const saved_errno = errno;
+    errno = 0;
+    char * end = nullptr;
+    T result;
+    {
+      c_locale_scope c;
+      result = strto(s, &end, (T *)nullptr);
+    }
+    // Subnormal results are kept; only overflow and underflow to zero
+    // are out of range.
+    bool const out_of_range = errno == ERANGE
+                           && (std::isinf(result) || result == T(0));
+    errno = saved_errno;
+
+    if( end == s )
+      return { first, std::errc::invalid_argument };
+    char const * const ptr = first + (end - s);
+    if( out_of_range )
+      return { ptr, std::errc::result_out_of_range };
+    value = result;
+    return { ptr, std::errc() };
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+to_chars_result
+  cet::to_chars( char * first, char * last, float value )
+{ return shortest(first, last, value); }
+
+to_chars_result
+  cet::to_chars( char * first, char * last, double value )
+{ return shortest(first, last, value); }
+
+to_chars_result
+  cet::to_chars( char * first, char * last, long double value )
+{ return shortest(first, last, value); }
+
+to_chars_result
+  cet::to_chars( char * first, char * last, float value
+               , chars_format fmt, int precision )
+{ return format(first, last, double(value), conversion(fmt), precision); }
+
+to_chars_result
+  cet::to_chars( char * first, char * last, double value
+               , chars_format fmt, int precision )
+{ return format(first, last, value, conversion(fmt), precision); }
+
+to_chars_result
+  cet::to_chars( char * first, char * last, long double value
+               , chars_format fmt, int precision )
+{ return format(first, last, value, conversion(fmt), precision); }
+
+// ----------------------------------------------------------------------
+
+from_chars_result
+  cet::from_chars( char const * first, char const * last, float & value )
+{ return parse(first, last, value); }
+
+from_chars_result
+  cet::from_chars( char const * first, char const * last, double & value )
+{ return parse(first, last, value); }
+
+from_chars_result
+  cet::from_chars( char const * first, char const * last, long double & value )
+{ return parse(first, last, value); }
+
+// ======================================================================
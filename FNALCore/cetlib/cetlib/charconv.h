@@ -0,0 +1,163 @@
+#ifndef CETLIB_CHARCONV_H
+#define CETLIB_CHARCONV_H
+
+// ======================================================================
+//
+// charconv: locale-independent conversions between numbers and
+//           characters, into and out of caller-supplied buffers
+//
+// Modeled on C++17's <charconv>: nothing throws, nothing allocates
+// (short of floating-point text longer than a hundred characters), and
+// failure is reported through the std::errc of the result:
+//
+//   to_chars()    value_too_large    if [first, last) is too short
+//                                    (ptr == last, contents unspecified)
+//   from_chars()  invalid_argument   if no number starts at first
+//                                    (ptr == first)
+//                 result_out_of_range if the number doesn't fit T
+//                                    (ptr past the number)
+//
+// In both cases the value is left untouched. Integers are decimal, with
+// a leading '-' only for signed types; no leading whitespace or '+' is
+// accepted. Floating-point numbers are read as strtod() reads them in
+// the "C" locale (apart from leading whitespace), and by default are
+// written in the shortest %g form that reads back to the same value.
+//
+// ======================================================================
+
+#include "cpp0x/type_traits"
+#include <cstddef>
+#include <limits>
+#include <system_error>
+
+namespace cet {
+
+  template< class T >
+  struct is_integer
+    : std::integral_constant< bool
+                            ,    std::is_integral<T>::value
+                              && ! std::is_same<T, bool>::value
+                            >
+  { };
+
+  enum class chars_format { scientific = 1, fixed = 2, general = 3 };
+
+  struct to_chars_result
+  {
+    char *     ptr;
+    std::errc  ec;
+  };
+
+  struct from_chars_result
+  {
+    char const *  ptr;
+    std::errc     ec;
+  };
+
+  // integers (but not bool):
+  template< class T >
+  typename std::enable_if< is_integer<T>::value, to_chars_result >::type
+    to_chars( char * first, char * last, T value );
+
+  template< class T >
+  typename std::enable_if< is_integer<T>::value, from_chars_result >::type
+    from_chars( char const * first, char const * last, T & value );
+
+  // floating-point, shortest round trip:
+  to_chars_result  to_chars( char * first, char * last, float       value );
+  to_chars_result  to_chars( char * first, char * last, double      value );
+  to_chars_result  to_chars( char * first, char * last, long double value );
+
+  // floating-point, as printf's %e (scientific), %f (fixed) or %g:
+  to_chars_result  to_chars( char * first, char * last, float       value
+                           , chars_format fmt, int precision );
+  to_chars_result  to_chars( char * first, char * last, double      value
+                           , chars_format fmt, int precision );
+  to_chars_result  to_chars( char * first, char * last, long double value
+                           , chars_format fmt, int precision );
+
+  from_chars_result  from_chars( char const * first, char const * last, float       & value );
+  from_chars_result  from_chars( char const * first, char const * last, double      & value );
+  from_chars_result  from_chars( char const * first, char const * last, long double & value );
+
+  namespace detail {
+    extern char const digit_pairs[201];
+  }
+}
+
+// ======================================================================
+
+template< class T >
+typename std::enable_if< cet::is_integer<T>::value, cet::to_chars_result >::type
+  cet::to_chars( char * first, char * last, T value )
+{
+  typedef  typename std::make_unsigned<T>::type  U;
+  U u = static_cast<U>(value);
+  if( value < T() ) {
+    if( first == last )
+      return { last, std::errc::value_too_large };
+    *first++ = '-';
+    u = U(U(0) - u);
+  }
+
+  // Digits are produced in pairs, from the right, into a scratch buffer.
+  char buf[std::numeric_limits<U>::digits10 + 2];
+  char * p = buf + sizeof buf;
+  while( u >= 100u ) {
+    unsigned const i = unsigned(u % 100u) * 2u;
+    u = U(u / 100u);
+    *--p = detail::digit_pairs[i + 1];
+    *--p = detail::digit_pairs[i];
+  }
+  if( u >= 10u ) {
+    unsigned const i = unsigned(u) * 2u;
+    *--p = detail::digit_pairs[i + 1];
+    *--p = detail::digit_pairs[i];
+  }
+  else
+    *--p = char('0' + u);
+
+  std::size_t const n = buf + sizeof buf - p;
+  if( std::size_t(last - first) < n )
+    return { last, std::errc::value_too_large };
+  for( ; p != buf + sizeof buf; ++p )
+    *first++ = *p;
+  return { first, std::errc() };
+}
+
+template< class T >
+typename std::enable_if< cet::is_integer<T>::value, cet::from_chars_result >::type
+  cet::from_chars( char const * first, char const * last, T & value )
+{
+  typedef  typename std::make_unsigned<T>::type  U;
+  char const * p = first;
+  bool const negative = std::is_signed<T>::value && p != last && *p == '-';
+  if( negative )
+    ++p;
+  U const max = negative ? U(U(std::numeric_limits<T>::max()) + 1u)
+                         : U(std::numeric_limits<T>::max());
+
+  U const max_10  = U(max / 10u);
+  unsigned const max_d = unsigned(max % 10u);
+
+  char const * const digits = p;
+  U u = 0u;
+  bool overflow = false;
+  for( ; p != last && *p >= '0' && *p <= '9'; ++p ) {
+    unsigned const d = *p - '0';
+    if( u > max_10 || (u == max_10 && d > max_d) )
+      overflow = true;
+    else
+      u = U(10u * u + d);
+  }
+  if( p == digits )
+    return { first, std::errc::invalid_argument };
+  if( overflow )
+    return { p, std::errc::result_out_of_range };
+  value = negative ? T(U(0) - u) : T(u);
+  return { p, std::errc() };
+}
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef CETLIB_CONCURRENT_REGISTRY_H
+#define CETLIB_CONCURRENT_REGISTRY_H
+
+// ======================================================================
+//
+// concurrent_registry<K,V>: A singleton hash map from K to V, which may
+//                           be used by several threads at once
+//
+// Like registry<K,V>, except that the entries are unordered and are
+// visited with for_each() rather than iterators. K must be hashable by
+// Hash. The first value put for a key is kept, and references returned
+// by get() remain valid for the life of the program.
+//
+// ======================================================================
+
+#include "cetlib/detail/sharded_map.h"
+#include "cetlib/exception.h"
+#include <cstddef>
+#include <functional>
+
+namespace cet {
+  template< class K, class V, class Hash = std::hash<K> >
+    class concurrent_registry;
+}
+
+// ======================================================================
+
+template< class K, class V, class Hash >
+  class cet::concurrent_registry
+{
+  // non-instantiable (and non-copyable, just in case):
+  concurrent_registry( ) = delete;
+  concurrent_registry( concurrent_registry const & ) = delete;
+  void  operator = ( concurrent_registry const & ) = delete;
+
+  // shorthand:
+  typedef  detail::sharded_map<K, V, Hash>  reg_t;
+
+public:
+  typedef  std::size_t  size_type;
+
+  static  bool
+    empty( )  { return the_registry_().empty(); }
+  static  size_type
+    size( )  { return the_registry_().size(); }
+
+  static  void
+    put( K const & key, V const & value )
+  { the_registry_().insert(key, value); }
+
+  static  V const &
+    get( K const & key );
+  static  bool
+    get( K const & key, V & value ) noexcept;
+
+  // Call f(key, value) for each entry; entries put meanwhile may or may
+  // not be visited.
+  template< class F >
+    static  void
+    for_each( F f )  { the_registry_().for_each(f); }
+
+private:
+  // encapsulated singleton:
+  static  reg_t &
+    the_registry_( )
+  {
+    static  reg_t  the_registry;
+    return the_registry;
+  }
+
+};  // concurrent_registry<>
+
+// ----------------------------------------------------------------------
+
+template< class K, class V, class Hash >
+V const &
+  cet::concurrent_registry<K,V,Hash>::get( K const & key )
+{
+  V const *  p = the_registry_().find(key);
+  if( p == nullptr )
+    throw cet::exception("cet::concurrent_registry")
+      << "Key \"" << key << "\" not found in registry";
+  return *p;
+}
+
+template< class K, class V, class Hash >
+bool
+  cet::concurrent_registry<K,V,Hash>::get( K const & key, V & value ) noexcept
+{
+  V const *  p = the_registry_().find(key);
+  if( p == nullptr )
+    return false;
+  value = *p;
+  return true;
+}
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef CETLIB_CONCURRENT_REGISTRY_VIA_ID_H
+#define CETLIB_CONCURRENT_REGISTRY_VIA_ID_H
+
+// ======================================================================
+//
+// concurrent_registry_via_id<K,V>: A singleton hash map from K to V,
+//                                  requiring that V::id() exists and
+//                                  yields values of type K, which may
+//                                  be used by several threads at once
+//
+// Like registry_via_id<K,V>, except that the entries are unordered:
+// they are visited with for_each(), or copied by snapshot(), rather
+// than iterated over. K must be hashable by Hash. The first value put
+// for a key is kept, and references returned by get() remain valid for
+// the life of the program.
+//
+// ======================================================================
+
+#include "cetlib/detail/sharded_map.h"
+#include "cetlib/exception.h"
+#include "cetlib/registry_via_id.h"
+#include "cpp0x/type_traits"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <utility>
+
+namespace cet {
+  template< class K, class V, class Hash = std::hash<K> >
+    class concurrent_registry_via_id;
+}
+
+// ======================================================================
+
+template< class K, class V, class Hash >
+  class cet::concurrent_registry_via_id
+{
+  // non-instantiable (and non-copyable, just in case):
+  concurrent_registry_via_id( ) = delete;
+  concurrent_registry_via_id( concurrent_registry_via_id const & ) = delete;
+  void  operator = ( concurrent_registry_via_id const & ) = delete;
+
+  // shorthand:
+  typedef  detail::sharded_map<K, V, Hash>  reg_t;
+
+public:
+  // As for registry_via_id; collection_type is that of snapshot().
+  typedef  std::map<K const, V>                      collection_type;
+  typedef  typename collection_type::key_type        key_type;
+  typedef  typename collection_type::mapped_type     mapped_type;
+  typedef  typename collection_type::value_type      value_type;
+  typedef  std::size_t                               size_type;
+
+  // observers:
+  static  bool
+    empty( )  { return the_registry_().empty(); }
+  static  size_type
+    size( )  { return the_registry_().size(); }
+
+  // mutators:
+  // A single V;
+  static  typename detail::must_have_id<K,V>::type
+    put( V const & value );
+  // A range of iterator to V.
+  template< class FwdIt >
+    static
+    typename std::enable_if<std::is_same<typename std::iterator_traits<FwdIt>::value_type,
+                                         mapped_type>::value, void>::type
+    put( FwdIt begin, FwdIt end );
+  // A range of iterator to std::pair<K, V>. For each pair, first ==
+  // second.id() is a prerequisite.
+  template< class FwdIt >
+    static
+    typename std::enable_if<std::is_same<typename std::iterator_traits<FwdIt>::value_type,
+                                         value_type>::value, void>::type
+    put( FwdIt begin, FwdIt end );
+  // A collection_type. For each value_type, first == second.id() is a
+  // prerequisite.
+  static  void
+    put( collection_type const & c )  { put(c.cbegin(), c.cend()); }
+
+  // accessors:
+  static  V const &
+    get( K const & key );
+  static  bool
+    get( K const & key, V & value ) noexcept;
+
+  // Call f(key, value) for each entry; entries put meanwhile may or may
+  // not be visited.
+  template< class F >
+    static  void
+    for_each( F f )  { the_registry_().for_each(f); }
+
+  // A copy of the entries, ordered by key (which requires K < K).
+  static  collection_type
+    snapshot( );
+
+private:
+  // encapsulated singleton:
+  static  reg_t &
+    the_registry_( )
+  {
+    static  reg_t  the_registry;
+    return the_registry;
+  }
+
+};  // concurrent_registry_via_id<>
+
+#ifndef __GCCXML__
+// ----------------------------------------------------------------------
+// put() overloads:
+
+template< class K, class V, class Hash >
+typename cet::detail::must_have_id<K,V>::type
+  cet::concurrent_registry_via_id<K,V,Hash>::put( V const & value )
+{
+  K id = value.id();
+  the_registry_().insert(id, value);
+  return id;
+}
+
+template< class K, class V, class Hash >
+template< class FwdIt >
+inline
+auto
+  cet::concurrent_registry_via_id<K,V,Hash>::put( FwdIt b, FwdIt e )
+-> typename std::enable_if<std::is_same<typename std::iterator_traits<FwdIt>::value_type,
+                                        mapped_type>::value, void>::type
+{
+  for( ; b != e; ++b )
+    (void)put(*b);
+}
+
+template< class K, class V, class Hash >
+template< class FwdIt >
+inline
+auto
+  cet::concurrent_registry_via_id<K,V,Hash>::put( FwdIt b, FwdIt e )
+-> typename std::enable_if<std::is_same<typename std::iterator_traits<FwdIt>::value_type,
+                                        value_type>::value, void>::type
+{
+  for( ; b != e; ++b )
+    the_registry_().insert(b->first, b->second);
+}
+
+// ----------------------------------------------------------------------
+// get() overloads:
+
+template< class K, class V, class Hash >
+V const &
+  cet::concurrent_registry_via_id<K,V,Hash>::get( K const & key )
+{
+  V const *  p = the_registry_().find(key);
+  if( p == nullptr )
+    throw cet::exception("cet::concurrent_registry_via_id")
+      << "Key \"" << key << "\" not found in registry";
+  return *p;
+}
+
+template< class K, class V, class Hash >
+bool
+  cet::concurrent_registry_via_id<K,V,Hash>::get( K const & key, V & value ) noexcept
+{
+  V const *  p = the_registry_().find(key);
+  if( p == nullptr )
+    return false;
+  value = *p;
+  return true;
+}
+
+template< class K, class V, class Hash >
+auto
+  cet::concurrent_registry_via_id<K,V,Hash>::snapshot( )
+-> collection_type
+{
+  collection_type  result;
+  the_registry_().for_each([&result]( K const & key, V const & value )
+                           { result.emplace(key, value); });
+  return result;
+}
+#endif /* __GCCXML__ */
+
+#endif
+
+// Local Variables:
+// mode: c++
+// End:
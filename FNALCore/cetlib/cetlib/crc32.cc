@@ -34,10 +34,32 @@
 // by Ross Williams (ross@guest.adelaide.edu.au.). This document is
 // likely to be in the FTP archive "ftp.adelaide.edu.au/pub/rocksoft".
 //
+// ----------------------------------------------------------------------
+//
+// Implementations, all advancing the same running CRC:
+//
+// - bytewise: the table above, one byte per lookup.
+// - slicing8, slicing16: 8 or 16 bytes per step through tables derived
+//   from it; see detail/crc32_kernels.h.
+// - pclmul: 64 bytes per step folded into four 128-bit accumulators by
+//   carry-less multiplication, then reduced to 32 bits by Barrett
+//   reduction, after "Fast CRC Computation for Generic Polynomials
+//   Using PCLMULQDQ Instruction", Intel, 2009. The folding constants
+//   are those of the Linux kernel's crc32-pclmul.
+//
 // ======================================================================
 
 #include "cetlib/crc32.h"
 
+#include "cetlib/detail/crc32_kernels.h"
+#include "cetlib/detail/implementation_choice.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CET_CRC32_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 using cet::crc32;
 
 // ----------------------------------------------------------------------
@@ -46,8 +68,9 @@ namespace {
 
   std::uint32_t const  CRC32_XINIT = 0xFFFFFFFFL;
   std::uint32_t const  CRC32_XOROT = 0xFFFFFFFFL;
+  std::uint32_t const  CRC32_POLY  = 0xEDB88320L;
 
-  std::uint32_t crctable[256] =
+  std::uint32_t const crctable[256] =
   {
     0x00000000L, 0x77073096L, 0xEE0E612CL, 0x990951BAL,
     0x076DC419L, 0x706AF48FL, 0xE963A535L, 0x9E6495A3L,
@@ -114,6 +137,122 @@ namespace {
     0xB3667A2EL, 0xC4614AB8L, 0x5D681B02L, 0x2A6F2B94L,
     0xB40BBE37L, 0xC30C8EA1L, 0x5A05DF1BL, 0x2D02EF8DL
   };  // crctable
+
+  typedef  std::uint32_t  kernel_t( std::uint32_t crc
+                                  , unsigned char const * data
+                                  , std::size_t n );
+
+  cet::detail::crc32_tables const &
+    tables( )
+  {
+    static cet::detail::crc32_tables const t(CRC32_POLY);
+    return t;
+  }
+
+  std::uint32_t
+    bytewise( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  { return cet::detail::crc32_bytewise(crctable, crc, p, n); }
+
+  std::uint32_t
+    slicing8( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  { return cet::detail::crc32_slicing8(tables(), crc, p, n); }
+
+  std::uint32_t
+    slicing16( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  { return cet::detail::crc32_slicing16(tables(), crc, p, n); }
+
+#ifdef CET_CRC32_X86
+
+  __attribute__((target("pclmul,sse4.1")))
+  inline __m128i
+    fold( __m128i x, __m128i k, __m128i next )
+  {
+    return _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128(x, k, 0x00)
+                                       , _mm_clmulepi64_si128(x, k, 0x11) )
+                        , next );
+  }
+
+  __attribute__((target("pclmul,sse4.1")))
+  std::uint32_t
+    pclmul( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  {
+    if( n < 64u )
+      return slicing16(crc, p, n);
+
+    __m128i const k1k2  = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    __m128i const k3k4  = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    __m128i const k5    = _mm_set_epi64x(0, 0x0163cd6124LL);
+    __m128i const poly  = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    __m128i const mask32 = _mm_set_epi32(0, 0, 0, -1);
+
+    __m128i const * q = reinterpret_cast<__m128i const *>(p);
+    __m128i x1 = _mm_xor_si128(_mm_loadu_si128(q), _mm_cvtsi32_si128(int(crc)));
+    __m128i x2 = _mm_loadu_si128(q + 1);
+    __m128i x3 = _mm_loadu_si128(q + 2);
+    __m128i x4 = _mm_loadu_si128(q + 3);
+    q += 4;
+    n -= 64u;
+
+    for( ; n >= 64u; n -= 64u, q += 4 ) {
+      x1 = fold(x1, k1k2, _mm_loadu_si128(q));
+      x2 = fold(x2, k1k2, _mm_loadu_si128(q + 1));
+      x3 = fold(x3, k1k2, _mm_loadu_si128(q + 2));
+      x4 = fold(x4, k1k2, _mm_loadu_si128(q + 3));
+    }
+
+    x1 = fold(x1, k3k4, x2);
+    x1 = fold(x1, k3k4, x3);
+    x1 = fold(x1, k3k4, x4);
+    for( ; n >= 16u; n -= 16u, ++q )
+      x1 = fold(x1, k3k4, _mm_loadu_si128(q));
+
+    // 128 bits to 64, then to 32 appended zero bits...
+    x1 = _mm_xor_si128( _mm_clmulepi64_si128(k3k4, x1, 0x01)
+                      , _mm_srli_si128(x1, 8) );
+    x1 = _mm_xor_si128( _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5, 0x00)
+                      , _mm_srli_si128(x1, 4) );
+    // ... and Barrett reduction to the CRC.
+    __m128i t = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x10);
+    t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), poly, 0x00);
+    crc = std::uint32_t(_mm_extract_epi32(_mm_xor_si128(x1, t), 1));
+
+    return slicing16(crc, reinterpret_cast<unsigned char const *>(q), n);
+  }
+
+  bool
+    cpu_has_pclmul( )
+  {
+    unsigned a, b, c, d;
+    return __get_cpuid(1, &a, &b, &c, &d)
+        && (c & bit_PCLMUL) && (c & bit_SSE4_1);
+  }
+
+#endif  // CET_CRC32_X86
+
+  typedef  cet::detail::implementation_choice<kernel_t>  choice_t;
+
+  // Supported by this CPU, best first.
+  std::vector<choice_t::entry>
+    supported( )
+  {
+    std::vector<choice_t::entry> result;
+#ifdef CET_CRC32_X86
+    static bool const has_pclmul = cpu_has_pclmul();
+    if( has_pclmul ) result.push_back(choice_t::entry{"pclmul", pclmul});
+#endif
+    result.push_back(choice_t::entry{"slicing16", slicing16});
+    result.push_back(choice_t::entry{"slicing8",  slicing8});
+    result.push_back(choice_t::entry{"bytewise",  bytewise});
+    return result;
+  }
+
+  choice_t &
+    choice( )
+  {
+    static choice_t c(supported(), "CET_CRC32_IMPLEMENTATION");
+    return c;
+  }
+
 }
 
 // ----------------------------------------------------------------------
@@ -125,30 +264,42 @@ void
 }
 
 crc32 &
-  crc32::operator << ( std::string const & mesg )
+  crc32::update( void const * mesg, std::size_t size )
 {
-  for( std::string::const_iterator b = mesg.begin()
-                                 , e = mesg.end();  b != e;  ++b ) {
-    uchar ch = *b;
-    context = crctable[(context ^ ch) & 0xFFL]
-            ^ (context >> 8);
-  }
+  context = choice().get()(context, static_cast<uchar const *>(mesg), size);
   return *this;
 }
 
-crc32 &
-  crc32::operator << ( char const mesg )
+crc32::digest_t
+  crc32::digest( )
 {
-  uchar ch = mesg;
-  context = crctable[(context ^ ch) & 0xFFL]
-          ^ (context >> 8);
-  return *this;
+  return context ^ CRC32_XOROT;
 }
 
 crc32::digest_t
-  crc32::digest( )
+  crc32::combine( digest_t crc_a, digest_t crc_b, std::uint64_t len_b )
 {
-  return context ^ CRC32_XOROT;
+  return detail::crc32_combine(crc_a, crc_b, len_b, CRC32_POLY);
+}
+
+// ----------------------------------------------------------------------
+
+std::vector<std::string>
+  crc32::implementations( )
+{
+  return choice().names();
+}
+
+std::string
+  crc32::implementation( )
+{
+  return choice().name();
+}
+
+bool
+  crc32::use_implementation( std::string const & name )
+{
+  return choice().use(name);
 }
 
 // ======================================================================
@@ -5,10 +5,17 @@
 //
 // crc32: Calculate a CRC32 checksum
 //
+// The kernel is chosen at run time: carry-less multiplication
+// (PCLMULQDQ) if the CPU has it, else slicing-by-16. All give the same
+// checksums. CET_CRC32_IMPLEMENTATION, if set in the environment, names
+// the one to use instead.
+//
 // ======================================================================
 
+#include "cetlib/detail/update_range.h"
 #include "cpp0x/cstdint"
 #include <string>
+#include <vector>
 
 namespace cet {
   class crc32;
@@ -31,13 +38,36 @@ public:
   void  reset( );
 
   crc32 &
-    operator << ( std::string const & mesg );
+    update( void const * mesg, std::size_t size );
+  template< class InputIt >
+  crc32 &
+    update( InputIt first, InputIt last )
+  {
+    detail::update_range(*this, first, last);
+    return *this;
+  }
+
+  crc32 &
+    operator << ( std::string const & mesg )
+  { return update( mesg.data(), mesg.size() ); }
   crc32 &
-    operator << ( char const mesg );
+    operator << ( char const mesg )
+  { return update( & mesg, 1u ); }
 
   digest_t
     digest( );
 
+  // The checksum of A followed by B, given those of A and of B and the
+  // length of B; e.g., to merge checksums of chunks made in parallel.
+  static  digest_t  combine( digest_t crc_a, digest_t crc_b, std::uint64_t len_b );
+
+  // Names of the implementations this CPU supports, best first, and of
+  // the one in use. use_implementation() switches the whole process to
+  // another; it fails if the CPU doesn't support it.
+  static  std::vector<std::string>  implementations( );
+  static  std::string               implementation( );
+  static  bool                      use_implementation( std::string const & name );
+
 private:
   digest_t  context;
 
@@ -0,0 +1,163 @@
+// ======================================================================
+//
+// crc32c: Calculate a CRC32C (Castagnoli) checksum
+//
+// Implementations, all advancing the same running CRC:
+//
+// - bytewise, slicing8, slicing16: see detail/crc32_kernels.h.
+// - sse42: the SSE4.2 crc32 instruction, 8 bytes at a time.
+//
+// ======================================================================
+
+#include "cetlib/crc32c.h"
+
+#include "cetlib/detail/crc32_kernels.h"
+#include "cetlib/detail/implementation_choice.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CET_CRC32C_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using cet::crc32c;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  std::uint32_t const  CRC32C_XINIT = 0xFFFFFFFFL;
+  std::uint32_t const  CRC32C_XOROT = 0xFFFFFFFFL;
+  std::uint32_t const  CRC32C_POLY  = 0x82F63B78L;
+
+  typedef  std::uint32_t  kernel_t( std::uint32_t crc
+                                  , unsigned char const * data
+                                  , std::size_t n );
+
+  cet::detail::crc32_tables const &
+    tables( )
+  {
+    static cet::detail::crc32_tables const t(CRC32C_POLY);
+    return t;
+  }
+
+  std::uint32_t
+    bytewise( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  { return cet::detail::crc32_bytewise(tables().t[0], crc, p, n); }
+
+  std::uint32_t
+    slicing8( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  { return cet::detail::crc32_slicing8(tables(), crc, p, n); }
+
+  std::uint32_t
+    slicing16( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  { return cet::detail::crc32_slicing16(tables(), crc, p, n); }
+
+#ifdef CET_CRC32C_X86
+
+  __attribute__((target("sse4.2")))
+  std::uint32_t
+    sse42( std::uint32_t crc, unsigned char const * p, std::size_t n )
+  {
+#ifdef __x86_64__
+    std::uint64_t c = crc;
+    for( ; n >= 8u; n -= 8u, p += 8 ) {
+      std::uint64_t w;
+      std::memcpy(&w, p, sizeof w);
+      c = _mm_crc32_u64(c, w);
+    }
+    crc = std::uint32_t(c);
+#endif
+    for( ; n >= 4u; n -= 4u, p += 4 ) {
+      std::uint32_t w;
+      std::memcpy(&w, p, sizeof w);
+      crc = _mm_crc32_u32(crc, w);
+    }
+    for( ; n != 0u; --n, ++p )
+      crc = _mm_crc32_u8(crc, *p);
+    return crc;
+  }
+
+  bool
+    cpu_has_sse42( )
+  {
+    unsigned a, b, c, d;
+    return __get_cpuid(1, &a, &b, &c, &d) && (c & bit_SSE4_2);
+  }
+
+#endif  // CET_CRC32C_X86
+
+  typedef  cet::detail::implementation_choice<kernel_t>  choice_t;
+
+  // Supported by this CPU, best first.
+  std::vector<choice_t::entry>
+    supported( )
+  {
+    std::vector<choice_t::entry> result;
+#ifdef CET_CRC32C_X86
+    static bool const has_sse42 = cpu_has_sse42();
+    if( has_sse42 ) result.push_back(choice_t::entry{"sse42", sse42});
+#endif
+    result.push_back(choice_t::entry{"slicing16", slicing16});
+    result.push_back(choice_t::entry{"slicing8",  slicing8});
+    result.push_back(choice_t::entry{"bytewise",  bytewise});
+    return result;
+  }
+
+  choice_t &
+    choice( )
+  {
+    static choice_t c(supported(), "CET_CRC32C_IMPLEMENTATION");
+    return c;
+  }
+
+}
+
+// ----------------------------------------------------------------------
+
+void
+  crc32c::reset( )
+{
+  context = CRC32C_XINIT;
+}
+
+crc32c &
+  crc32c::update( void const * mesg, std::size_t size )
+{
+  context = choice().get()(context, static_cast<uchar const *>(mesg), size);
+  return *this;
+}
+
+crc32c::digest_t
+  crc32c::digest( )
+{
+  return context ^ CRC32C_XOROT;
+}
+
+crc32c::digest_t
+  crc32c::combine( digest_t crc_a, digest_t crc_b, std::uint64_t len_b )
+{
+  return detail::crc32_combine(crc_a, crc_b, len_b, CRC32C_POLY);
+}
+
+// ----------------------------------------------------------------------
+
+std::vector<std::string>
+  crc32c::implementations( )
+{
+  return choice().names();
+}
+
+std::string
+  crc32c::implementation( )
+{
+  return choice().name();
+}
+
+bool
+  crc32c::use_implementation( std::string const & name )
+{
+  return choice().use(name);
+}
+
+// ======================================================================
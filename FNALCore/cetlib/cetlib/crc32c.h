@@ -0,0 +1,74 @@
+#ifndef CETLIB_CRC32C_H
+#define CETLIB_CRC32C_H
+
+// ======================================================================
+//
+// crc32c: Calculate a CRC32C (Castagnoli) checksum, as used by iSCSI
+//         (RFC 3720) and ext4
+//
+// The interface is that of crc32. The kernel is chosen at run time: the
+// SSE4.2 crc32 instruction if the CPU has it, else slicing-by-16.
+// CET_CRC32C_IMPLEMENTATION, if set in the environment, names the one
+// to use instead.
+//
+// ======================================================================
+
+#include "cetlib/detail/update_range.h"
+#include "cpp0x/cstdint"
+#include <string>
+#include <vector>
+
+namespace cet {
+  class crc32c;
+}
+
+// ======================================================================
+
+class cet::crc32c
+{
+public:
+  typedef  unsigned char  uchar;
+  typedef  std::uint32_t  digest_t;
+
+  crc32c( ) { reset(); }
+  explicit
+    crc32c( std::string const & mesg ) { reset(); operator<<(mesg); }
+  explicit
+    crc32c( char const mesg ) { reset(); operator<<(mesg); }
+
+  void  reset( );
+
+  crc32c &
+    update( void const * mesg, std::size_t size );
+  template< class InputIt >
+  crc32c &
+    update( InputIt first, InputIt last )
+  {
+    detail::update_range(*this, first, last);
+    return *this;
+  }
+
+  crc32c &
+    operator << ( std::string const & mesg )
+  { return update( mesg.data(), mesg.size() ); }
+  crc32c &
+    operator << ( char const mesg )
+  { return update( & mesg, 1u ); }
+
+  digest_t
+    digest( );
+
+  static  digest_t  combine( digest_t crc_a, digest_t crc_b, std::uint64_t len_b );
+
+  static  std::vector<std::string>  implementations( );
+  static  std::string               implementation( );
+  static  bool                      use_implementation( std::string const & name );
+
+private:
+  digest_t  context;
+
+};  // crc32c
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef cetlib_detail_crc32_kernels_h
+#define cetlib_detail_crc32_kernels_h
+
+// ======================================================================
+//
+// crc32_kernels: the portable table-driven kernels and the combine
+//                operation shared by the reflected 32-bit CRCs, crc32
+//                and crc32c
+//
+// Each kernel advances a running CRC register (before the final xor)
+// over n bytes. Slicing-by-N looks up N bytes at once in N tables,
+// table k giving the effect of a byte followed by k zero bytes.
+//
+// ======================================================================
+
+#include "cpp0x/cstdint"
+#include <cstddef>
+#include <cstring>
+
+namespace cet {
+  namespace detail {
+
+    struct crc32_tables
+    {
+      std::uint32_t  t[16][256];
+
+      // Reflected polynomial, e.g. 0xEDB88320 for crc32.
+      explicit
+        crc32_tables( std::uint32_t poly )
+      {
+        for( unsigned i = 0; i != 256u; ++i ) {
+          std::uint32_t c = i;
+          for( int k = 0; k != 8; ++k )
+            c = c & 1u ? (c >> 1) ^ poly : c >> 1;
+          t[0][i] = c;
+        }
+        for( unsigned i = 0; i != 256u; ++i )
+          for( int k = 1; k != 16; ++k )
+            t[k][i] = (t[k-1][i] >> 8) ^ t[0][t[k-1][i] & 0xFFu];
+      }
+    };
+
+    inline std::uint32_t
+      crc32_bytewise( std::uint32_t const t[256]
+                    , std::uint32_t crc, unsigned char const * p, std::size_t n )
+    {
+      for( ; n != 0u; --n, ++p )
+        crc = t[(crc ^ *p) & 0xFFu] ^ (crc >> 8);
+      return crc;
+    }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+
+    inline std::uint32_t
+      crc32_load( unsigned char const * p )
+    {
+      std::uint32_t w;
+      std::memcpy(&w, p, sizeof w);
+      return w;
+    }
+
+    inline std::uint32_t
+      crc32_slice4( crc32_tables const & T, int k, std::uint32_t w )
+    {
+      return T.t[k+3][w & 0xFFu]         ^ T.t[k+2][(w >> 8) & 0xFFu]
+           ^ T.t[k+1][(w >> 16) & 0xFFu] ^ T.t[k][w >> 24];
+    }
+
+    inline std::uint32_t
+      crc32_slicing8( crc32_tables const & T
+                    , std::uint32_t crc, unsigned char const * p, std::size_t n )
+    {
+      for( ; n >= 8u; n -= 8u, p += 8 )
+        crc = crc32_slice4(T, 4, crc32_load(p) ^ crc)
+            ^ crc32_slice4(T, 0, crc32_load(p + 4));
+      return crc32_bytewise(T.t[0], crc, p, n);
+    }
+
+    inline std::uint32_t
+      crc32_slicing16( crc32_tables const & T
+                     , std::uint32_t crc, unsigned char const * p, std::size_t n )
+    {
+      for( ; n >= 16u; n -= 16u, p += 16 )
+        crc = crc32_slice4(T, 12, crc32_load(p) ^ crc)
+            ^ crc32_slice4(T,  8, crc32_load(p + 4))
+            ^ crc32_slice4(T,  4, crc32_load(p + 8))
+            ^ crc32_slice4(T,  0, crc32_load(p + 12));
+      return crc32_bytewise(T.t[0], crc, p, n);
+    }
+
+#else
+
+    // The slicing kernels assume little-endian words.
+    inline std::uint32_t
+      crc32_slicing8( crc32_tables const & T
+                    , std::uint32_t crc, unsigned char const * p, std::size_t n )
+    { return crc32_bytewise(T.t[0], crc, p, n); }
+
+    inline std::uint32_t
+      crc32_slicing16( crc32_tables const & T
+                     , std::uint32_t crc, unsigned char const * p, std::size_t n )
+    { return crc32_bytewise(T.t[0], crc, p, n); }
+
+#endif
+
+    // a(x) * b(x) modulo the polynomial, all reflected.
+    inline std::uint32_t
+      crc32_multmod( std::uint32_t a, std::uint32_t b, std::uint32_t poly )
+    {
+      std::uint32_t p = 0u;
+      for( std::uint32_t m = 0x80000000u; m != 0u; m >>= 1 ) {
+        if( a & m )
+          p ^= b;
+        b = b & 1u ? (b >> 1) ^ poly : b >> 1;
+      }
+      return p;
+    }
+
+    // The CRC of A followed by B, from the (final) CRCs of each and the
+    // length of B, in O(log len_b): crc_a is advanced over len_b zero
+    // bytes by multiplying it by x^(8 len_b), built up from the squares
+    // x^(2^k).
+    inline std::uint32_t
+      crc32_combine( std::uint32_t crc_a, std::uint32_t crc_b
+                   , std::uint64_t len_b, std::uint32_t poly )
+    {
+      std::uint32_t x2k = 0x00800000u;  // x^8
+      std::uint32_t shift = 0x80000000u;  // x^0
+      for( ; len_b != 0u; len_b >>= 1 ) {
+        if( len_b & 1u )
+          shift = crc32_multmod(x2k, shift, poly);
+        x2k = crc32_multmod(x2k, x2k, poly);
+      }
+      return crc32_multmod(shift, crc_a, poly) ^ crc_b;
+    }
+
+  }
+}
+
+// ======================================================================
+
+#endif /* cetlib_detail_crc32_kernels_h */
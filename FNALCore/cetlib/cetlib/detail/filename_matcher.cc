@@ -0,0 +1,168 @@
+// ======================================================================
+//
+// filename_matcher: a compiled ECMAScript regex for whole filenames,
+//                   with the literal prefix and suffix every match must
+//                   have checked before the regex is run
+//
+// The pattern is split into atoms: literal characters (including
+// identity escapes such as "\."), and everything else. The prefix is
+// the run of literal atoms at the start, the suffix that at the end.
+// An atom quantified by "*", "?" or "{...}" is not literal; one
+// quantified by "+" ends the run but is counted once. A pattern with
+// an alternation anywhere gets neither.
+//
+// ======================================================================
+
+#include "cetlib/detail/filename_matcher.h"
+
+#include <cctype>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using cet::detail::filename_matcher;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  struct atom
+  {
+    enum kind_t { literal, literal_once, anchor, other }  kind;
+    char  c;
+  };
+
+  bool
+    is_quantifier( char c )
+  { return c == '*' || c == '?' || c == '+' || c == '{'; }
+
+  // The atoms of pattern; false if it has an alternation.
+  bool
+    atomize( std::string const & p, std::vector<atom> & atoms )
+  {
+    std::size_t const n = p.size();
+    for( std::size_t i = 0; i != n; ) {
+      char const c = p[i];
+      if( c == '|' )
+        return false;
+      if( is_quantifier(c) ) {
+        // Applies to the previous atom; a further "?" makes it lazy.
+        if( ! atoms.empty() && atoms.back().kind == atom::literal )
+          atoms.back().kind = c == '+' ? atom::literal_once : atom::other;
+        else if( ! atoms.empty() && atoms.back().kind == atom::literal_once )
+          atoms.back().kind = atom::other;
+        if( c == '{' ) {
+          std::size_t const close = p.find('}', i);
+          i = close == std::string::npos ? n : close + 1u;
+        }
+        else
+          ++i;
+        continue;
+      }
+      if( c == '\\' ) {
+        char const e = i + 1u < n ? p[i + 1u] : '\0';
+        if( e != '\0' && std::ispunct((unsigned char)e) ) {
+          atoms.push_back(atom{ atom::literal, e });
+          i += 2u;
+        }
+        else {
+          // \d, \x41, \cJ, \1, ...: skip the letter, and for the
+          // numeric and control escapes the alphanumerics after it.
+          atoms.push_back(atom{ atom::other, e });
+          i += 2u;
+          while( i != n && std::isalnum((unsigned char)p[i]) && (e == 'x' || e == 'u' || e == 'c' || std::isdigit((unsigned char)e)) )
+            ++i;
+        }
+        continue;
+      }
+      if( c == '[' ) {
+        // A class; "]" first, or after "^", is a member.
+        std::size_t j = i + 1u;
+        if( j != n && p[j] == '^' ) ++j;
+        if( j != n && p[j] == ']' ) ++j;
+        for( ; j != n && p[j] != ']'; ++j )
+          if( p[j] == '\\' ) ++j;
+        atoms.push_back(atom{ atom::other, c });
+        i = j == n ? n : j + 1u;
+        continue;
+      }
+      if( c == '^' || c == '$' )
+        atoms.push_back(atom{ atom::anchor, c });
+      else if( std::strchr(".()", c) != nullptr )
+        atoms.push_back(atom{ atom::other, c });
+      else
+        atoms.push_back(atom{ atom::literal, c });
+      ++i;
+    }
+    return true;
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+filename_matcher::filename_matcher( std::string const & pattern )
+: prefix_ ( )
+, suffix_ ( )
+, literal_( false )
+, re_     ( pattern )
+{
+  std::vector<atom> atoms;
+  if( ! atomize(pattern, atoms) )
+    return;
+
+  std::size_t first = 0u, last = atoms.size();
+  if( first != last && atoms[first].kind == atom::anchor && atoms[first].c == '^' )
+    ++first;
+  if( first != last && atoms[last-1].kind == atom::anchor && atoms[last-1].c == '$' )
+    --last;
+
+  std::size_t i = first;
+  for( ; i != last && atoms[i].kind == atom::literal; ++i )
+    prefix_ += atoms[i].c;
+  if( i == last ) {
+    literal_ = true;
+    return;
+  }
+  if( atoms[i].kind == atom::literal_once )
+    prefix_ += atoms[i++].c;
+
+  std::size_t j = last;
+  for( ; j != i && atoms[j-1].kind == atom::literal; --j )
+    suffix_.insert(suffix_.begin(), atoms[j-1].c);
+  if( j != i && atoms[j-1].kind == atom::literal_once )
+    suffix_.insert(suffix_.begin(), atoms[j-1].c);
+}
+
+bool
+  filename_matcher::operator () ( char const * name, std::size_t size ) const
+{
+  if( literal_ )
+    return size == prefix_.size()
+        && std::memcmp(name, prefix_.data(), size) == 0;
+  return size >= prefix_.size() + suffix_.size()
+      && std::memcmp(name, prefix_.data(), prefix_.size()) == 0
+      && std::memcmp(name + size - suffix_.size(), suffix_.data(), suffix_.size()) == 0
+      && std::regex_match(name, name + size, re_);
+}
+
+// ----------------------------------------------------------------------
+
+std::shared_ptr<filename_matcher const>
+  filename_matcher::get( std::string const & pattern )
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<filename_matcher const> > compiled;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = compiled.find(pattern);
+    if( it != compiled.end() )
+      return it->second;
+  }
+  auto const m = std::make_shared<filename_matcher const>(pattern);
+  std::lock_guard<std::mutex> lock(mutex);
+  return compiled.emplace(pattern, m).first->second;
+}
+
+// ======================================================================
@@ -0,0 +1,60 @@
+#ifndef cetlib_detail_filename_matcher_h
+#define cetlib_detail_filename_matcher_h
+
+// ======================================================================
+//
+// filename_matcher: a compiled ECMAScript regex for whole filenames,
+//                   with the literal prefix and suffix every match must
+//                   have checked before the regex is run
+//
+// E.g., "lib([-A-Za-z0-9]*_)*[A-Za-z0-9]+_plugin\.so" must start with
+// "lib" and end with "_plugin.so"; most other names are rejected by two
+// string comparisons. A pattern with no metacharacters is matched by
+// comparison alone.
+//
+// ======================================================================
+
+#include "cpp0x/regex"
+#include <memory>
+#include <string>
+
+namespace cet {
+  namespace detail {
+    class filename_matcher;
+  }
+}
+
+// ----------------------------------------------------------------------
+
+class cet::detail::filename_matcher
+{
+public:
+  explicit
+    filename_matcher( std::string const & pattern );
+
+  bool
+    operator () ( char const * name, std::size_t size ) const;
+  bool
+    operator () ( std::string const & name ) const
+  { return (*this)(name.data(), name.size()); }
+
+  // observers, for testing:
+  std::string const &  prefix ( ) const  { return prefix_; }
+  std::string const &  suffix ( ) const  { return suffix_; }
+  bool                 literal( ) const  { return literal_; }
+
+  // A matcher for pattern, compiled once per process.
+  static std::shared_ptr<filename_matcher const>
+    get( std::string const & pattern );
+
+private:
+  std::string  prefix_;
+  std::string  suffix_;
+  bool         literal_;  // The pattern is prefix_ alone.
+  std::regex   re_;
+
+};  // filename_matcher
+
+// ======================================================================
+
+#endif /* cetlib_detail_filename_matcher_h */
@@ -0,0 +1,83 @@
+#ifndef cetlib_detail_implementation_choice_h
+#define cetlib_detail_implementation_choice_h
+
+// ======================================================================
+//
+// implementation_choice: the process-wide choice among the
+//                        implementations of a function F that this CPU
+//                        supports
+//
+// The first supported implementation is used unless the environment
+// variable names another; use() switches at any time, from any thread.
+//
+// ======================================================================
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cet {
+  namespace detail {
+
+    template< class F >
+    class implementation_choice
+    {
+    public:
+      struct entry
+      {
+        char const *  name;
+        F *           f;
+      };
+
+      // supported: best first; must not be empty.
+      implementation_choice( std::vector<entry> supported, char const * env_var )
+        : all_    ( std::move(supported) )
+        , current_( & all_.front() )
+      {
+        char const * const env = std::getenv(env_var);
+        if( env != nullptr )
+          use(env);
+      }
+
+      F *
+        get( ) const
+      { return current_.load(std::memory_order_acquire)->f; }
+
+      std::string
+        name( ) const
+      { return current_.load(std::memory_order_acquire)->name; }
+
+      std::vector<std::string>
+        names( ) const
+      {
+        std::vector<std::string> result;
+        for( auto const & e : all_ )
+          result.push_back(e.name);
+        return result;
+      }
+
+      bool
+        use( std::string const & name )
+      {
+        for( auto const & e : all_ )
+          if( name == e.name ) {
+            current_.store(& e, std::memory_order_release);
+            return true;
+          }
+        return false;
+      }
+
+    private:
+      std::vector<entry>           all_;
+      std::atomic<entry const *>   current_;
+
+    };  // implementation_choice
+
+  }
+}
+
+// ======================================================================
+
+#endif /* cetlib_detail_implementation_choice_h */
@@ -0,0 +1,179 @@
+#ifndef cetlib_detail_multibuffer_h
+#define cetlib_detail_multibuffer_h
+
+// ======================================================================
+//
+// multibuffer: hash many independent messages N at a time, one per
+//              lane of a SIMD kernel, for the 64-byte-block
+//              Merkle-Damgard hashes (MD5, SHA-1)
+//
+// The kernel compresses one block for each of N lanes. Its state is
+// transposed, word k of lane i at state[k*N + i], so that each word is
+// one vector. A lane that finishes its message is refilled with the
+// next at once; lanes with nothing left to do hash a dummy block.
+//
+// Traits supplies, for the hash:
+//   static unsigned const words;        // state words
+//   static bool const big_endian;       // byte order of words and length
+//   static std::uint32_t const iv[];    // initial state
+//
+// ======================================================================
+
+#include "cpp0x/cstdint"
+#include <cstddef>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace cet {
+  namespace detail {
+
+    typedef  void  multibuffer_kernel_t( std::uint32_t * state
+                                       , unsigned char const * const * blocks );
+
+    template< class Traits >
+    void
+      multibuffer_put( std::uint32_t w, unsigned char * b )
+    {
+      for( int i = 0; i != 4; ++i )
+        b[i] = (unsigned char)(w >> (Traits::big_endian ? 24 - 8 * i : 8 * i));
+    }
+
+    template< unsigned N, class Traits, class Digest >
+    void
+      multibuffer_digest( multibuffer_kernel_t * kernel
+                        , void const * const * data
+                        , std::size_t const * sizes
+                        , std::size_t n
+                        , Digest * out
+                        )
+    {
+      static unsigned char const idle_block[64] = { 0 };
+
+      struct lane_t
+      {
+        std::size_t            msg;
+        unsigned char const *  next;    // next block of the message body
+        std::size_t            body;    // whole blocks left in the body
+        unsigned char const *  pad;     // next padding block
+        unsigned               tail;    // padding blocks left
+        unsigned char          buf[128];
+      };
+
+      std::uint32_t state[Traits::words * N];
+      lane_t lanes[N];
+      unsigned char const * blocks[N];
+      std::size_t next_msg = 0u;
+      unsigned active = 0u;
+
+      // Start lane i on the next message, if any.
+      auto const start = [&]( unsigned i ) -> bool
+      {
+        if( next_msg == n )
+          return false;
+        lane_t & l = lanes[i];
+        l.msg  = next_msg++;
+        l.next = static_cast<unsigned char const *>(data[l.msg]);
+        std::size_t const size = sizes[l.msg];
+        l.body = size / 64u;
+        std::size_t const r = size % 64u;
+        l.tail = r + 9u <= 64u ? 1u : 2u;
+        l.pad  = l.buf;
+        if( r != 0u )
+          std::memcpy(l.buf, l.next + 64u * l.body, r);
+        l.buf[r] = 0x80;
+        std::memset(l.buf + r + 1u, 0, 64u * l.tail - r - 1u);
+        std::uint64_t const bits = std::uint64_t(size) * 8u;
+        unsigned char * const len = l.buf + 64u * l.tail - 8u;
+        for( int k = 0; k != 8; ++k )
+          len[k] = (unsigned char)(bits >> (Traits::big_endian ? 56 - 8 * k : 8 * k));
+        for( unsigned k = 0; k != Traits::words; ++k )
+          state[k * N + i] = Traits::iv[k];
+        return true;
+      };
+
+      for( unsigned i = 0; i != N; ++i ) {
+        if( start(i) )
+          ++active;
+        else
+          lanes[i].body = lanes[i].tail = 0u;
+      }
+
+      while( active != 0u ) {
+        for( unsigned i = 0; i != N; ++i ) {
+          lane_t const & l = lanes[i];
+          blocks[i] = l.body != 0u ? l.next
+                    : l.tail != 0u ? l.pad
+                    :                idle_block;
+        }
+        kernel(state, blocks);
+        for( unsigned i = 0; i != N; ++i ) {
+          lane_t & l = lanes[i];
+          if( l.body != 0u ) {
+            l.next += 64;
+            --l.body;
+            continue;
+          }
+          if( l.tail == 0u )
+            continue;
+          l.pad += 64;
+          if( --l.tail != 0u )
+            continue;
+          unsigned char * const d = & out[l.msg][0];
+          for( unsigned k = 0; k != Traits::words; ++k )
+            multibuffer_put<Traits>(state[k * N + i], d + 4u * k);
+          if( ! start(i) )
+            --active;
+        }
+      }
+    }
+
+    // Joins every thread of workers on leaving scope, however it is left.
+    struct join_all
+    {
+      std::vector<std::thread> & workers;
+      ~join_all( )
+      {
+        for( auto & w : workers )
+          if( w.joinable() )
+            w.join();
+      }
+    };
+
+    // Calls f(first, last) on up to threads slices of [0, n), on that
+    // many threads; each slice is at least min_slice long. Slices for
+    // which no thread can be started are done on the calling thread.
+    template< class F >
+    void
+      for_each_slice( std::size_t n, unsigned threads, std::size_t min_slice, F f )
+    {
+      std::size_t slices = threads == 0u ? 1u : threads;
+      if( slices > n / min_slice )
+        slices = n / min_slice;
+      if( slices <= 1u ) {
+        f(std::size_t(0u), n);
+        return;
+      }
+      std::vector<std::thread> workers;
+      join_all const  joiner{ workers };
+      workers.reserve(slices - 1u);
+      std::size_t s = 1u;
+      try {
+        for(  ; s != slices; ++s )
+          workers.emplace_back(f, n * s / slices, n * (s + 1u) / slices);
+      }
+      catch( std::system_error const & ) {
+        // Out of threads: the rest are done below.
+      }
+      f(std::size_t(0u), n / slices);
+      for(  ; s != slices; ++s )
+        f(n * s / slices, n * (s + 1u) / slices);
+    }
+
+  }
+}
+
+// ======================================================================
+
+#endif /* cetlib_detail_multibuffer_h */
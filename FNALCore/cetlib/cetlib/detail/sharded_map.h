@@ -0,0 +1,142 @@
+#ifndef cetlib_detail_sharded_map_h
+#define cetlib_detail_sharded_map_h
+
+// ======================================================================
+//
+// sharded_map: an insert-only hash map safe for concurrent use, for the
+//              concurrent registries
+//
+// Keys are spread over a fixed number of shards, each an unordered_map
+// behind its own reader-writer lock, so that threads using different
+// shards don't contend and readers of one shard don't exclude each
+// other. Entries are never erased, and unordered_map keeps its
+// elements in place when it grows, so a pointer to a value remains
+// valid for the life of the map.
+//
+// ======================================================================
+
+#include "cpp0x/cstdint"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace cet {
+  namespace detail {
+    template< class K, class V, class Hash = std::hash<K> >
+      class sharded_map;
+  }
+}
+
+// ======================================================================
+
+template< class K, class V, class Hash >
+  class cet::detail::sharded_map
+{
+public:
+  static std::size_t const  shard_bits = 4u;
+  static std::size_t const  n_shards   = std::size_t(1) << shard_bits;
+
+  sharded_map( ) : shards_(), size_(0u)  { }
+  sharded_map( sharded_map const & ) = delete;
+  sharded_map & operator = ( sharded_map const & ) = delete;
+
+  bool         empty( ) const  { return size() == 0u; }
+  std::size_t  size ( ) const  { return size_.load(std::memory_order_acquire); }
+
+  // The value held for key, or nullptr.
+  V const *
+    find( K const & key ) const;
+
+  // Insert (key, value) unless key is present; returns the value held
+  // for key, and whether it was inserted.
+  std::pair<V const *, bool>
+    insert( K const & key, V const & value );
+
+  // Call f(key, value) for each entry, a shard at a time; entries
+  // inserted meanwhile may or may not be seen.
+  template< class F >
+    void
+    for_each( F f ) const;
+
+private:
+  typedef  std::shared_timed_mutex  mutex_t;
+
+  // Aligned so that no two shards' locks share a cache line.
+  struct alignas(64) shard
+  {
+    mutable mutex_t                  mutex;
+    std::unordered_map<K, V, Hash>   map;
+  };
+
+  shard &        shard_for( K const & key )        { return shards_[index(key)]; }
+  shard const &  shard_for( K const & key ) const  { return shards_[index(key)]; }
+
+  // The top bits of the mixed hash, which is also good for hashes (such
+  // as those of pointers) whose low bits vary little.
+  static std::size_t
+    index( K const & key )
+  {
+    std::uint64_t const  h = Hash()(key);
+    return std::size_t((h * 0x9E3779B97F4A7C15ull) >> (64u - shard_bits));
+  }
+
+  std::array<shard, n_shards>  shards_;
+  std::atomic<std::size_t>     size_;
+
+};  // sharded_map<>
+
+// ----------------------------------------------------------------------
+
+template< class K, class V, class Hash >
+V const *
+  cet::detail::sharded_map<K,V,Hash>::find( K const & key ) const
+{
+  shard const &  s = shard_for(key);
+  std::shared_lock<mutex_t>  lock(s.mutex);
+  auto const  it = s.map.find(key);
+  return it == s.map.end()  ?  nullptr  :  & it->second;
+}
+
+template< class K, class V, class Hash >
+std::pair<V const *, bool>
+  cet::detail::sharded_map<K,V,Hash>::insert( K const & key, V const & value )
+{
+  shard &  s = shard_for(key);
+  {
+    // Most puts of a registry repeat an entry it already has.
+    std::shared_lock<mutex_t>  lock(s.mutex);
+    auto const  it = s.map.find(key);
+    if( it != s.map.end() )
+      return std::make_pair(& it->second, false);
+  }
+  std::lock_guard<mutex_t>  lock(s.mutex);
+  auto const  result = s.map.emplace(key, value);
+  if( result.second )
+    size_.fetch_add(1u, std::memory_order_release);
+  return std::make_pair(& result.first->second, result.second);
+}
+
+template< class K, class V, class Hash >
+template< class F >
+void
+  cet::detail::sharded_map<K,V,Hash>::for_each( F f ) const
+{
+  for( auto const & s : shards_ ) {
+    std::shared_lock<mutex_t>  lock(s.mutex);
+    for( auto const & entry : s.map )
+      f(entry.first, entry.second);
+  }
+}
+
+// ======================================================================
+
+#endif /* cetlib_detail_sharded_map_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,51 @@
+#ifndef cetlib_detail_update_range_h
+#define cetlib_detail_update_range_h
+
+// ======================================================================
+//
+// update_range: feed the bytes of [first, last) to a hasher's
+//               update(void const *, std::size_t), directly if the
+//               iterators are pointers and through a buffer otherwise
+//
+// ======================================================================
+
+#include "cpp0x/type_traits"
+#include <cstddef>
+#include <iterator>
+
+namespace cet {
+  namespace detail {
+
+    template< class Hasher, class T >
+    void
+      update_range( Hasher & h, T * first, T * last )
+    {
+      static_assert( sizeof(T) == 1, "Only ranges of bytes may be hashed." );
+      h.update(first, std::size_t(last - first));
+    }
+
+    template< class Hasher, class InputIt >
+    void
+      update_range( Hasher & h, InputIt first, InputIt last )
+    {
+      typedef  typename std::iterator_traits<InputIt>::value_type  value_type;
+      static_assert( sizeof(value_type) == 1 && std::is_integral<value_type>::value
+                   , "Only ranges of bytes may be hashed." );
+      unsigned char buf[4096];
+      std::size_t n = 0u;
+      for( ; first != last; ++first ) {
+        buf[n++] = static_cast<unsigned char>(*first);
+        if( n == sizeof buf ) {
+          h.update(buf, n);
+          n = 0u;
+        }
+      }
+      h.update(buf, n);
+    }
+
+  }
+}
+
+// ======================================================================
+
+#endif /* cetlib_detail_update_range_h */
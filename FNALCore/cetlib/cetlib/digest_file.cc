@@ -0,0 +1,131 @@
+// ======================================================================
+//
+// digest_file: the digest of a file's contents, computed by any hasher
+//              with update(void const *, std::size_t) and digest()
+//
+// ======================================================================
+
+#include "cetlib/digest_file.h"
+
+#include "cetlib/exception.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  std::string const exception_category("digest_file");
+
+  // Bytes of a mapping hashed between madvise() calls, and of a read().
+  std::size_t const window_sz = std::size_t(16) << 20;
+  std::size_t const read_sz   = std::size_t(1) << 20;
+
+  cet::exception
+    error( char const * what, std::string const & path, int errnum )
+  {
+    return cet::exception(exception_category)
+      << "Can't " << what << " \"" << path << "\": " << std::strerror(errnum) << '\n';
+  }
+
+  struct fd_closer
+  {
+    int fd;
+    ~fd_closer( ) { ::close(fd); }
+  };
+
+  // Hash the regular file fd of size bytes through a mapping; false if
+  // it can't be mapped.
+  bool
+    map_chunks( int fd, off_t size
+              , std::function<void(void const *, std::size_t)> const & f )
+  {
+    if( std::uintmax_t(size) > std::numeric_limits<std::size_t>::max() )
+      return false;
+    std::size_t const sz = std::size_t(size);
+    void * const addr = ::mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+    if( addr == MAP_FAILED )
+      return false;
+    struct unmapper
+    {
+      void * addr; std::size_t sz;
+      ~unmapper( ) { ::munmap(addr, sz); }
+    } const unmap = { addr, sz };
+
+    char * const base = static_cast<char *>(addr);
+    ::madvise(base, sz, MADV_SEQUENTIAL);
+    for( std::size_t offset = 0u; offset < sz; offset += window_sz ) {
+      std::size_t const n = std::min(window_sz, sz - offset);
+      std::size_t const next = offset + n;
+      if( next < sz )
+        ::madvise(base + next, std::min(window_sz, sz - next), MADV_WILLNEED);
+      f(base + offset, n);
+      // Whole pages only: the last may be shared with the next window.
+      std::size_t const page = std::size_t(::sysconf(_SC_PAGESIZE));
+      std::size_t const done = next < sz ? next / page * page : sz;
+      if( done > offset )
+        ::madvise(base + offset, done - offset, MADV_DONTNEED);
+    }
+    return true;
+  }
+
+  void
+    read_chunks( int fd, std::string const & path
+               , std::function<void(void const *, std::size_t)> const & f )
+  {
+#ifdef POSIX_FADV_SEQUENTIAL
+    (void) ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    void * buf = nullptr;
+    if( ::posix_memalign(&buf, std::size_t(::sysconf(_SC_PAGESIZE)), read_sz) != 0 )
+      throw error("allocate a read buffer for", path, ENOMEM);
+    struct freer
+    {
+      void * p;
+      ~freer( ) { std::free(p); }
+    } const free_buf = { buf };
+
+    for( ; ; ) {
+      ssize_t const n = ::read(fd, buf, read_sz);
+      if( n == 0 )
+        return;
+      if( n < 0 ) {
+        if( errno == EINTR )
+          continue;
+        throw error("read", path, errno);
+      }
+      f(buf, std::size_t(n));
+    }
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+void
+  cet::detail::for_each_file_chunk( std::string const & path
+                                  , std::function<void(void const *, std::size_t)> const & f
+                                  )
+{
+  int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if( fd < 0 )
+    throw error("open", path, errno);
+  fd_closer const closer = { fd };
+
+  struct stat st;
+  if( ::fstat(fd, &st) != 0 )
+    throw error("stat", path, errno);
+  if( S_ISREG(st.st_mode) && st.st_size > 0 && map_chunks(fd, st.st_size, f) )
+    return;
+  read_chunks(fd, path, f);
+}
+
+// ======================================================================
@@ -0,0 +1,58 @@
+#ifndef CETLIB_DIGEST_FILE_H
+#define CETLIB_DIGEST_FILE_H
+
+// ======================================================================
+//
+// digest_file: the digest of a file's contents, computed by any hasher
+//              with update(void const *, std::size_t) and digest()
+//              (cet::sha1, cet::md5, cet::crc32) without reading the
+//              file into memory
+//
+// Regular files are mapped and hashed a window at a time, with the next
+// window prefetched and the hashed ones released, so that memory use
+// stays small for files of any size; other files (pipes, devices) and
+// files that can't be mapped are read in large aligned chunks, with
+// sequential readahead requested. A file that is truncated while it is
+// being hashed through a mapping raises SIGBUS, as for any mapping.
+//
+// Throws cet::exception (category "digest_file") if the file can't be
+// opened or read.
+//
+// ======================================================================
+
+#include "cpp0x/functional"
+#include <cstddef>
+#include <string>
+
+namespace cet {
+
+  template< class Hasher >
+    typename Hasher::digest_t
+    digest_file( std::string const & path );
+
+  namespace detail {
+    void
+      for_each_file_chunk( std::string const & path
+                         , std::function<void(void const *, std::size_t)> const & f
+                         );
+  }
+
+}
+
+// ======================================================================
+
+template< class Hasher >
+typename Hasher::digest_t
+  cet::digest_file( std::string const & path )
+{
+  Hasher h;
+  detail::for_each_file_chunk( path
+                             , [&h]( void const * data, std::size_t size ) {
+                                 h.update(data, size);
+                               } );
+  return h.digest();
+}
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,216 @@
+// ======================================================================
+//
+// file_cache: Opt-in, process-wide, thread-safe cache of
+//             a) the contents of files read by cet::includer, and
+//             b) the results of search_path::find_file()
+//
+// ======================================================================
+
+#include "cetlib/file_cache.h"
+
+#include <atomic>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+using cet::file_cache;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  struct file_id
+  {
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    time_t mtime;
+    long mtime_ns;
+
+    bool operator == ( file_id const & other ) const
+    {
+      return dev == other.dev && ino == other.ino && size == other.size
+          && mtime == other.mtime && mtime_ns == other.mtime_ns;
+    }
+  };
+
+  file_id
+    make_id( struct stat const & st )
+  {
+#ifdef __APPLE__
+    long const ns = st.st_mtimespec.tv_nsec;
+#else
+    long const ns = st.st_mtim.tv_nsec;
+#endif
+    return { st.st_dev, st.st_ino, st.st_size, st.st_mtime, ns };
+  }
+
+  struct content_entry
+  {
+    file_id                  id;
+    file_cache::contents_ptr contents;
+  };
+
+  struct cache_state
+  {
+    std::atomic<bool> enabled { false };
+    std::mutex mutex;
+    std::unordered_map<std::string, content_entry> contents;
+    std::unordered_map<std::string, std::pair<bool, std::string>> lookups;
+    std::atomic<std::size_t> content_hits   { 0u };
+    std::atomic<std::size_t> content_misses { 0u };
+    std::atomic<std::size_t> content_stale  { 0u };
+    std::atomic<std::size_t> lookup_hits    { 0u };
+    std::atomic<std::size_t> lookup_misses  { 0u };
+  };
+
+  cache_state &
+    state( )
+  {
+    static cache_state s;
+    return s;
+  }
+
+  // Read the whole of the open file fd, whose size is expected to be
+  // size_hint (the file may change while it is read).
+  file_cache::contents_ptr
+    slurp( int fd, off_t size_hint )
+  {
+    std::string text;
+    text.resize(size_hint > 0 ? static_cast<std::size_t>(size_hint) : 0u);
+    std::size_t have = 0u;
+    for(;;) {
+      if( have == text.size() )
+        text.resize(have + 4096u);
+      ssize_t const n = ::read(fd, &text[have], text.size() - have);
+      if( n < 0 )
+        return file_cache::contents_ptr();
+      if( n == 0 )
+        break;
+      have += static_cast<std::size_t>(n);
+    }
+    text.resize(have);
+    return std::make_shared<std::string const>(std::move(text));
+  }
+
+}
+
+// ----------------------------------------------------------------------
+
+void
+  file_cache::enable( bool on )
+{
+  state().enabled = on;
+}
+
+bool
+  file_cache::enabled( )
+{
+  return state().enabled;
+}
+
+void
+  file_cache::clear( )
+{
+  cache_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.contents.clear();
+  s.lookups.clear();
+  s.content_hits = s.content_misses = s.content_stale = 0u;
+  s.lookup_hits = s.lookup_misses = 0u;
+}
+
+auto
+  file_cache::stats( )
+  -> statistics
+{
+  cache_state const & s = state();
+  return { s.content_hits, s.content_misses, s.content_stale
+         , s.lookup_hits, s.lookup_misses };
+}
+
+// ----------------------------------------------------------------------
+
+auto
+  file_cache::read( std::string const & filepath )
+  -> contents_ptr
+{
+  cache_state & s = state();
+  bool const use_cache = s.enabled;
+  bool stale = false;
+
+  if( use_cache ) {
+    struct stat st;
+    if( ::stat(filepath.c_str(), &st) != 0 )
+      return contents_ptr();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.contents.find(filepath);
+    if( it != s.contents.end() ) {
+      if( it->second.id == make_id(st) ) {
+        ++s.content_hits;
+        return it->second.contents;
+      }
+      stale = true;
+    }
+  }
+
+  int const fd = ::open(filepath.c_str(), O_RDONLY);
+  if( fd < 0 )
+    return contents_ptr();
+  struct stat st;
+  contents_ptr result;
+  if( ::fstat(fd, &st) == 0 && ! S_ISDIR(st.st_mode) )
+    result = slurp(fd, st.st_size);
+  ::close(fd);
+
+  if( use_cache && result ) {
+    ++s.content_misses;
+    if( stale )
+      ++s.content_stale;
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.contents[filepath] = content_entry{ make_id(st), result };
+  }
+  return result;
+}  // read()
+
+// ----------------------------------------------------------------------
+
+bool
+  file_cache::find_file( std::string const & path
+                       , std::string const & filename
+                       , std::string       & result
+                       , std::function<bool (std::string &)> const & probe
+                       )
+{
+  cache_state & s = state();
+  if( ! s.enabled )
+    return probe(result);
+
+  std::string key(path);
+  key.append(1, '\0').append(filename);
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.lookups.find(key);
+    if( it != s.lookups.end() ) {
+      ++s.lookup_hits;
+      if( it->second.first )
+        result = it->second.second;
+      return it->second.first;
+    }
+  }
+
+  ++s.lookup_misses;
+  std::string found;
+  bool const ok = probe(found);
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.lookups.emplace(std::move(key), std::make_pair(ok, found));
+  }
+  if( ok )
+    result = found;
+  return ok;
+}  // find_file()
+
+// ======================================================================
@@ -0,0 +1,68 @@
+#ifndef CETLIB_FILE_CACHE_H
+#define CETLIB_FILE_CACHE_H
+
+// ======================================================================
+//
+// file_cache: Opt-in, process-wide, thread-safe cache of
+//             a) the contents of files read by cet::includer, and
+//             b) the results of search_path::find_file()
+//
+// Contents are revalidated on each use against the file's inode, size
+// and modification time. Lookups (including failed ones) are reused
+// without touching the filesystem, so clear() must be called if files
+// are added to or removed from a search path while caching is enabled.
+//
+// ======================================================================
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace cet {
+  class file_cache;
+}
+
+// ----------------------------------------------------------------------
+
+class cet::file_cache
+{
+public:
+  typedef  std::shared_ptr<std::string const>  contents_ptr;
+
+  struct statistics
+  {
+    std::size_t content_hits;     // Served from the cache.
+    std::size_t content_misses;   // Read from disk (first use or stale).
+    std::size_t content_stale;    // Of the misses, entries found outdated.
+    std::size_t lookup_hits;      // find_file() answered from the cache.
+    std::size_t lookup_misses;    // find_file() probed the directories.
+  };
+
+  file_cache( ) = delete;
+
+  // control:
+  static void        enable ( bool on = true );
+  static bool        enabled( );
+  static void        clear  ( );  // Also resets the statistics.
+  static statistics  stats  ( );
+
+  // Contents of filepath, or nullptr if it can't be opened. Reads the
+  // file directly (without caching) when the cache is disabled.
+  static contents_ptr
+    read( std::string const & filepath );
+
+  // Memoized result of probe for (path, filename): probe is called
+  // only on a cache miss or when the cache is disabled.
+  static bool
+    find_file( std::string const & path
+             , std::string const & filename
+             , std::string       & result
+             , std::function<bool (std::string &)> const & probe
+             );
+
+};  // file_cache
+
+// ======================================================================
+
+#endif
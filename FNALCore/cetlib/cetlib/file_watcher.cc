@@ -0,0 +1,208 @@
+// ======================================================================
+//
+// file_watcher: Report modifications of a set of files
+//
+// ======================================================================
+
+#include "cetlib/file_watcher.h"
+
+#include "cetlib/exception.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+using cet::file_watcher;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  std::pair<std::string, std::string>
+    split( std::string const & filepath )
+  {
+    std::string::size_type const slash = filepath.rfind('/');
+    if( slash == std::string::npos )
+      return std::make_pair(std::string("."), filepath);
+    return std::make_pair( slash == 0u ? std::string("/")
+                                       : filepath.substr(0u, slash)
+                         , filepath.substr(slash + 1u)
+                         );
+  }
+
+  std::pair<std::time_t, long long>
+    stamp( std::string const & filepath )
+  {
+    struct stat st;
+    if( ::stat(filepath.c_str(), &st) != 0 )
+      return std::make_pair(std::time_t(-1), -1ll);
+    return std::make_pair(st.st_mtime, static_cast<long long>(st.st_size));
+  }
+
+  void
+    add_once( std::vector<std::string> & v, std::string const & s )
+  {
+    if( std::find(v.begin(), v.end(), s) == v.end() )
+      v.push_back(s);
+  }
+
+  typedef  std::chrono::steady_clock  steady;
+
+}
+
+// ----------------------------------------------------------------------
+
+file_watcher::file_watcher( )
+  : fd_    ( -1 )
+  , dirs_  ( )
+  , stamps_( )
+{
+#ifdef __linux__
+  fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if( fd_ < 0 )
+    throw cet::exception("file_watcher")
+      << "can't create inotify instance: " << std::strerror(errno) << '\n';
+#endif
+}
+
+file_watcher::~file_watcher( )
+{
+  if( fd_ >= 0 )
+    ::close(fd_);
+}
+
+// ----------------------------------------------------------------------
+
+void
+  file_watcher::watch( std::string const & filepath )
+{
+  if( fd_ < 0 ) {
+    stamps_.insert(std::make_pair(filepath, stamp(filepath)));
+    return;
+  }
+#ifdef __linux__
+  auto const parts = split(filepath);
+  auto it = dirs_.find(parts.first);
+  if( it == dirs_.end() ) {
+    int const wd = ::inotify_add_watch( fd_, parts.first.c_str()
+                                      , IN_CLOSE_WRITE | IN_MOVED_TO
+                                      | IN_MOVED_FROM | IN_CREATE
+                                      | IN_DELETE | IN_ATTRIB
+                                      );
+    if( wd < 0 )
+      throw cet::exception("file_watcher")
+        << "can't watch directory " << parts.first
+        << " of " << filepath << ": " << std::strerror(errno) << '\n';
+    it = dirs_.insert(std::make_pair(parts.first, directory{ wd, { } })).first;
+  }
+  it->second.files.insert(std::make_pair(parts.second, filepath));
+#endif
+}
+
+void
+  file_watcher::watch( std::vector<std::string> const & filepaths )
+{
+  for( auto const & filepath : filepaths )
+    watch(filepath);
+}
+
+void
+  file_watcher::clear( )
+{
+#ifdef __linux__
+  for( auto const & d : dirs_ )
+    ::inotify_rm_watch(fd_, d.second.wd);
+#endif
+  dirs_.clear();
+  stamps_.clear();
+}
+
+// ----------------------------------------------------------------------
+
+std::vector<std::string>
+  file_watcher::poll_( )
+{
+  std::vector<std::string> result;
+  for( auto & s : stamps_ ) {
+    auto const now = stamp(s.first);
+    if( now != s.second ) {
+      s.second = now;
+      result.push_back(s.first);
+    }
+  }
+  return result;
+}
+
+std::vector<std::string>
+  file_watcher::wait( int timeout_ms )
+{
+  auto const deadline = steady::now() + std::chrono::milliseconds(timeout_ms);
+  auto remaining = [&]() -> int
+  {
+    if( timeout_ms < 0 )
+      return -1;
+    auto const left = std::chrono::duration_cast<std::chrono::milliseconds>
+                      (deadline - steady::now()).count();
+    return left > 0 ? static_cast<int>(left) : 0;
+  };
+
+  std::vector<std::string> result;
+  if( fd_ < 0 ) {
+    for( ; ; ) {
+      result = poll_();
+      int const left = remaining();
+      if( ! result.empty() || left == 0 )
+        return result;
+      std::this_thread::sleep_for
+        (std::chrono::milliseconds(left < 0 ? 100 : std::min(left, 100)));
+    }
+  }
+
+#ifdef __linux__
+  alignas(struct inotify_event) char buf[8192];
+  for( ; ; ) {
+    struct pollfd pfd = { fd_, POLLIN, 0 };
+    int const n = ::poll(&pfd, 1, remaining());
+    if( n < 0 && errno != EINTR )
+      throw cet::exception("file_watcher")
+        << "poll failed: " << std::strerror(errno) << '\n';
+
+    // drain all pending events:
+    for( ; ; ) {
+      ssize_t const len = ::read(fd_, buf, sizeof buf);
+      if( len <= 0 ) {
+        if( len < 0 && errno != EAGAIN && errno != EINTR )
+          throw cet::exception("file_watcher")
+            << "read failed: " << std::strerror(errno) << '\n';
+        break;
+      }
+      for( char const * p = buf; p < buf + len; ) {
+        auto const ev = reinterpret_cast<struct inotify_event const *>(p);
+        p += sizeof(struct inotify_event) + ev->len;
+        if( ev->len == 0u )
+          continue;
+        for( auto const & d : dirs_ ) {
+          if( d.second.wd != ev->wd )
+            continue;
+          auto const f = d.second.files.find(ev->name);
+          if( f != d.second.files.end() )
+            add_once(result, f->second);
+        }
+      }
+    }
+
+    if( ! result.empty() || remaining() == 0 )
+      return result;
+  }
+#endif
+  return result;
+}  // wait()
+
+// ======================================================================
@@ -0,0 +1,64 @@
+#ifndef CETLIB_FILE_WATCHER_H
+#define CETLIB_FILE_WATCHER_H
+
+// ======================================================================
+//
+// file_watcher: Report modifications of a set of files
+//
+// On Linux, the directories holding the watched files are monitored
+// with inotify, so files that editors replace (write to a temporary,
+// then rename) are followed as well as files written in place. On
+// other platforms the files' modification times are polled.
+//
+// ======================================================================
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cet {
+  class file_watcher;
+}
+
+// ----------------------------------------------------------------------
+
+class cet::file_watcher
+{
+public:
+  file_watcher( );
+  file_watcher( file_watcher const & ) = delete;
+  file_watcher & operator = ( file_watcher const & ) = delete;
+  ~file_watcher( );
+
+  void  watch( std::string const & filepath );
+  void  watch( std::vector<std::string> const & filepaths );
+  void  clear( );
+
+  // Watched files changed (written, replaced, created or removed)
+  // since the previous call, waiting up to timeout_ms milliseconds
+  // (forever if negative) for the first change. Each file is reported
+  // once, in the spelling given to watch().
+  std::vector<std::string>  wait( int timeout_ms );
+
+private:
+  typedef  std::pair<std::time_t, long long>  stamp_t;  // mtime, size
+
+  struct directory
+  {
+    int                                 wd;
+    std::map<std::string, std::string>  files;  // basename -> filepath
+  };
+
+  int                                 fd_;      // inotify instance, or -1
+  std::map<std::string, directory>    dirs_;    // keyed by directory
+  std::map<std::string, stamp_t>      stamps_;  // when polling
+
+  std::vector<std::string>  poll_( );
+
+};  // file_watcher
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,99 @@
+// ======================================================================
+//
+// include_graph: The #include structure of a document as recorded by
+//                cet::includer or cet::mapped_includer, with a digest
+//                of the contents of each file as it was read
+//
+// ======================================================================
+
+#include "cetlib/include_graph.h"
+
+#include "cetlib/file_cache.h"
+#include <algorithm>
+
+using cet::include_graph;
+
+std::size_t const include_graph::no_parent;
+
+// ----------------------------------------------------------------------
+
+std::size_t
+  include_graph::add( std::string const & filepath
+                    , std::size_t         parent
+                    , digest_t const    & digest
+                    )
+{
+  std::size_t const n = nodes_.size();
+  nodes_.push_back(node{ filepath, digest, parent, std::vector<std::size_t>() });
+  if( parent != no_parent )
+    nodes_[parent].includes.push_back(n);
+  return n;
+}
+
+void
+  include_graph::set_digest( std::size_t n, digest_t const & digest )
+{
+  nodes_.at(n).digest = digest;
+}
+
+// ----------------------------------------------------------------------
+
+std::vector<std::string>
+  include_graph::files( ) const
+{
+  std::vector<std::string> result;
+  for( auto const & n : nodes_ ) {
+    if( std::find(result.begin(), result.end(), n.filepath) == result.end() )
+      result.push_back(n.filepath);
+  }
+  return result;
+}
+
+bool
+  include_graph::depends_on( std::string const & filepath ) const
+{
+  return std::find_if( nodes_.begin(), nodes_.end()
+                     , [&filepath](node const & n)
+                       { return n.filepath == filepath; }
+                     ) != nodes_.end();
+}
+
+std::vector<std::string>
+  include_graph::changed_files( ) const
+{
+  std::vector<std::string> result;
+  std::vector<std::string> checked;
+  for( auto const & n : nodes_ ) {
+    if( n.filepath == "-"
+     || std::find(checked.begin(), checked.end(), n.filepath) != checked.end() )
+      continue;
+    checked.push_back(n.filepath);
+    digest_t current;
+    if( ! current_digest(n.filepath, current) || current != n.digest )
+      result.push_back(n.filepath);
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------
+
+auto
+  include_graph::digest_of( char const * begin, char const * end )
+  -> digest_t
+{
+  return cet::sha1().update(begin, std::size_t(end - begin)).digest();
+}
+
+bool
+  include_graph::current_digest( std::string const & filepath
+                               , digest_t          & result
+                               )
+{
+  cet::file_cache::contents_ptr const contents = cet::file_cache::read(filepath);
+  if( ! contents )
+    return false;
+  result = digest_of(contents->data(), contents->data() + contents->size());
+  return true;
+}
+
+// ======================================================================
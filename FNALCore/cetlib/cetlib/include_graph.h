@@ -0,0 +1,76 @@
+#ifndef CETLIB_INCLUDE_GRAPH_H
+#define CETLIB_INCLUDE_GRAPH_H
+
+// ======================================================================
+//
+// include_graph: The #include structure of a document as recorded by
+//                cet::includer or cet::mapped_includer, with a digest
+//                of the contents of each file as it was read
+//
+// Node 0 is the top-level document; each #include directive adds one
+// node, so a file #included more than once appears once per inclusion.
+// The pseudo-file "-" (standard input or a stream) is never reported
+// as changed, as it can't be read again. The includers compute the
+// digests only when asked to; a graph recorded without them reports
+// every file as changed.
+//
+// ======================================================================
+
+#include "cetlib/sha1.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cet {
+  class include_graph;
+}
+
+// ----------------------------------------------------------------------
+
+class cet::include_graph
+{
+public:
+  typedef  cet::sha1::digest_t  digest_t;
+
+  static std::size_t const  no_parent = std::size_t(-1);
+
+  struct node
+  {
+    std::string               filepath;
+    digest_t                  digest;
+    std::size_t               parent;    // no_parent for node 0
+    std::vector<std::size_t>  includes;  // in order of #inclusion
+  };
+
+  // recording:
+  std::size_t  add( std::string const & filepath
+                  , std::size_t         parent
+                  , digest_t const    & digest = digest_t()
+                  );
+  void         set_digest( std::size_t n, digest_t const & digest );
+
+  // queries:
+  std::vector<node> const &  nodes( ) const  { return nodes_; }
+  bool                       empty( ) const  { return nodes_.empty(); }
+  std::vector<std::string>   files( ) const;  // distinct, in order of first use
+  bool                       depends_on( std::string const & filepath ) const;
+
+  // Files whose current contents no longer match the recorded digest
+  // (including files that can no longer be read).
+  std::vector<std::string>   changed_files( ) const;
+  bool                       up_to_date( ) const  { return changed_files().empty(); }
+
+  // helpers:
+  static digest_t  digest_of( char const * begin, char const * end );
+  static bool      current_digest( std::string const & filepath
+                                 , digest_t          & result
+                                 );
+
+private:
+  std::vector<node>  nodes_;
+
+};  // include_graph
+
+// ======================================================================
+
+#endif
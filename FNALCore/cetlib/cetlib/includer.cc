@@ -9,13 +9,15 @@
 #include "cetlib/includer.h"
 
 #include "cetlib/coded_exception.h"
+#include "cetlib/file_cache.h"
 #include "cetlib/trim.h"
 #include "cpp0x/algorithm"
 
 #include <algorithm>
 #include <cctype>
-#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <sstream>
 
 using cet::includer;
@@ -58,13 +60,16 @@ using namespace ::detail;
 
 includer::includer( std::string const   & filename
                   , cet::filepath_maker & abs_filename
+                  , bool                  record_digests
                   )
   :
   text  ( ),
   frames { frame(0, begin_string(), 0, text.size()) },
-  recursion_stack ( )
+  recursion_stack ( ),
+  graph_ ( ),
+  digests_ ( record_digests )
 {
-  include(0, filename, abs_filename);
+  include(0, filename, abs_filename, include_graph::no_parent);
   frames.emplace_back(0, end_string(), 0, text.size());
 }
 
@@ -72,11 +77,14 @@ includer::includer( std::string const   & filename
 
 includer::includer( std::istream        & is
                   , cet::filepath_maker & abs_filename
+                  , bool                  record_digests
                   )
  :
   text  ( ),
   frames { frame(0, begin_string(), 0, text.size()) },
-  recursion_stack ( )
+  recursion_stack ( ),
+  graph_ ( ),
+  digests_ ( record_digests )
 {
   include(is, abs_filename);
   frames.emplace_back(0, end_string(), 0, text.size());
@@ -158,6 +166,7 @@ void
   includer::include( int                   including_framenum
                    , std::string const   & filename
                    , cet::filepath_maker & abs_filename
+                   , std::size_t           including_node
                    )
 {
   static  std::string const  inc_lit = std::string("#include");
@@ -180,26 +189,43 @@ void
     recursion_stack.emplace_back(filepath);
   }
 
-  // open the #included file:
-  std::ifstream ifs;
-  if( ! use_cin )
-    ifs.open(filepath.c_str(), std::ifstream::in);
-  std::istream & f = use_cin ? std::cin : ifs;
-  if( ! f )
+  // obtain the #included file's contents (possibly already cached):
+  cet::file_cache::contents_ptr contents;
+  if( use_cin ) {
+    if( std::cin )
+      contents = std::make_shared<std::string const>
+                 ( std::istreambuf_iterator<char>(std::cin)
+                 , std::istreambuf_iterator<char>()
+                 );
+  }
+  else
+    contents = cet::file_cache::read(filepath);
+  if( ! contents )
     throw inc_exception(cant_open)
        << filename << " => " << filepath
        << backtrace( frames.size()-1u );
+  std::string const & f = *contents;
+  std::size_t const node
+    = digests_ ? graph_.add( filepath, including_node
+                           , include_graph::digest_of(f.data(), f.data() + f.size())
+                           )
+               : graph_.add(filepath, including_node);
 
   int linenum = 1;
   frame new_frame( including_framenum, filepath, linenum, text.size() );
 
   // iterate over each line of the input file:
-  for( std::string line; std::getline(f, line); ++linenum  ) {
-    if( line.find(inc_lit) != 0 ) {  // ordinary line (not an #include)
-      text.append(line)
+  std::string line;
+  for( std::size_t pos = 0u, eol; pos < f.size(); pos = eol + 1u, ++linenum ) {
+    eol = f.find('\n', pos);
+    if( eol == std::string::npos )
+      eol = f.size();
+    if( f.compare(pos, inc_lit.size(), inc_lit) != 0 ) {  // ordinary line (not an #include)
+      text.append(f, pos, eol - pos)
           .append(1, '\n');
       continue;
     }
+    line.assign(f, pos, eol - pos);
 
     // save buffered text:
     frames.push_back(new_frame);
@@ -222,7 +248,7 @@ void
     std::string nextfilename( line.substr( min_sz - 1u
                                          , line.size() - min_sz
                             )            );
-    include(frames.size()-1u, nextfilename, abs_filename);
+    include(frames.size()-1u, nextfilename, abs_filename, node);
 
     // prepare to resume where we left off:
     new_frame.starting_linenum = linenum + 1;
@@ -258,9 +284,13 @@ void
 
   int linenum = 1;
   frame new_frame( 0, filepath, linenum, text.size() );
+  std::size_t const node = graph_.add(filepath, include_graph::no_parent);
+  cet::sha1 digest;
 
   // iterate over each line of the input file:
   for( std::string line; std::getline(f, line); ++linenum  ) {
+    if( digests_ )
+      digest << line << '\n';
     if( line.find(inc_lit) != 0 ) {  // ordinary line (not an #include)
       text.append(line)
           .append(1, '\n');
@@ -288,7 +318,7 @@ void
     std::string nextfilename( line.substr( min_sz - 1u
                                          , line.size() - min_sz
                             )            );
-    include(frames.size()-1u, nextfilename, abs_filename);
+    include(frames.size()-1u, nextfilename, abs_filename, node);
 
     // prepare to resume where we left off:
     new_frame.starting_linenum = linenum + 1;
@@ -297,6 +327,8 @@ void
 
   // save final buffered text:
   frames.push_back(new_frame);
+  if( digests_ )
+    graph_.set_digest(node, digest.digest());
 
 }  // include()
 
@@ -7,9 +7,14 @@
 //           a) transparently handles #include'd files, and
 //           b) can trace back its iterators
 //
+// The include graph always records the files read; the digests of
+// their contents, needed by include_graph::changed_files(), are
+// computed only if record_digests is set.
+//
 // ======================================================================
 
 #include "cetlib/filepath_maker.h"
+#include "cetlib/include_graph.h"
 #include <string>
 #include <vector>
 
@@ -28,14 +33,18 @@ public:
 
   explicit        includer( std::string const   & filename
                           , cet::filepath_maker & abs_filename
+                          , bool                  record_digests = false
                           );
   explicit        includer( std::istream        & is
                           , cet::filepath_maker & abs_filename
+                          , bool                  record_digests = false
                           );
   const_iterator  begin   ( ) const  { return text.begin(); }
   const_iterator  end     ( ) const  { return text.end  (); }
   std::string     whereis ( const_iterator const & it ) const;
   std::string     highlighted_whereis (const_iterator const & it ) const;
+  cet::include_graph const &
+                  graph   ( ) const  { return graph_; }
 
 private:
 
@@ -65,10 +74,13 @@ frame( uint framenum, std::string filename, uint linenum, size_t textpos )
   std::string         text;
   std::vector<frame>  frames;
   std::vector<std::string> recursion_stack;
+  cet::include_graph  graph_;
+  bool                digests_;
 
   void  include ( int                   including_framenum
                 , std::string const   & filename
                 , cet::filepath_maker & abs_filename
+                , std::size_t           including_node
                 );
   void  include ( std::istream        & is
                 , cet::filepath_maker & abs_filename
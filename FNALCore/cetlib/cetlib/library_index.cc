@@ -0,0 +1,374 @@
+// ======================================================================
+//
+// library_index: Process-wide, thread-safe index of the libraries that
+//                cet::LibraryManager finds in a search path
+//
+// The cache file is text, one record per index:
+//
+//   cet::library_index 1
+//   K <search path> <lib_type> <pattern>
+//   D <mtime s> <mtime ns> <dir>      (one per directory; -1 if absent)
+//   L <filename> <full path>          (lib_loc_map)
+//   S <libspec> <full path>           (spec_trans_map)
+//   E
+//
+// with fields separated by tabs. Indices whose strings contain tabs or
+// newlines are not written.
+//
+// ======================================================================
+
+#include "cetlib/library_index.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using cet::library_index;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  char const  file_header[] = "cet::library_index 1";
+
+  // Directories modified this recently before a scan may change again
+  // without their recorded time changing.
+  long const  racy_seconds = 2;
+
+  struct dir_time
+  {
+    long long sec;   // -1 if the directory can't be stat'ed
+    long      nsec;
+
+    bool operator == ( dir_time const & other ) const
+    { return sec == other.sec && nsec == other.nsec; }
+  };
+  typedef  std::vector<dir_time>  stamp_t;
+
+  struct stamped_index
+  {
+    stamp_t                   stamp;
+    library_index::entry_ptr  index;
+  };
+
+  struct index_state
+  {
+    std::mutex mutex;
+    std::string cache_file;
+    std::unordered_map<std::string, stamped_index> indices;
+    std::atomic<std::size_t> memory_hits { 0u };
+    std::atomic<std::size_t> file_hits   { 0u };
+    std::atomic<std::size_t> scans       { 0u };
+    std::atomic<std::size_t> stale       { 0u };
+
+    index_state( )
+    {
+      char const * const env = std::getenv("CET_LIBRARY_INDEX");
+      if( env != nullptr )
+        cache_file = env;
+    }
+  };
+
+  index_state &
+    state( )
+  {
+    static index_state s;
+    return s;
+  }
+
+  stamp_t
+    stamp( cet::search_path const & path )
+  {
+    stamp_t result;
+    for( std::size_t k = 0; k != path.size(); ++k ) {
+      struct stat st;
+      if( ::stat(path[k].c_str(), &st) != 0 ) {
+        result.push_back(dir_time{ -1, 0 });
+        continue;
+      }
+#ifdef __APPLE__
+      long const ns = st.st_mtimespec.tv_nsec;
+#else
+      long const ns = st.st_mtim.tv_nsec;
+#endif
+      result.push_back(dir_time{ (long long)st.st_mtime, ns });
+    }
+    return result;
+  }
+
+  bool
+    is_racy( stamp_t const & s, std::time_t scan_start )
+  {
+    for( auto const & t : s )
+      if( t.sec >= (long long)scan_start - racy_seconds )
+        return true;
+    return false;
+  }
+
+  void
+    fill_good_specs( library_index::entry & e )
+  {
+    e.good_spec_trans_map.clear();
+    for( auto const & spec : e.spec_trans_map )
+      if( spec.second.size() == 1u )
+        e.good_spec_trans_map[spec.first] = *spec.second.begin();
+  }
+
+  // --------------------------------------------------------------------
+  // Cache file:
+
+  // (key, the record's lines after K up to E)
+  typedef  std::vector<std::pair<std::string, std::string> >  records_t;
+
+  bool
+    is_writable( std::string const & s )
+  { return s.find_first_of("\t\n") == std::string::npos; }
+
+  records_t
+    read_records( std::string const & filepath )
+  {
+    records_t result;
+    std::ifstream in(filepath.c_str());
+    std::string line;
+    if( ! std::getline(in, line) || line != file_header )
+      return result;
+    std::string key, body;
+    bool in_record = false;
+    while( std::getline(in, line) ) {
+      if( line.compare(0, 2, "K\t") == 0 ) {
+        key = line.substr(2);
+        body.clear();
+        in_record = true;
+      }
+      else if( line == "E" ) {
+        if( in_record )
+          result.emplace_back(key, body);
+        in_record = false;
+      }
+      else if( in_record )
+        body.append(line).append(1, '\n');
+    }
+    return result;
+  }
+
+  // The fields of a D, L or S line, after its tag.
+  bool
+    split_line( std::string const & line, std::string & a, std::string & b )
+  {
+    std::size_t const t1 = 1u;
+    std::size_t const t2 = line.find('\t', t1 + 1u);
+    if( line.size() < 2u || line[t1] != '\t' || t2 == std::string::npos )
+      return false;
+    a = line.substr(t1 + 1u, t2 - t1 - 1u);
+    b = line.substr(t2 + 1u);
+    return true;
+  }
+
+  bool
+    parse_record( std::string const & body, stamp_t & s, library_index::entry & e )
+  {
+    std::size_t pos = 0u;
+    while( pos < body.size() ) {
+      std::size_t const eol = body.find('\n', pos);
+      std::string const line = body.substr(pos, eol - pos);
+      pos = eol + 1u;
+      std::string a, b;
+      if( ! split_line(line, a, b) )
+        return false;
+      switch( line[0] ) {
+        case 'D': {
+          std::size_t const t = b.find('\t');
+          if( t == std::string::npos )
+            return false;
+          s.push_back(dir_time{ std::atoll(a.c_str()), std::atol(b.substr(0, t).c_str()) });
+          break;
+        }
+        case 'L':
+          e.lib_loc_map[a] = b;
+          break;
+        case 'S':
+          e.spec_trans_map[a].insert(b);
+          break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  std::string
+    format_record( cet::search_path const & path
+                 , stamp_t const & s, library_index::entry const & e )
+  {
+    std::string body;
+    for( std::size_t k = 0; k != s.size(); ++k )
+      body.append("D\t").append(std::to_string(s[k].sec))
+          .append(1, '\t').append(std::to_string(s[k].nsec))
+          .append(1, '\t').append(path[k]).append(1, '\n');
+    for( auto const & loc : e.lib_loc_map )
+      body.append("L\t").append(loc.first)
+          .append(1, '\t').append(loc.second).append(1, '\n');
+    for( auto const & spec : e.spec_trans_map )
+      for( auto const & lib : spec.second )
+        body.append("S\t").append(spec.first)
+            .append(1, '\t').append(lib).append(1, '\n');
+    return body;
+  }
+
+  bool
+    is_writable( cet::search_path const & path, library_index::entry const & e )
+  {
+    for( std::size_t k = 0; k != path.size(); ++k )
+      if( ! is_writable(path[k]) )
+        return false;
+    for( auto const & loc : e.lib_loc_map )
+      if( ! is_writable(loc.first) || ! is_writable(loc.second) )
+        return false;
+    for( auto const & spec : e.spec_trans_map )
+      if( ! is_writable(spec.first) )
+        return false;
+    return true;
+  }
+
+  // Replace filepath by records, atomically.
+  void
+    write_records( std::string const & filepath, records_t const & records )
+  {
+    static std::atomic<unsigned> serial { 0u };
+    std::string const tmp = filepath + ".tmp."
+                          + std::to_string(::getpid()) + '.'
+                          + std::to_string(serial++);
+    {
+      std::ofstream out(tmp.c_str());
+      out << file_header << '\n';
+      for( auto const & r : records )
+        out << "K\t" << r.first << '\n' << r.second << "E\n";
+      out.close();
+      if( ! out ) {
+        std::remove(tmp.c_str());
+        return;
+      }
+    }
+    if( std::rename(tmp.c_str(), filepath.c_str()) != 0 )
+      std::remove(tmp.c_str());
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+void
+  library_index::set_cache_file( std::string const & filepath )
+{
+  index_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.cache_file = filepath;
+}
+
+std::string
+  library_index::cache_file( )
+{
+  index_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  return s.cache_file;
+}
+
+void
+  library_index::clear( )
+{
+  index_state & s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.indices.clear();
+  s.memory_hits = s.file_hits = s.scans = s.stale = 0u;
+}
+
+auto
+  library_index::stats( )
+  -> statistics
+{
+  index_state const & s = state();
+  return { s.memory_hits, s.file_hits, s.scans, s.stale };
+}
+
+// ----------------------------------------------------------------------
+
+auto
+  library_index::get( search_path const & path
+                    , std::string const & lib_type
+                    , std::string const & pattern
+                    , std::function<void (entry &)> const & scan
+                    )
+  -> entry_ptr
+{
+  index_state & s = state();
+  std::string const key = path.to_string() + '\t' + lib_type + '\t' + pattern;
+  stamp_t const now = stamp(path);
+  bool stale = false;
+  std::string filepath;
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.indices.find(key);
+    if( it != s.indices.end() ) {
+      if( it->second.stamp == now ) {
+        ++s.memory_hits;
+        return it->second.index;
+      }
+      stale = true;
+      s.indices.erase(it);
+    }
+    filepath = s.cache_file;
+  }
+
+  records_t records;
+  if( ! filepath.empty() )
+    records = read_records(filepath);
+  for( auto const & r : records ) {
+    if( r.first != key )
+      continue;
+    stamp_t recorded;
+    std::shared_ptr<entry> e = std::make_shared<entry>();
+    if( parse_record(r.second, recorded, *e) && recorded == now ) {
+      fill_good_specs(*e);
+      ++s.file_hits;
+      std::lock_guard<std::mutex> lock(s.mutex);
+      s.indices[key] = stamped_index{ now, e };
+      return e;
+    }
+    stale = true;
+  }
+
+  std::time_t const scan_start = std::time(nullptr);
+  std::shared_ptr<entry> e = std::make_shared<entry>();
+  scan(*e);
+  fill_good_specs(*e);
+  ++s.scans;
+  if( stale )
+    ++s.stale;
+  if( is_racy(now, scan_start) )
+    return e;
+
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.indices[key] = stamped_index{ now, e };
+  }
+  if( ! filepath.empty() && is_writable(path, *e)
+      && is_writable(lib_type) && is_writable(pattern) ) {
+    records_t merged;
+    for( auto & r : records )
+      if( r.first != key )
+        merged.push_back(std::move(r));
+    merged.emplace_back(key, format_record(path, now, *e));
+    write_records(filepath, merged);
+  }
+  return e;
+}  // get()
+
+// ======================================================================
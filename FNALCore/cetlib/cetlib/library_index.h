@@ -0,0 +1,83 @@
+#ifndef CETLIB_LIBRARY_INDEX_H
+#define CETLIB_LIBRARY_INDEX_H
+
+// ======================================================================
+//
+// library_index: Process-wide, thread-safe index of the libraries that
+//                cet::LibraryManager finds in a search path, shared by
+//                all LibraryManagers for the same search path, library
+//                type and pattern, and optionally kept in an on-disk
+//                cache file for reuse by later processes
+//
+// An index is reused only while every directory of the search path has
+// the modification time it had when the index was made; adding,
+// removing or renaming a library changes its directory's time. Indices
+// of directories modified within a couple of seconds of their scan are
+// not reused, as a later change might not change the recorded time.
+//
+// The cache file is named by CET_LIBRARY_INDEX in the environment, or
+// by set_cache_file(); by default there is none. It is replaced
+// atomically, so processes may share it; a file that can't be read or
+// written is ignored.
+//
+// ======================================================================
+
+#include "cetlib/search_path.h"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace cet {
+  class library_index;
+}
+
+// ----------------------------------------------------------------------
+
+class cet::library_index
+{
+public:
+  struct entry
+  {
+    // Library filename -> full path.
+    std::map<std::string, std::string>             lib_loc_map;
+    // Libspec -> full paths.
+    std::map<std::string, std::set<std::string> >  spec_trans_map;
+    // Libspec -> full path, for the libspecs with exactly one.
+    std::map<std::string, std::string>             good_spec_trans_map;
+  };
+  typedef  std::shared_ptr<entry const>  entry_ptr;
+
+  struct statistics
+  {
+    std::size_t memory_hits;  // Served from this process's indices.
+    std::size_t file_hits;    // Served from the cache file.
+    std::size_t scans;        // Made by scanning the search path.
+    std::size_t stale;        // Of the scans, indices found outdated.
+  };
+
+  library_index( ) = delete;
+
+  // control:
+  static void         set_cache_file( std::string const & filepath );  // "" for none
+  static std::string  cache_file    ( );
+  static void         clear         ( );  // Also resets the statistics.
+  static statistics   stats         ( );
+
+  // The index of the libraries of lib_type matching pattern in path,
+  // made by scan (which fills in lib_loc_map and spec_trans_map) if no
+  // valid index exists.
+  static entry_ptr
+    get( search_path const & path
+       , std::string const & lib_type
+       , std::string const & pattern
+       , std::function<void (entry &)> const & scan
+       );
+
+};  // library_index
+
+// ======================================================================
+
+#endif
@@ -7,11 +7,21 @@
 //
 // Integer subscripting is unsupported and yields a compilation failure.
 //
+// Lookups compare keys only, by a branch-free binary search. Inserting
+// many elements one by one with operator[] costs O(n) each; assign()
+// and merge() instead sort their input once.
+//
+// See also cetlib/soa_map_vector.h, which keeps the keys apart from the
+// values, for large value types.
+//
 // ======================================================================
 
 #include "cetlib/exception.h"
 #include "cpp0x/algorithm"
+#include <cstddef>
 #include <iosfwd>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 namespace cet  {
@@ -27,6 +37,20 @@ namespace cet  {
   std::ostream &  operator << ( std::ostream &, map_vector_key const & );
 
   template< class Value >  class map_vector;
+
+  namespace detail {
+    // The first of the n elements from first whose key (as given by
+    // key_of) is not less than key, found without data-dependent
+    // branches.
+    template< class RandIter, class KeyOf >
+      RandIter  map_vector_lower_bound( RandIter first, std::size_t n
+                                      , unsigned key, KeyOf key_of );
+
+    // The elements of [b, e) sorted by key, keeping only the first of
+    // those with equal keys.
+    template< class T, class InIter >
+      std::vector<T>  map_vector_sorted( InIter b, InIter e );
+  }
 }
 
 // ======================================================================
@@ -168,9 +192,22 @@ public:
 
   void  push_back( value_type const & x );
 
+  // Append the elements of [b, e), adding delta() to their keys.
   template< class InIter >
     void  insert( InIter b, InIter e );
 
+  // Replace the contents by the elements of [b, e), at their own keys;
+  // of elements with equal keys, the first is kept. O(n log n), or O(n)
+  // if [b, e) is sorted.
+  template< class InIter >
+    void  assign( InIter b, InIter e );
+
+  // Add the elements of [b, e) at their own keys; keys already present,
+  // or repeated, keep their first value, as with operator[].
+  // O(m log m + n) for m new elements.
+  template< class InIter >
+    void  merge( InIter b, InIter e );
+
   // MUST UPDATE WHEN CLASS IS CHANGED!
   static short  Class_Version() { return 10; }
 
@@ -181,6 +218,11 @@ private:
 
   static  bool  lt ( value_type const &, value_type const & );
 
+  static  unsigned  key_of( value_type const & v )  { return v.first.asInt(); }
+
+  iterator        lower_bound( key_type key );
+  const_iterator  lower_bound( key_type key ) const;
+
 };  // map_vector<>
 
 // ======================================================================
@@ -251,8 +293,7 @@ bool
   cet::map_vector<Value>::
   has( key_type key ) const
 {
-  value_type  v(key, mapped_type());
-  return std::binary_search(v_.begin(), v_.end(), v, lt );
+  return find(key) != v_.end();
 }
 
 template< class Value >
@@ -260,14 +301,9 @@ typename cet::map_vector<Value>::iterator
   cet::map_vector<Value>::
   find( key_type key )
 {
-  value_type  v(key, mapped_type());
-
-  iterator const begin = v_.begin()
-               , end   = v_.end();
-
-  iterator  it = std::lower_bound(begin, end, v, lt);
-  if( it != end  &&  it->first != key )
-    it = end;
+  iterator  it = lower_bound(key);
+  if( it != v_.end()  &&  it->first != key )
+    it = v_.end();
 
   return it;
 }
@@ -277,14 +313,9 @@ typename cet::map_vector<Value>::const_iterator
   cet::map_vector<Value>::
   find( key_type key ) const
 {
-  value_type  v(key, mapped_type());
-
-  const_iterator const begin = v_.begin()
-                     , end   = v_.end();
-
-  const_iterator  it = std::lower_bound(begin, end, v, lt);
-  if( it != end  &&  it->first != key )
-    it = end;
+  const_iterator  it = lower_bound(key);
+  if( it != v_.end()  &&  it->first != key )
+    it = v_.end();
 
   return it;
 }
@@ -340,14 +371,9 @@ Value &
   cet::map_vector<Value>::
   operator [] ( key_type key )
 {
-  value_type  v(key, mapped_type());
-
-  iterator const begin = v_.begin()
-               , end   = v_.end();
-
-  iterator  it = std::lower_bound(begin, end, v, lt);
-  if( it == end  ||  it->first != key )
-    it = v_.insert(it, v);
+  iterator  it = lower_bound(key);
+  if( it == v_.end()  ||  it->first != key )
+    it = v_.insert(it, value_type(key, mapped_type()));
 
   return it->second;
 }
@@ -378,6 +404,49 @@ void
   }
 }
 
+template< class Value >
+template< class InIter >
+void
+  cet::map_vector<Value>::
+  assign( InIter b, InIter e )
+{
+  v_ = detail::map_vector_sorted<value_type>(b, e);
+}
+
+template< class Value >
+template< class InIter >
+void
+  cet::map_vector<Value>::
+  merge( InIter b, InIter e )
+{
+  impl_type  added = detail::map_vector_sorted<value_type>(b, e);
+  if( added.empty() )
+    return;
+  if( v_.empty()  ||  v_.back().first < added.front().first ) {
+    v_.insert( v_.end()
+             , std::make_move_iterator(added.begin())
+             , std::make_move_iterator(added.end()) );
+    return;
+  }
+
+  impl_type  result;
+  result.reserve(v_.size() + added.size());
+  iterator        i1 = v_.begin(),   e1 = v_.end();
+  iterator        i2 = added.begin(), e2 = added.end();
+  while( i1 != e1  &&  i2 != e2 ) {
+    if( i2->first < i1->first )
+      result.push_back(std::move(*i2++));
+    else {
+      if( i2->first == i1->first )
+        ++i2;
+      result.push_back(std::move(*i1++));
+    }
+  }
+  result.insert(result.end(), std::make_move_iterator(i1), std::make_move_iterator(e1));
+  result.insert(result.end(), std::make_move_iterator(i2), std::make_move_iterator(e2));
+  v_.swap(result);
+}
+
 // ----------------------------------------------------------------------
 // helpers:
 
@@ -389,6 +458,78 @@ bool
   return std::is_sorted(v_.begin(), v_.end(), lt );
 }
 
+template< class Value >
+typename cet::map_vector<Value>::iterator
+  cet::map_vector<Value>::
+  lower_bound( key_type key )
+{
+  return detail::map_vector_lower_bound(v_.begin(), v_.size(), key.asInt(), key_of);
+}
+
+template< class Value >
+typename cet::map_vector<Value>::const_iterator
+  cet::map_vector<Value>::
+  lower_bound( key_type key ) const
+{
+  return detail::map_vector_lower_bound(v_.begin(), v_.size(), key.asInt(), key_of);
+}
+
+// ======================================================================
+// detail:
+
+template< class RandIter, class KeyOf >
+RandIter
+  cet::detail::map_vector_lower_bound( RandIter first, std::size_t n
+                                     , unsigned key, KeyOf key_of )
+{
+  if( n == 0 )
+    return first;
+  // Halve the range each step, by a conditional move rather than a
+  // branch; the answer stays within [first, first + n]. Both elements
+  // the next step might read are fetched meanwhile.
+  while( n > 1 ) {
+    std::size_t const half = n / 2;
+#if defined(__GNUC__)
+    __builtin_prefetch(&*(first + half / 2));
+    __builtin_prefetch(&*(first + half + half / 2));
+#endif
+    first = key_of(first[half]) < key ? first + half : first;
+    n -= half;
+  }
+  return first + (key_of(*first) < key);
+}
+
+template< class T, class InIter >
+std::vector<T>
+  cet::detail::map_vector_sorted( InIter b, InIter e )
+{
+  std::vector<T>  v;
+  for(  ;  b != e;  ++b ) {
+    b->first.ensure_valid();
+    v.emplace_back(b->first, b->second);
+  }
+  auto const  lt = []( T const & v1, T const & v2 ) { return v1.first < v2.first; };
+  if( std::is_sorted(v.begin(), v.end(), lt) ) {
+    auto const  eq = []( T const & v1, T const & v2 ) { return v1.first == v2.first; };
+    v.erase(std::unique(v.begin(), v.end(), eq), v.end());
+    return v;
+  }
+
+  // Sort (key, position) pairs rather than the elements themselves, so
+  // that each value is moved once; the position keeps the sort stable.
+  std::vector<std::pair<unsigned, std::size_t> >  order;
+  order.reserve(v.size());
+  for( std::size_t i = 0;  i != v.size();  ++i )
+    order.emplace_back(v[i].first.asInt(), i);
+  std::sort(order.begin(), order.end());
+  std::vector<T>  result;
+  result.reserve(v.size());
+  for( std::size_t i = 0;  i != order.size();  ++i )
+    if( i == 0  ||  order[i].first != order[i - 1].first )
+      result.push_back(std::move(v[order[i].second]));
+  return result;
+}
+
 // ======================================================================
 
 template< class Value >
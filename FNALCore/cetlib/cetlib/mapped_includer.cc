@@ -0,0 +1,420 @@
+// ======================================================================
+//
+// mapped_includer: A variant of cet::includer for very large inputs.
+//
+// ======================================================================
+
+#include "cetlib/mapped_includer.h"
+
+#include "cetlib/coded_exception.h"
+#include "cetlib/file_cache.h"
+#include "cetlib/trim.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using cet::mapped_includer;
+
+constexpr std::size_t mapped_includer::default_contiguous_limit;
+
+// ----------------------------------------------------------------------
+
+namespace { namespace detail {
+
+  enum error { cant_open
+             , cant_read
+             , malformed
+             , recursive
+             };
+
+  std::string
+    translate( error code )
+  {
+    switch( code ) {
+      case cant_open  : return "Can't locate or can't open specified file:";
+      case cant_read  : return "Can't read from supplied input stream:";
+      case malformed  : return "Malformed #include directive:";
+      case recursive  : return "Recursive #include directive:";
+      default         : return "Unknown code";
+    }
+  }  // translate()
+
+  typedef  cet::coded_exception<error,translate>
+           inc_exception;
+
+  std::string
+    begin_string( ) { return "<begin>"; }
+  std::string
+    end_string( ) { return "<end>"; }
+
+  char const newline[] = "\n";
+
+} }  // ::detail
+
+using namespace ::detail;
+
+// ----------------------------------------------------------------------
+// buffer: one file's contents, either mapped or shared with file_cache
+
+class mapped_includer::buffer
+{
+public:
+  buffer( )
+    : addr( nullptr ), len( 0u ), shared( )
+  { }
+
+  // Map filepath; false if it can't be mapped (e.g. not a regular file).
+  bool
+    map( std::string const & filepath )
+  {
+    int const fd = ::open(filepath.c_str(), O_RDONLY);
+    if( fd < 0 )
+      return false;
+    struct stat st;
+    bool ok = ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+    if( ok && st.st_size > 0 ) {
+      void * const a = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if( a == MAP_FAILED )
+        ok = false;
+      else {
+        addr = a;
+        len = st.st_size;
+        ::madvise(addr, len, MADV_SEQUENTIAL);
+      }
+    }
+    ::close(fd);
+    return ok;
+  }
+
+  void
+    share( cet::file_cache::contents_ptr contents )
+  { shared = std::move(contents); }
+
+  char const *
+    begin( ) const
+  { return shared ? shared->data() : static_cast<char const *>(addr); }
+
+  char const *
+    end( ) const
+  { return shared ? shared->data() + shared->size() : begin() + len; }
+
+  ~buffer( )
+  {
+    if( addr != nullptr )
+      ::munmap(addr, len);
+  }
+
+private:
+  void *                         addr;
+  std::size_t                    len;
+  cet::file_cache::contents_ptr  shared;
+};  // buffer
+
+// ----------------------------------------------------------------------
+
+mapped_includer::mapped_includer( std::string const   & filename
+                                , cet::filepath_maker & abs_filename
+                                , std::size_t           contiguous_limit
+                                , bool                  record_digests
+                                )
+  :
+  buffers ( ),
+  segments( ),
+  text    ( ),
+  size_   ( 0u ),
+  frames { frame(0, begin_string(), 0, 0u) },
+  recursion_stack ( ),
+  graph_ ( ),
+  digests_ ( record_digests )
+{
+  include(0, filename, abs_filename, include_graph::no_parent);
+  frames.emplace_back(0, end_string(), 0, size_);
+  if( segments.size() > 1u && size_ < contiguous_limit )
+    make_contiguous();
+}
+
+mapped_includer::~mapped_includer( )
+{ }
+
+// ----------------------------------------------------------------------
+
+auto
+  mapped_includer::begin( ) const
+  -> const_iterator
+{
+  return segments.empty()
+       ? end()
+       : const_iterator(segments, 0u, segments.front().begin, size_);
+}
+
+auto
+  mapped_includer::end( ) const
+  -> const_iterator
+{
+  return const_iterator(segments, segments.size(), nullptr, size_);
+}
+
+char const *
+  mapped_includer::data( ) const
+{
+  return segments.empty() ? newline : segments.front().begin;
+}
+
+auto
+  mapped_includer::at( std::size_t textpos ) const
+  -> const_iterator
+{
+  if( textpos >= size_ )
+    return end();
+  auto it = std::upper_bound( segments.begin(), segments.end(), textpos
+                            , [](std::size_t pos, segment const & s)
+                              { return pos < s.textpos; }
+                            );
+  std::size_t const seg = (it - segments.begin()) - 1u;
+  return const_iterator( segments, seg
+                       , segments[seg].begin + (textpos - segments[seg].textpos)
+                       , size_
+                       );
+}
+
+// ----------------------------------------------------------------------
+
+void
+  mapped_includer::append( char const * b, char const * e )
+{
+  if( b == e )
+    return;
+  segments.push_back(segment{ b, e, size_ });
+  size_ += e - b;
+}
+
+void
+  mapped_includer::make_contiguous( )
+{
+  text.reserve(size_);
+  for( auto const & s : segments )
+    text.append(s.begin, s.end);
+  segments.assign(1u, segment{ text.data(), text.data() + text.size(), 0u });
+  buffers.clear();
+}
+
+// ----------------------------------------------------------------------
+
+auto
+  mapped_includer::get_posinfo( std::size_t textpos ) const
+  -> posinfo
+{
+  // locate the frame corresponding to the given position:
+  uint framenum;
+  for( framenum = 1u; framenum != frames.size(); ++framenum )
+    if( textpos < frames[framenum].starting_textpos )
+      break;
+  frame const & this_frame = frames[--framenum];
+
+  // determine the line number within the corresponding file:
+  uint linenum = this_frame.starting_linenum
+               + std::count( at(this_frame.starting_textpos)
+                           , at(textpos)
+                           , '\n'
+                           );
+
+  // determine the character position within the corresponding line:
+  std::size_t line_start = 0u;
+  if( textpos != 0u ) {
+    std::size_t seg = at(textpos - 1u).seg_;
+    char const * p = segments[seg].begin + (textpos - segments[seg].textpos);
+    for( ; ; p = segments[--seg].end ) {
+      segment const & s = segments[seg];
+      char const * nl = p;
+      while( nl != s.begin && nl[-1] != '\n' )
+        --nl;
+      if( nl != s.begin ) {
+        line_start = s.textpos + (nl - s.begin);
+        break;
+      }
+      if( seg == 0u )
+        break;
+    }
+  }
+  uint charpos = textpos - line_start + 1u;
+  return { static_cast<uint>(textpos), linenum, charpos, framenum };
+}
+
+std::string
+  mapped_includer::whereis_( std::size_t textpos, bool highlighted ) const
+{
+  posinfo pos(get_posinfo(textpos));
+  // prepare the current information:
+  std::ostringstream result;
+  result << "line "        << pos.linenum
+         << ", character " << pos.charpos
+         << ", of file \"" << frames[pos.framenum].filename << '\"'
+         << backtrace( frames[pos.framenum].including_framenum );
+  if( ! highlighted )
+    return result.str();
+
+  result << "\n\n";
+  auto cp0 = pos.charpos - 1;
+  for( const_iterator it = at(pos.textpos - cp0), e = end()
+     ; it != e && *it != '\n'; ++it )
+    result << *it;
+  result << "\n";
+  result << std::string(cp0, ' ') << "^";
+
+  return result.str();
+}
+
+std::string
+  mapped_includer::whereis( const_iterator const & it ) const
+{ return whereis_(it.textpos(), false); }
+
+std::string
+  mapped_includer::highlighted_whereis( const_iterator const & it ) const
+{ return whereis_(it.textpos(), true); }
+
+std::string
+  mapped_includer::whereis( char const * it ) const
+{ return whereis_(it - data(), false); }
+
+std::string
+  mapped_includer::highlighted_whereis( char const * it ) const
+{ return whereis_(it - data(), true); }
+
+// ----------------------------------------------------------------------
+
+void
+  mapped_includer::include( int                   including_framenum
+                          , std::string const   & filename
+                          , cet::filepath_maker & abs_filename
+                          , std::size_t           including_node
+                          )
+{
+  static  std::string const  inc_lit = std::string("#include");
+  static  uint        const  min_sz  = inc_lit.size() + 3u;
+
+  // expand filename to obtain, per policy, absolute path to file:
+  bool const use_cin = filename == "-";
+  std::string const filepath = use_cin ? filename
+                                       : abs_filename(filename);
+
+  // check for recursive #inclusion:
+  if (std::find(recursion_stack.crbegin(),
+                recursion_stack.crend(),
+                filepath) != recursion_stack.crend()) {
+    throw inc_exception(recursive)
+      << filename << " => " << filepath
+      << backtrace( frames.size()-1u );
+  } else {
+    // Record opening of file.
+    recursion_stack.emplace_back(filepath);
+  }
+
+  // map (or otherwise obtain) the #included file:
+  std::unique_ptr<buffer> buf(new buffer);
+  bool ok = true;
+  if( use_cin ) {
+    ok = static_cast<bool>(std::cin);
+    if( ok )
+      buf->share( std::make_shared<std::string const>
+                  ( std::istreambuf_iterator<char>(std::cin)
+                  , std::istreambuf_iterator<char>()
+                  ) );
+  }
+  else if( cet::file_cache::enabled() || ! buf->map(filepath) ) {
+    cet::file_cache::contents_ptr contents = cet::file_cache::read(filepath);
+    ok = static_cast<bool>(contents);
+    buf->share(std::move(contents));
+  }
+  if( ! ok )
+    throw inc_exception(cant_open)
+       << filename << " => " << filepath
+       << backtrace( frames.size()-1u );
+  char const * const b = buf->begin();
+  char const * const e = buf->end();
+  buffers.push_back(std::move(buf));
+  std::size_t const node
+    = digests_ ? graph_.add(filepath, including_node, include_graph::digest_of(b, e))
+               : graph_.add(filepath, including_node);
+
+  int linenum = 1;
+  frame new_frame( including_framenum, filepath, linenum, size_ );
+
+  // iterate over each line of the input file, deferring the copy of
+  // each run of ordinary lines to a single segment:
+  char const * run = b;
+  std::string line;
+  for( char const * pos = b, * eol; pos < e; pos = eol + 1, ++linenum ) {
+    eol = std::find(pos, e, '\n');
+    if( std::size_t(eol - pos) < inc_lit.size()
+     || std::memcmp(pos, inc_lit.data(), inc_lit.size()) != 0 ) {
+      if( eol == e ) {  // last line has no newline; supply one
+        append(run, e);
+        append(newline, newline + 1);
+        run = e;
+      }
+      continue;  // ordinary line (not an #include)
+    }
+    append(run, pos);
+    run = eol == e ? e : eol + 1;
+
+    // save buffered text:
+    frames.push_back(new_frame);
+
+    // record this #include's place:
+    new_frame.starting_linenum = linenum;
+    new_frame.starting_textpos = size_;
+    frames.push_back(new_frame);
+
+    // validate the rest of the #include line's syntax:
+    line.assign(pos, eol);
+    trim_right(line, " \t\r\n");
+    if(  line.size() <= min_sz                      // too short?
+      || line[8] != ' '                             // missing separator?
+      || line[9] != '\"' || line.end()[-1] != '\"'  // missing either quote?
+      )
+      throw inc_exception(malformed) << line
+         << "\n at line " << linenum << " of file " << filepath;
+
+    // process the #include:
+    std::string nextfilename( line.substr( min_sz - 1u
+                                         , line.size() - min_sz
+                            )            );
+    include(frames.size()-1u, nextfilename, abs_filename, node);
+
+    // prepare to resume where we left off:
+    new_frame.starting_linenum = linenum + 1;
+    new_frame.starting_textpos = size_;
+  }  // for
+  append(run, e);
+
+  // save final buffered text:
+  frames.push_back(new_frame);
+
+  // Done with this file.
+  recursion_stack.pop_back();
+
+}  // include()
+
+// ----------------------------------------------------------------------
+
+std::string
+  mapped_includer::backtrace( uint from_frame ) const
+{
+  std::ostringstream result;
+  // append the backtrace:
+  for( uint k = from_frame; k != 0u; k = frames[k].including_framenum ) {
+    result << "\nincluded from line " << frames[k].starting_linenum
+           << " of file \"" << frames[k].filename << '\"';
+   }
+
+  return result.str();
+
+}  // backtrace()
+
+// ======================================================================
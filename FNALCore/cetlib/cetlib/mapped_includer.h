@@ -0,0 +1,199 @@
+#ifndef CETLIB_MAPPED_INCLUDER_H
+#define CETLIB_MAPPED_INCLUDER_H
+
+// ======================================================================
+//
+// mapped_includer: A variant of cet::includer for very large inputs.
+//
+// Each file is memory-mapped (or shared with cet::file_cache when that
+// is enabled) and the fully-included text is presented as a sequence
+// of segments referring into those buffers, so no copy of the text is
+// made. If the total size is below contiguous_limit, the segments are
+// instead copied into one contiguous buffer (data()) and the mappings
+// released, which keeps the cheapest iteration for ordinary inputs.
+//
+// The included text, the frames and the diagnostics of whereis() and
+// highlighted_whereis() are identical to those of cet::includer, as is
+// the include graph, whose digests are computed if record_digests is
+// set.
+//
+// ======================================================================
+
+#include "cetlib/filepath_maker.h"
+#include "cetlib/include_graph.h"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cet {
+  class mapped_includer;
+}
+
+// ----------------------------------------------------------------------
+
+class cet::mapped_includer
+{
+  typedef  std::string::size_type  uint;
+
+  struct segment
+  {
+    char const *  begin;
+    char const *  end;
+    std::size_t   textpos;  // Position of begin in the included text.
+  };
+
+public:
+  class const_iterator;
+
+  static constexpr std::size_t default_contiguous_limit = 16u << 20;
+
+  explicit        mapped_includer( std::string const   & filename
+                                 , cet::filepath_maker & abs_filename
+                                 , std::size_t contiguous_limit
+                                     = default_contiguous_limit
+                                 , bool record_digests = false
+                                 );
+  mapped_includer( mapped_includer const & ) = delete;
+  mapped_includer & operator = ( mapped_includer const & ) = delete;
+  ~mapped_includer( );
+
+  const_iterator  begin   ( ) const;
+  const_iterator  end     ( ) const;
+  std::size_t     size    ( ) const  { return size_; }
+
+  // True if the text is held in one buffer, data() .. data()+size().
+  bool            is_contiguous( ) const  { return segments.size() <= 1u; }
+  char const *    data    ( ) const;
+
+  std::string     whereis ( const_iterator const & it ) const;
+  std::string     highlighted_whereis( const_iterator const & it ) const;
+  std::string     whereis ( char const * it ) const;
+  std::string     highlighted_whereis( char const * it ) const;
+
+  cet::include_graph const &
+                  graph   ( ) const  { return graph_; }
+
+private:
+
+  struct frame
+  {
+    uint         including_framenum;
+    std::string  filename;
+    uint         starting_linenum;
+    size_t       starting_textpos;
+
+    frame( uint framenum, std::string filename, uint linenum, size_t textpos )
+      : including_framenum( framenum )
+      , filename          ( filename )
+      , starting_linenum  ( linenum )
+      , starting_textpos  ( textpos )
+    { }
+  };
+
+  struct posinfo
+  {
+    uint textpos; // Character position in fully-included text.
+    uint linenum; // Line number (1-based for user info).
+    uint charpos; // Character position in line (1-based for user info).
+    uint framenum; // Inclusion level.
+  };
+
+  class buffer;
+
+  std::vector<std::unique_ptr<buffer>>  buffers;
+  std::vector<segment>      segments;
+  std::string               text;  // Only when contiguous.
+  std::size_t               size_;
+  std::vector<frame>        frames;
+  std::vector<std::string>  recursion_stack;
+  cet::include_graph        graph_;
+  bool                      digests_;
+
+  void  include ( int                   including_framenum
+                , std::string const   & filename
+                , cet::filepath_maker & abs_filename
+                , std::size_t           including_node
+                );
+  void  append  ( char const * b, char const * e );
+  void  make_contiguous( );
+
+  const_iterator  at( std::size_t textpos ) const;
+  std::string  backtrace( uint from_frame ) const;
+  std::string  whereis_( std::size_t textpos, bool highlighted ) const;
+
+  posinfo get_posinfo ( std::size_t textpos ) const;
+
+};  // mapped_includer
+
+// ----------------------------------------------------------------------
+
+class cet::mapped_includer::const_iterator
+{
+public:
+  typedef  std::forward_iterator_tag  iterator_category;
+  typedef  char                       value_type;
+  typedef  std::ptrdiff_t             difference_type;
+  typedef  char const *               pointer;
+  typedef  char const &               reference;
+
+  const_iterator( )
+    : segs_( nullptr ), seg_( 0u ), p_( nullptr ), total_( 0u )
+  { }
+
+  reference  operator *  ( ) const  { return *p_; }
+  pointer    operator -> ( ) const  { return p_; }
+
+  const_iterator &
+    operator ++ ( )
+  {
+    if( ++p_ == (*segs_)[seg_].end )
+      next_segment_();
+    return *this;
+  }
+
+  const_iterator
+    operator ++ ( int )
+  { const_iterator result(*this); ++*this; return result; }
+
+  bool  operator == ( const_iterator const & other ) const
+  { return p_ == other.p_ && seg_ == other.seg_; }
+  bool  operator != ( const_iterator const & other ) const
+  { return ! operator==(other); }
+
+  // Position in the fully-included text.
+  std::size_t
+    textpos( ) const
+  {
+    return seg_ == segs_->size() ? total_
+                                 : (*segs_)[seg_].textpos + (p_ - (*segs_)[seg_].begin);
+  }
+
+private:
+  friend class mapped_includer;
+
+  const_iterator( std::vector<segment> const & segs
+                , std::size_t seg, char const * p, std::size_t total )
+    : segs_( &segs ), seg_( seg ), p_( p ), total_( total )
+  { }
+
+  void
+    next_segment_( )
+  {
+    if( ++seg_ == segs_->size() )
+      p_ = nullptr;
+    else
+      p_ = (*segs_)[seg_].begin;
+  }
+
+  std::vector<segment> const * segs_;
+  std::size_t                  seg_;
+  char const *                 p_;
+  std::size_t                  total_;
+
+};  // const_iterator
+
+// ======================================================================
+
+#endif
@@ -7,6 +7,7 @@
 //
 // ======================================================================
 
+#include "cetlib/detail/update_range.h"
 #include "cpp0x/array"
 #include "polarssl/md5.h"
 #include <cstring>
@@ -35,25 +36,30 @@ public:
     reset( ) { polarssl::md5_starts( & context ); }
 
   md5 &
-    operator << ( std::string const & mesg )
+    update( void const * mesg, std::size_t size )
   {
     polarssl::md5_update( & context
-                        , (uchar const *)( & mesg[0] )
-                        , mesg.size()
+                        , static_cast<uchar const *>( mesg )
+                        , size
                         );
     return *this;
   }
-
+  template< class InputIt >
   md5 &
-    operator << ( char const mesg )
+    update( InputIt first, InputIt last )
   {
-    polarssl::md5_update( & context
-                        , (uchar const *)( & mesg )
-                        , 1u
-                        );
+    detail::update_range(*this, first, last);
     return *this;
   }
 
+  md5 &
+    operator << ( std::string const & mesg )
+  { return update( mesg.data(), mesg.size() ); }
+
+  md5 &
+    operator << ( char const mesg )
+  { return update( & mesg, 1u ); }
+
   digest_t
     digest( )
   {
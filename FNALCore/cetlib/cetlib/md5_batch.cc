@@ -0,0 +1,244 @@
+// ======================================================================
+//
+// md5_batch: MD5 digests of many independent messages at once
+//
+// Implementations:
+//
+// - avx512, avx2: 16 or 8 messages at a time, each in a 32-bit lane of
+//   every vector (detail/multibuffer.h). The steps are those of RFC
+//   1321, written once with GCC vector types and compiled for each
+//   instruction set by function attributes.
+// - serial: cet::md5, one message after another.
+//
+// ======================================================================
+
+#include "cetlib/md5_batch.h"
+
+#include "cetlib/detail/implementation_choice.h"
+#include "cetlib/detail/multibuffer.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CET_MD5_BATCH_X86 1
+#include <cpuid.h>
+#endif
+
+using cet::md5;
+using cet::md5_batch;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  typedef  void  batch_t( void const * const * data
+                        , std::size_t const * sizes
+                        , std::size_t n
+                        , md5_batch::digest_t * out );
+
+  void
+    serial( void const * const * data, std::size_t const * sizes
+          , std::size_t n, md5_batch::digest_t * out )
+  {
+    for( std::size_t i = 0; i != n; ++i )
+      out[i] = md5().update(data[i], sizes[i]).digest();
+  }
+
+#ifdef CET_MD5_BATCH_X86
+
+  struct md5_traits
+  {
+    static unsigned const       words = 4u;
+    static bool const           big_endian = false;
+    static std::uint32_t const  iv[4];
+  };
+  std::uint32_t const  md5_traits::iv[4]
+    = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476 };
+
+  std::uint32_t const  K[64] =
+    {
+      0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE,
+      0xF57C0FAF, 0x4787C62A, 0xA8304613, 0xFD469501,
+      0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE,
+      0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821,
+      0xF61E2562, 0xC040B340, 0x265E5A51, 0xE9B6C7AA,
+      0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+      0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED,
+      0xA9E3E905, 0xFCEFA3F8, 0x676F02D9, 0x8D2A4C8A,
+      0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C,
+      0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70,
+      0x289B7EC6, 0xEAA127FA, 0xD4EF3085, 0x04881D05,
+      0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+      0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039,
+      0x655B59C3, 0x8F0CCC92, 0xFFEFF47D, 0x85845DD1,
+      0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1,
+      0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391
+    };
+
+  int const  S[4][4] =
+    { { 7, 12, 17, 22 }, { 5, 9, 14, 20 }, { 4, 11, 16, 23 }, { 6, 10, 15, 21 } };
+
+  typedef  std::uint32_t  v8u  __attribute__((vector_size(32)));
+  typedef  std::uint32_t  v16u __attribute__((vector_size(64)));
+
+  // One block for each of the sizeof(V)/4 lanes.
+  template< class V >
+  __attribute__((always_inline)) inline void
+    md5_lanes( std::uint32_t * state, unsigned char const * const * blocks )
+  {
+    unsigned const N = sizeof(V) / 4u;
+
+    std::uint32_t wt[16][N];
+    for( unsigned i = 0; i != N; ++i )
+      for( unsigned t = 0; t != 16u; ++t )
+        std::memcpy(&wt[t][i], blocks[i] + 4u * t, 4u);
+    V w[16];
+    for( unsigned t = 0; t != 16u; ++t )
+      std::memcpy(&w[t], wt[t], sizeof(V));
+
+    V s[4];
+    for( unsigned k = 0; k != 4u; ++k )
+      std::memcpy(&s[k], state + k * N, sizeof(V));
+    V a = s[0], b = s[1], c = s[2], d = s[3];
+
+#define CET_MD5_STEPS(round, f, g)                                       \
+    for( unsigned i = 16u * round; i != 16u * round + 16u; ++i ) {      \
+      V const x = a + (f) + K[i] + w[(g) & 15];                         \
+      int const n = S[round][i & 3];                                    \
+      a = d;  d = c;  c = b;  b += (x << n) | (x >> (32 - n));          \
+    }
+
+    CET_MD5_STEPS(0, d ^ (b & (c ^ d)), i        )
+    CET_MD5_STEPS(1, c ^ (d & (b ^ c)), 5 * i + 1)
+    CET_MD5_STEPS(2, b ^ c ^ d,         3 * i + 5)
+    CET_MD5_STEPS(3, c ^ (b | ~d),      7 * i    )
+#undef CET_MD5_STEPS
+
+    s[0] += a;  s[1] += b;  s[2] += c;  s[3] += d;
+    for( unsigned k = 0; k != 4u; ++k )
+      std::memcpy(state + k * N, &s[k], sizeof(V));
+  }
+
+  __attribute__((target("avx2")))
+  void
+    avx2_lanes( std::uint32_t * state, unsigned char const * const * blocks )
+  { md5_lanes<v8u>(state, blocks); }
+
+  __attribute__((target("avx512f")))
+  void
+    avx512_lanes( std::uint32_t * state, unsigned char const * const * blocks )
+  { md5_lanes<v16u>(state, blocks); }
+
+  void
+    avx2( void const * const * data, std::size_t const * sizes
+        , std::size_t n, md5_batch::digest_t * out )
+  { cet::detail::multibuffer_digest<8u, md5_traits>(avx2_lanes, data, sizes, n, out); }
+
+  void
+    avx512( void const * const * data, std::size_t const * sizes
+          , std::size_t n, md5_batch::digest_t * out )
+  { cet::detail::multibuffer_digest<16u, md5_traits>(avx512_lanes, data, sizes, n, out); }
+
+  struct cpu_features
+  {
+    bool avx2, avx512;
+
+    cpu_features( ) : avx2(false), avx512(false)
+    {
+      unsigned a, b, c, d;
+      if( ! __get_cpuid(1, &a, &b, &c, &d) || ! (c & bit_OSXSAVE) )
+        return;
+      // The OS must save the ymm, and for AVX-512 the zmm, registers.
+      unsigned lo, hi;
+      __asm__( "xgetbv" : "=a"(lo), "=d"(hi) : "c"(0) );
+      if( __get_cpuid_max(0, 0) < 7 )
+        return;
+      __cpuid_count(7, 0, a, b, c, d);
+      avx2   = (lo & 0x06u) == 0x06u && (b & bit_AVX2);
+      avx512 = (lo & 0xE6u) == 0xE6u && (b & bit_AVX512F);
+    }
+  };
+
+#endif  // CET_MD5_BATCH_X86
+
+  typedef  cet::detail::implementation_choice<batch_t>  choice_t;
+
+  // Supported by this CPU, best first.
+  std::vector<choice_t::entry>
+    supported( )
+  {
+    std::vector<choice_t::entry> result;
+#ifdef CET_MD5_BATCH_X86
+    static cpu_features const cpu;
+    if( cpu.avx512 ) result.push_back(choice_t::entry{"avx512", avx512});
+    if( cpu.avx2 )   result.push_back(choice_t::entry{"avx2",   avx2});
+#endif
+    result.push_back(choice_t::entry{"serial", serial});
+    return result;
+  }
+
+  choice_t &
+    choice( )
+  {
+    static choice_t c(supported(), "CET_MD5_BATCH_IMPLEMENTATION");
+    return c;
+  }
+
+  // Fewest messages worth a thread of their own.
+  std::size_t const  min_per_thread = 256u;
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+void
+  md5_batch::digest( void const * const * data, std::size_t const * sizes
+                    , std::size_t n, digest_t * out, unsigned threads )
+{
+  batch_t * const batch = choice().get();
+  detail::for_each_slice(n, threads, min_per_thread,
+    [=]( std::size_t first, std::size_t last ) {
+      batch(data + first, sizes + first, last - first, out + first);
+    });
+}
+
+void
+  md5_batch::digest( std::string const * mesgs, std::size_t n
+                    , digest_t * out, unsigned threads )
+{
+  std::vector<void const *> data(n);
+  std::vector<std::size_t>  sizes(n);
+  for( std::size_t i = 0; i != n; ++i ) {
+    data[i]  = mesgs[i].data();
+    sizes[i] = mesgs[i].size();
+  }
+  digest(data.data(), sizes.data(), n, out, threads);
+}
+
+std::vector<md5_batch::digest_t>
+  md5_batch::digest( std::vector<std::string> const & mesgs, unsigned threads )
+{
+  std::vector<digest_t> result(mesgs.size());
+  digest(mesgs.data(), mesgs.size(), result.data(), threads);
+  return result;
+}
+
+// ----------------------------------------------------------------------
+
+std::vector<std::string>
+  md5_batch::implementations( )
+{
+  return choice().names();
+}
+
+std::string
+  md5_batch::implementation( )
+{
+  return choice().name();
+}
+
+bool
+  md5_batch::use_implementation( std::string const & name )
+{
+  return choice().use(name);
+}
+
+// ======================================================================
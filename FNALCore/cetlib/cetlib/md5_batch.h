@@ -0,0 +1,56 @@
+#ifndef CETLIB_MD5_BATCH_H
+#define CETLIB_MD5_BATCH_H
+
+// ======================================================================
+//
+// md5_batch: MD5 digests of many independent messages at once
+//
+// The messages are hashed several at a time in the lanes of a SIMD
+// kernel (16 with AVX-512, 8 with AVX2), or, without either, one after
+// another with cet::md5; optionally, the batch is also split across
+// threads. The digests are those cet::md5 gives.
+// CET_MD5_BATCH_IMPLEMENTATION, if set in the environment, names the
+// implementation to use.
+//
+// ======================================================================
+
+#include "cetlib/md5.h"
+#include <string>
+#include <vector>
+
+namespace cet {
+  class md5_batch;
+}
+
+// ======================================================================
+
+class cet::md5_batch
+{
+public:
+  typedef  md5::digest_t  digest_t;
+
+  // out[i] = the digest of the size[i] bytes at data[i], for i < n.
+  static  void
+    digest( void const * const * data, std::size_t const * sizes
+          , std::size_t n, digest_t * out, unsigned threads = 1u );
+
+  // out[i] = the digest of mesgs[i], for i < n.
+  static  void
+    digest( std::string const * mesgs, std::size_t n
+          , digest_t * out, unsigned threads = 1u );
+
+  static  std::vector<digest_t>
+    digest( std::vector<std::string> const & mesgs, unsigned threads = 1u );
+
+  // Names of the implementations this CPU supports, best first, and of
+  // the one in use. use_implementation() switches the whole process to
+  // another; it fails if the CPU doesn't support it.
+  static  std::vector<std::string>  implementations( );
+  static  std::string               implementation( );
+  static  bool                      use_implementation( std::string const & name );
+
+};  // md5_batch
+
+// ======================================================================
+
+#endif
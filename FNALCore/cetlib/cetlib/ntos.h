@@ -5,11 +5,16 @@
 //
 // ntos: produce string from number
 //
+// Integers are written in decimal, floating-point numbers as
+// std::to_string() writes them (%f), but always with a '.' whatever the
+// locale. The conversions themselves are those of cetlib/charconv.h.
+//
 // ======================================================================
 
-#include "boost/lexical_cast.hpp"
+#include "cetlib/charconv.h"
 #include "cpp0x/string"
 #include "cpp0x/type_traits"
+#include <limits>
 
 // ======================================================================
 
@@ -32,44 +37,77 @@ namespace cet {
   std::string  ntos( float       );
   std::string  ntos( double      );
   std::string  ntos( long double );
+
+  namespace detail {
+    template< class T >
+      std::string  ntos_integer( T );
+    template< class T >
+      std::string  ntos_fixed( T );
+  }
 }
 
 // ======================================================================
 
+template< class T >
+inline std::string
+  cet::detail::ntos_integer( T n )
+{
+  char buf[std::numeric_limits<T>::digits10 + 3];
+  return std::string(buf, to_chars(buf, buf + sizeof buf, n).ptr);
+}
+
+template< class T >
+inline std::string
+  cet::detail::ntos_fixed( T n )
+{
+  char buf[64];
+  to_chars_result const r = to_chars(buf, buf + sizeof buf, n, chars_format::fixed, 6);
+  if( r.ec == std::errc() )
+    return std::string(buf, r.ptr);
+
+  // Large magnitudes: all the integer digits are written.
+  std::string result(std::numeric_limits<T>::max_exponent10 + 16, '\0');
+  char * const first = &result[0];
+  result.resize(to_chars(first, first + result.size(), n, chars_format::fixed, 6).ptr - first);
+  return result;
+}
+
+// ----------------------------------------------------------------------
+
 template< class T >
 inline typename std::enable_if<    std::is_integral<T>::value
                                 && (sizeof(T) > sizeof(long long))
                               , std::string
                               >::type
   cet::ntos( T n )
-{ return boost::lexical_cast<std::string>(n); }
+{ return detail::ntos_integer(n); }
 
 // ----------------------------------------------------------------------
 
 inline std::string
-  cet::ntos( int       n ) { return std::to_string(n); }
+  cet::ntos( int       n ) { return detail::ntos_integer(n); }
 inline std::string
-  cet::ntos( long      n ) { return std::to_string(n); }
+  cet::ntos( long      n ) { return detail::ntos_integer(n); }
 inline std::string
-  cet::ntos( long long n ) { return std::to_string(n); }
+  cet::ntos( long long n ) { return detail::ntos_integer(n); }
 
 // ----------------------------------------------------------------------
 
 inline std::string
-  cet::ntos( unsigned int       n ) { return std::to_string(n); }
+  cet::ntos( unsigned int       n ) { return detail::ntos_integer(n); }
 inline std::string
-  cet::ntos( unsigned long      n ) { return std::to_string(n); }
+  cet::ntos( unsigned long      n ) { return detail::ntos_integer(n); }
 inline std::string
-  cet::ntos( unsigned long long n ) { return std::to_string(n); }
+  cet::ntos( unsigned long long n ) { return detail::ntos_integer(n); }
 
 // ----------------------------------------------------------------------
 
 inline std::string
-  cet::ntos( float       n ) { return std::to_string(n); }
+  cet::ntos( float       n ) { return detail::ntos_fixed(n); }
 inline std::string
-  cet::ntos( double      n ) { return std::to_string(n); }
+  cet::ntos( double      n ) { return detail::ntos_fixed(n); }
 inline std::string
-  cet::ntos( long double n ) { return std::to_string(n); }
+  cet::ntos( long double n ) { return detail::ntos_fixed(n); }
 
 // ======================================================================
 
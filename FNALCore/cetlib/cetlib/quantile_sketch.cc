@@ -0,0 +1,185 @@
+// ======================================================================
+//
+// quantile_sketch: estimate quantiles of individually-presented data in
+//                  bounded memory
+//
+// ======================================================================
+
+#include "cetlib/quantile_sketch.h"
+
+#include "cetlib/exception.h"
+#include "cpp0x/algorithm"  // max, min
+#include "cpp0x/cmath"      // abs, ceil, exp, isinf, isnan, log
+#include <limits>           // numeric_limits
+
+using cet::quantile_sketch;
+
+// ----------------------------------------------------------------------
+// c'tors:
+
+quantile_sketch::quantile_sketch( double relative_accuracy
+                                , std::size_t max_buckets )
+: accuracy_   ( relative_accuracy )
+, gamma_      ( (1.0 + relative_accuracy) / (1.0 - relative_accuracy) )
+, log_gamma_  ( std::log(gamma_) )
+, max_buckets_( max_buckets )
+, n_          ( 0u )
+, min_        ( + std::numeric_limits<double>::infinity() )
+, max_        ( - std::numeric_limits<double>::infinity() )
+, zeros_      ( 0u )
+, pos_inf_    ( 0u )
+, neg_inf_    ( 0u )
+, positive_   ( )
+, negative_   ( )
+{
+  if( ! (relative_accuracy > 0.0  &&  relative_accuracy < 1.0) )
+    throw cet::exception("quantile_sketch")
+      << "Relative accuracy " << relative_accuracy
+      << " is not between 0 and 1.\n";
+  if( max_buckets == 0u )
+    throw cet::exception("quantile_sketch")
+      << "At least one bucket is required.\n";
+}
+
+// ----------------------------------------------------------------------
+// observers:
+
+std::size_t
+  quantile_sketch::bucket_count( ) const noexcept
+{
+  return positive_.counts.size() + negative_.counts.size();
+}
+
+double
+  quantile_sketch::quantile( double q ) const noexcept
+{
+  if( n_ == 0u  ||  ! (q >= 0.0  &&  q <= 1.0) )
+    return std::numeric_limits<double>::quiet_NaN();
+  if( q == 0.0 )
+    return min_;
+  if( q == 1.0 )
+    return max_;
+
+  // The bucket values are accurate to a; only the extremes are known
+  // exactly.
+  auto const  clamp = [this]( double x ) { return std::min(std::max(x, min_), max_); };
+  double const   rank = q * double(n_ - 1u);
+  std::uint64_t  seen = neg_inf_;
+  if( double(seen) > rank )
+    return min_;
+
+  for( std::size_t i = negative_.counts.size();  i-- != 0u;  ) {
+    seen += negative_.counts[i];
+    if( double(seen) > rank )
+      return clamp(- value_of(negative_.offset + int(i)));
+  }
+  seen += zeros_;
+  if( double(seen) > rank )
+    return clamp(0.0);
+  for( std::size_t i = 0u;  i != positive_.counts.size();  ++i ) {
+    seen += positive_.counts[i];
+    if( double(seen) > rank )
+      return clamp(value_of(positive_.offset + int(i)));
+  }
+  return max_;  // +inf
+}
+
+// ----------------------------------------------------------------------
+// mutators:
+
+void
+  quantile_sketch::reset( )
+{
+  *this = quantile_sketch(accuracy_, max_buckets_);
+}
+
+void
+  quantile_sketch::sample( double x )
+{
+  if( std::isnan(x) )
+    return;
+
+  ++n_;
+  min_ = std::min(x, min_);
+  max_ = std::max(x, max_);
+
+  double const  magnitude = std::abs(x);
+  if( ! (magnitude >= std::numeric_limits<double>::min()) )
+    ++zeros_;
+  else if( std::isinf(x) )
+    ++(x > 0.0 ? pos_inf_ : neg_inf_);
+  else if( x > 0.0 )
+    positive_.add(index_of(magnitude), 1u, max_buckets_);
+  else
+    negative_.add(index_of(magnitude), 1u, max_buckets_);
+}
+
+void
+  quantile_sketch::merge( quantile_sketch const & other )
+{
+  if( std::abs(other.accuracy_ - accuracy_) > 1e-12 * accuracy_ )
+    throw cet::exception("quantile_sketch")
+      << "Cannot merge a sketch of relative accuracy " << other.accuracy_
+      << " into one of " << accuracy_ << ".\n";
+
+  n_     += other.n_;
+  min_   = std::min(min_, other.min_);
+  max_   = std::max(max_, other.max_);
+  zeros_ += other.zeros_;
+  pos_inf_ += other.pos_inf_;
+  neg_inf_ += other.neg_inf_;
+  for( std::size_t i = 0u;  i != other.positive_.counts.size();  ++i )
+    if( other.positive_.counts[i] != 0u )
+      positive_.add(other.positive_.offset + int(i), other.positive_.counts[i], max_buckets_);
+  for( std::size_t i = 0u;  i != other.negative_.counts.size();  ++i )
+    if( other.negative_.counts[i] != 0u )
+      negative_.add(other.negative_.offset + int(i), other.negative_.counts[i], max_buckets_);
+}
+
+// ----------------------------------------------------------------------
+// helpers:
+
+// Bucket i holds the magnitudes in (gamma^(i-1), gamma^i].
+int
+  quantile_sketch::index_of( double magnitude ) const noexcept
+{
+  return int(std::ceil(std::log(magnitude) / log_gamma_));
+}
+
+// The value within a relative error a of all of bucket i.
+double
+  quantile_sketch::value_of( int index ) const noexcept
+{
+  return std::exp(index * log_gamma_) * (2.0 / (gamma_ + 1.0));
+}
+
+void
+  quantile_sketch::store::add( int index
+                             , std::uint64_t count
+                             , std::size_t max_buckets )
+{
+  if( counts.empty() ) {
+    counts.assign(1u, count);
+    offset = index;
+    return;
+  }
+
+  int const  top = offset + int(counts.size()) - 1;
+  int        lo  = std::min(offset, index);
+  int const  hi  = std::max(top, index);
+  // Fold the lowest buckets together rather than exceed max_buckets.
+  if( std::size_t(hi - lo) >= max_buckets )
+    lo = hi - int(max_buckets) + 1;
+  index = std::max(index, lo);
+
+  if( lo != offset  ||  hi != top ) {
+    std::vector<std::uint64_t>  grown(std::size_t(hi - lo + 1), 0u);
+    for( std::size_t i = 0u;  i != counts.size();  ++i )
+      grown[std::max(offset + int(i), lo) - lo] += counts[i];
+    counts.swap(grown);
+    offset = lo;
+  }
+  counts[index - offset] += count;
+}
+
+// ======================================================================
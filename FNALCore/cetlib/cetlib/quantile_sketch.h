@@ -0,0 +1,100 @@
+#ifndef CETLIB_QUANTILE_SKETCH_H
+#define CETLIB_QUANTILE_SKETCH_H
+
+// ======================================================================
+//
+// quantile_sketch: estimate quantiles of individually-presented data in
+//                  bounded memory
+//
+// Samples are counted in buckets whose bounds grow geometrically, by a
+// factor (1+a)/(1-a) for relative accuracy a, so that any quantile is
+// estimated to within a relative error a of a sample near that rank.
+// With a = 1%, timings from a nanosecond to hours need under 2000
+// buckets a sign. Beyond max_buckets (a sign), the buckets of the
+// values nearest zero are folded together, keeping the accuracy of the
+// upper quantiles, which matter for timing.
+//
+// Sketches of the same accuracy made separately (e.g. one per thread)
+// may be combined with merge(); unless buckets were folded, the result
+// is exactly that of sampling the data together.
+//
+// ======================================================================
+
+#include "cpp0x/cstddef"  // size_t
+#include "cpp0x/cstdint"  // uint64_t
+#include <vector>
+
+namespace cet {
+  class quantile_sketch;
+}
+
+// ======================================================================
+
+class cet::quantile_sketch
+{
+public:
+  // c'tors:
+  explicit
+    quantile_sketch( double relative_accuracy = 0.01
+                   , std::size_t max_buckets = 2048u );
+
+  // use compiler-generated copy/move/d'tor
+
+  // observers:
+  std::size_t  size             ( ) const noexcept  { return n_; }
+  double       max              ( ) const noexcept  { return max_; }
+  double       min              ( ) const noexcept  { return min_; }
+  double       relative_accuracy( ) const noexcept  { return accuracy_; }
+  std::size_t  bucket_count     ( ) const noexcept;
+
+  // The estimated q-quantile, 0 <= q <= 1 (e.g. 0.99 for p99): a value
+  // of rank q * (size() - 1) among the samples. NaN if there are none.
+  double  quantile( double q ) const noexcept;
+
+  // mutators:
+  void  reset( );
+  // NaN is ignored; +/-inf is counted apart from the buckets.
+  void  sample( double x );
+  template< class Iter >
+  void
+    sample( Iter begin, Iter end )
+  {
+    for(  ; begin != end;  ++begin )
+      sample(*begin);
+  }
+  // Throws if other's relative accuracy differs.
+  void  merge( quantile_sketch const & other );
+
+private:
+  // The counts of the buckets offset, offset + 1, ... of |x| for one
+  // sign of x.
+  struct store
+  {
+    std::vector<std::uint64_t>  counts;
+    int                         offset;
+
+    store( ) : counts(), offset(0)  { }
+
+    void  add( int index, std::uint64_t count, std::size_t max_buckets );
+  };
+
+  int     index_of( double magnitude ) const noexcept;
+  double  value_of( int index ) const noexcept;
+
+  double         accuracy_;
+  double         gamma_;
+  double         log_gamma_;
+  std::size_t    max_buckets_;
+  std::size_t    n_;
+  double         min_, max_;
+  std::uint64_t  zeros_;       // |x| too small to index
+  std::uint64_t  pos_inf_;     // +inf, too large to index
+  std::uint64_t  neg_inf_;     // -inf
+  store          positive_;
+  store          negative_;
+
+};  // quantile_sketch
+
+// ======================================================================
+
+#endif  // CETLIB_QUANTILE_SKETCH_H
@@ -6,24 +6,154 @@
 
 #include "cetlib/search_path.h"
 
+#include "cetlib/detail/filename_matcher.h"
 #include "cetlib/exception.h"
+#include "cetlib/file_cache.h"
 #include "cetlib/filesystem.h"
 #include "cetlib/getenv.h"
-#include "cpp0x/regex"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 #include <dirent.h>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <sys/stat.h>
+#include <unordered_map>
+#include <utility>
 
 using cet::search_path;
 
 std::string exception_category("search_path");
 
+// ----------------------------------------------------------------------
+// directory listing cache:
+
+namespace {
+
+  typedef  std::chrono::steady_clock  clock_type;
+
+  struct dir_listing
+  {
+    // (name, d_type), in readdir order.
+    std::vector<std::pair<std::string, unsigned char> >  files;
+    std::unordered_map<std::string, unsigned char>        types;
+  };
+  typedef  std::shared_ptr<dir_listing const>  listing_ptr;
+
+  struct dir_stamp
+  {
+    long long mtime, ctime;  // -1 if the directory can't be stat'ed
+    long      mtime_ns, ctime_ns;
+
+    bool operator == ( dir_stamp const & other ) const
+    { return mtime == other.mtime && mtime_ns == other.mtime_ns
+          && ctime == other.ctime && ctime_ns == other.ctime_ns; }
+  };
+
+  struct listing_record
+  {
+    listing_ptr        contents;  // nullptr if the directory can't be read
+    dir_stamp          stamp;
+    bool               racy;      // Changed too near its reading to trust stamp.
+    clock_type::time_point checked;
+  };
+
+  struct listing_state
+  {
+    std::mutex mutex;
+    std::unordered_map<std::string, listing_record> records;
+    std::atomic<long long> ttl_ms { 1000 };
+  };
+
+  listing_state &
+    listings( )
+  {
+    static listing_state s;
+    return s;
+  }
+
+  dir_stamp
+    stamp_of( std::string const & dir )
+  {
+    struct stat st;
+    if( ::stat(dir.c_str(), &st) != 0 )
+      return dir_stamp{ -1, -1, 0, 0 };
+#ifdef __APPLE__
+    return dir_stamp{ st.st_mtime, st.st_ctime
+                    , st.st_mtimespec.tv_nsec, st.st_ctimespec.tv_nsec };
+#else
+    return dir_stamp{ st.st_mtime, st.st_ctime
+                    , st.st_mtim.tv_nsec, st.st_ctim.tv_nsec };
+#endif
+  }
+
+  listing_ptr
+    read_listing( std::string const & dir )
+  {
+    DIR * dd = opendir(dir.c_str());
+    if( dd == 0 )
+      return listing_ptr();
+    std::shared_ptr<dir_listing> result = std::make_shared<dir_listing>();
+    // readdir() is safe here: this stream is used by this thread alone.
+    int             err = 0;
+    struct dirent * next = 0;
+    while( errno = 0, (next = readdir(dd)) != 0 ) {
+      result->files.emplace_back(next->d_name, next->d_type);
+      result->types.emplace(next->d_name, next->d_type);
+    }
+    err = errno;
+    closedir(dd);
+    if( err != 0 )
+      throw cet::exception(exception_category)
+        << "Failed to read directory \"" << dir << "\"; error num = " << err;
+    return result;
+  }
+
+  // The listing of dir, read at most once per change to it.
+  listing_ptr
+    listing_of( std::string const & dir )
+  {
+    listing_state & s = listings();
+    clock_type::time_point const now = clock_type::now();
+    std::chrono::milliseconds const ttl(s.ttl_ms.load());
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      auto it = s.records.find(dir);
+      if( it != s.records.end() && now - it->second.checked < ttl )
+        return it->second.contents;
+    }
+
+    dir_stamp const stamp = stamp_of(dir);
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      auto it = s.records.find(dir);
+      if( it != s.records.end() && ! it->second.racy
+          && it->second.stamp == stamp ) {
+        it->second.checked = now;
+        return it->second.contents;
+      }
+    }
+
+    std::time_t const read_start = std::time(nullptr);
+    listing_ptr const contents = read_listing(dir);
+    bool const racy = stamp.mtime >= (long long)read_start - 1
+                   || stamp.ctime >= (long long)read_start - 1;
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.records[dir] = listing_record{ contents, stamp, racy, now };
+    return contents;
+  }
+
+}  // namespace
+
 // ----------------------------------------------------------------------
 // c'tor:
 
-search_path::search_path( std::string const & arg )
+search_path::search_path( std::string const & arg, listing mode )
 : dirs( )
 , end ( )
+, mode( mode )
 {
   if( ! arg.empty() )
     split( arg.find(':') == std::string::npos
@@ -73,21 +203,48 @@ bool
   if( filename.empty() )
     return false;
 
-  for( std::vector<std::string>::const_iterator it = dirs.begin()
-     ; it != end; ++it ) {
-    std::string fullpath = *it + '/' + filename;
-    for( std::size_t k;  (k = fullpath.find("//")) != std::string::npos;  ) {
-      fullpath.erase(k,1);
-    }
-    if( cet::file_exists(fullpath) )  {
-      result = fullpath;
-      return true;
+  auto probe = [this, &filename]( std::string & found ) {
+    for( std::vector<std::string>::const_iterator it = dirs.begin()
+       ; it != end; ++it ) {
+      std::string fullpath = *it + '/' + filename;
+      for( std::size_t k;  (k = fullpath.find("//")) != std::string::npos;  ) {
+        fullpath.erase(k,1);
+      }
+      if( mode == cached_listing ? listed(fullpath) : cet::file_exists(fullpath) )  {
+        found = fullpath;
+        return true;
+      }
     }
-  }
+    return false;
+  };
 
-  return false;
+  return cet::file_cache::enabled()
+         ? cet::file_cache::find_file(to_string(), filename, result, probe)
+         : probe(result);
 }  // find_file()
 
+// Whether fullpath exists, according to the listing of its directory.
+bool
+  search_path::listed( std::string const & fullpath )
+{
+  std::size_t const slash = fullpath.rfind('/');
+  std::string const base = fullpath.substr(slash + 1u);
+  if( slash == std::string::npos || base.empty() || base == "." || base == ".." )
+    return cet::file_exists(fullpath);
+
+  listing_ptr const contents
+    = listing_of(slash == 0u ? std::string("/") : fullpath.substr(0u, slash));
+  if( ! contents )  // Perhaps searchable but not readable.
+    return cet::file_exists(fullpath);
+  auto it = contents->types.find(base);
+  if( it == contents->types.end() )
+    return false;
+  // A symbolic link exists only if its target does.
+  return it->second == DT_LNK || it->second == DT_UNKNOWN
+         ? cet::file_exists(fullpath)
+         : true;
+}  // listed()
+
 // ----------------------------------------------------------------------
 
 std::size_t
@@ -95,11 +252,25 @@ std::size_t
                          , std::vector<std::string> & out
                          ) const
 {
-  std::regex re(pat);
+  std::shared_ptr<detail::filename_matcher const> const
+    matches = detail::filename_matcher::get(pat);
+
+  if( mode == cached_listing ) {
+    std::size_t count = 0u;
+    for( std::vector<std::string>::const_iterator it = dirs.begin()
+       ; it != end; ++it ) {
+      listing_ptr const contents = listing_of(*it);
+      if( ! contents )
+        continue;
+      for( auto const & file : contents->files )
+        if( (*matches)(file.first) )
+          out.push_back(*it + '/' + file.first), ++count;
+    }
+    return count;
+  }
 
   std::size_t     count = 0u;
-  std::size_t     err = 0u;
-  struct dirent   entry;
+  int             err = 0;
   struct dirent * result = 0;
 
   for( std::vector<std::string>::const_iterator it = dirs.begin()
@@ -107,13 +278,13 @@ std::size_t
     DIR * dd = opendir(it->c_str());
     if( dd == 0 )
       continue;
-    while( ! (err = readdir_r(dd, &entry, &result))
-           && result != 0 ) {
-      if( std::regex_match(entry.d_name, re) )
-        out.push_back(*it + '/' + entry.d_name), ++count;
+    while( errno = 0, (result = readdir(dd)) != 0 ) {
+      if( (*matches)(result->d_name, std::strlen(result->d_name)) )
+        out.push_back(*it + '/' + result->d_name), ++count;
     }
+    err = errno;
     closedir(dd);
-    if( result != 0 )
+    if( err != 0 )
       throw cet::exception(exception_category)
         << "Failed to read directory \"" << *it << "\"; error num = " << err;
   }  // for
@@ -121,4 +292,27 @@ std::size_t
   return count;
 }  // find_files()
 
+// ----------------------------------------------------------------------
+// directory listing cache control:
+
+void
+  search_path::set_listing_ttl( std::chrono::milliseconds ttl )
+{
+  listings().ttl_ms = ttl.count();
+}
+
+std::chrono::milliseconds
+  search_path::listing_ttl( )
+{
+  return std::chrono::milliseconds(listings().ttl_ms.load());
+}
+
+void
+  search_path::clear_listings( )
+{
+  listing_state & s = listings();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.records.clear();
+}
+
 // ======================================================================
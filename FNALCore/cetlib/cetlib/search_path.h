@@ -5,10 +5,18 @@
 //
 // search_path: Seek filename or pattern in a given list of pathnames
 //
+// A search_path made with cached_listing reads each directory once per
+// process, sharing the listing with every other such search_path, and
+// answers find_file() and find_files() from it. A listing is reused
+// without touching the filesystem for listing_ttl() after it was last
+// checked, then revalidated against its directory's modification time;
+// clear_listings() forgets them all.
+//
 // ======================================================================
 
 #include "cetlib/split.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -22,8 +30,12 @@ namespace cet {
 class cet::search_path
 {
 public:
+  enum listing { uncached_listing, cached_listing };
+
   //c'tor:
-  search_path( std::string const & name_or_path );
+  search_path( std::string const & name_or_path
+             , listing             mode = uncached_listing
+             );
 
   // observers:
   bool
@@ -50,9 +62,21 @@ public:
               , OutIter             dest
               ) const;
 
+  // directory listing cache control:
+  static void
+    set_listing_ttl( std::chrono::milliseconds ttl );  // 0 to always revalidate
+  static std::chrono::milliseconds
+    listing_ttl( );
+  static void
+    clear_listings( );
+
 private:
   std::vector<std::string>                 dirs;
   std::vector<std::string>::const_iterator end;
+  listing                                  mode;
+
+  static bool
+    listed( std::string const & fullpath );
 
 };  // search_path
 
@@ -0,0 +1,367 @@
+// ======================================================================
+//
+// sha1: Secure Hash Algorithm as defined in FIPS PUB 180-1, 1993-05-11
+//
+// Each implementation compresses whole 64-byte blocks into the state;
+// the buffering and padding common to them are done here.
+//
+// - portable: polarssl's sha1_process().
+// - ssse3: the message schedule computed four words at a time, after
+//   "Improving the Performance of the Secure Hash Algorithm (SHA-1)",
+//   Intel, 2010; the rounds are scalar.
+// - avx2: as ssse3, with the schedules of two blocks computed together.
+// - shani: the SHA extensions' sha1rnds4/sha1nexte/sha1msg1/sha1msg2.
+//
+// The x86 implementations are compiled for their instruction sets by
+// function attributes, so that the library as a whole still runs on any
+// x86 CPU.
+//
+// ======================================================================
+
+#include "cetlib/sha1.h"
+
+#include "cetlib/detail/implementation_choice.h"
+#include "polarssl/sha1.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CET_SHA1_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using cet::sha1;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  typedef  void  blocks_t( std::uint32_t state[5]
+                         , unsigned char const * data
+                         , std::size_t nblocks );
+
+  void
+    portable_blocks( std::uint32_t state[5], unsigned char const * data, std::size_t n )
+  {
+    polarssl::sha1_context ctx;
+    for( int i = 0; i != 5; ++i )
+      ctx.state[i] = state[i];
+    for( ; n != 0; --n, data += 64 )
+      polarssl::sha1_process(&ctx, data);
+    for( int i = 0; i != 5; ++i )
+      state[i] = std::uint32_t(ctx.state[i]);
+  }
+
+#ifdef CET_SHA1_X86
+
+  inline std::uint32_t
+    rol( std::uint32_t x, int n )
+  { return (x << n) | (x >> (32 - n)); }
+
+  // The 80 rounds, given W[t] + K[t].
+  inline void
+    rounds( std::uint32_t state[5], std::uint32_t const wk[80] )
+  {
+    std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+#define CET_SHA1_ROUND(f, t) \
+    { std::uint32_t const tmp = rol(a, 5) + (f) + e + wk[t]; \
+      e = d; d = c; c = rol(b, 30); b = a; a = tmp; }
+    for( int t =  0; t != 20; ++t ) CET_SHA1_ROUND(d ^ (b & (c ^ d)), t)
+    for( int t = 20; t != 40; ++t ) CET_SHA1_ROUND(b ^ c ^ d, t)
+    for( int t = 40; t != 60; ++t ) CET_SHA1_ROUND((b & c) | (d & (b | c)), t)
+    for( int t = 60; t != 80; ++t ) CET_SHA1_ROUND(b ^ c ^ d, t)
+#undef CET_SHA1_ROUND
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e;
+  }
+
+  std::uint32_t const K[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+  // Message schedules, four words W[4i..4i+3] per vector: words 16-31
+  // from W[t] = rol1(W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]), the lane of
+  // W[t+3], which depends on W[t], being fixed up afterwards; words
+  // 32-79 from the equivalent W[t] = rol2(W[t-6] ^ W[t-16] ^ W[t-28] ^
+  // W[t-32]), which has no dependency within a vector.
+#define CET_SHA1_SCHEDULE(V, load, bswap, xor_, or_, slli32, srli32, \
+                          slli128, srli128, alignr, add, set1)       \
+  for( int i = 0; i != 4; ++i )                                      \
+    w[i] = bswap(load(i));                                           \
+  for( int i = 4; i != 8; ++i ) {                                    \
+    V const x = xor_( xor_( srli128(w[i-1], 4), w[i-2] )             \
+                    , xor_( alignr(w[i-3], w[i-4], 8), w[i-4] ) );   \
+    V const y = slli128(x, 12);                                      \
+    w[i] = xor_( or_(slli32(x, 1), srli32(x, 31))                    \
+               , or_(slli32(y, 2), srli32(y, 30)) );                 \
+  }                                                                  \
+  for( int i = 8; i != 20; ++i ) {                                   \
+    V const x = xor_( xor_( alignr(w[i-1], w[i-2], 8), w[i-4] )      \
+                    , xor_( w[i-7], w[i-8] ) );                      \
+    w[i] = or_(slli32(x, 2), srli32(x, 30));                         \
+  }                                                                  \
+  for( int i = 0; i != 20; ++i )                                     \
+    w[i] = add(w[i], set1(int(K[i / 5])));
+
+  __attribute__((target("ssse3")))
+  void
+    ssse3_blocks( std::uint32_t state[5], unsigned char const * data, std::size_t n )
+  {
+    __m128i const mask = _mm_set_epi8(12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3);
+    alignas(16) std::uint32_t wk[80];
+    for( ; n != 0; --n, data += 64 ) {
+      __m128i w[20];
+#define CET_LOAD(i) _mm_loadu_si128(reinterpret_cast<__m128i const *>(data) + (i))
+#define CET_BSWAP(v) _mm_shuffle_epi8(v, mask)
+      CET_SHA1_SCHEDULE(__m128i, CET_LOAD, CET_BSWAP, _mm_xor_si128, _mm_or_si128,
+                        _mm_slli_epi32, _mm_srli_epi32, _mm_slli_si128, _mm_srli_si128,
+                        _mm_alignr_epi8, _mm_add_epi32, _mm_set1_epi32)
+#undef CET_LOAD
+#undef CET_BSWAP
+      for( int i = 0; i != 20; ++i )
+        _mm_store_si128(reinterpret_cast<__m128i *>(wk) + i, w[i]);
+      rounds(state, wk);
+    }
+  }
+
+  __attribute__((target("avx2")))
+  void
+    avx2_blocks( std::uint32_t state[5], unsigned char const * data, std::size_t n )
+  {
+    __m256i const mask = _mm256_set_epi8(12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3,
+                                         12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3);
+    alignas(32) std::uint32_t wk[2][80];
+    for( ; n >= 2; n -= 2, data += 128 ) {
+      // The low lanes hold the first block, the high ones the second.
+      __m256i w[20];
+#define CET_LOAD(i) _mm256_inserti128_si256( \
+        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(data) + (i))), \
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + 64) + (i)), 1)
+#define CET_BSWAP(v) _mm256_shuffle_epi8(v, mask)
+      CET_SHA1_SCHEDULE(__m256i, CET_LOAD, CET_BSWAP, _mm256_xor_si256, _mm256_or_si256,
+                        _mm256_slli_epi32, _mm256_srli_epi32, _mm256_slli_si256, _mm256_srli_si256,
+                        _mm256_alignr_epi8, _mm256_add_epi32, _mm256_set1_epi32)
+#undef CET_LOAD
+#undef CET_BSWAP
+      for( int i = 0; i != 20; ++i ) {
+        _mm_store_si128(reinterpret_cast<__m128i *>(wk[0]) + i, _mm256_castsi256_si128(w[i]));
+        _mm_store_si128(reinterpret_cast<__m128i *>(wk[1]) + i, _mm256_extracti128_si256(w[i], 1));
+      }
+      rounds(state, wk[0]);
+      rounds(state, wk[1]);
+    }
+    if( n != 0 )
+      ssse3_blocks(state, data, n);
+  }
+
+#undef CET_SHA1_SCHEDULE
+
+  __attribute__((target("sha,sse4.1")))
+  void
+    shani_blocks( std::uint32_t state[5], unsigned char const * data, std::size_t n )
+  {
+    __m128i const mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(int(state[4]), 0, 0, 0);
+    __m128i e1;
+    __m128i m0, m1, m2, m3;
+
+    // Four rounds, of group g; e is the E of this group, f that of the
+    // next. Messages are expanded three groups ahead.
+#define CET_SHA1_GROUP(g, e, f, mg, mg1, mg2, mg3)      \
+    e = _mm_sha1nexte_epu32(e, mg);                     \
+    f = abcd;                                           \
+    if( (g) >= 3 && (g) <= 18 )                         \
+      mg1 = _mm_sha1msg2_epu32(mg1, mg);                \
+    abcd = _mm_sha1rnds4_epu32(abcd, e, (g) / 5);       \
+    if( (g) >= 1 && (g) <= 16 )                         \
+      mg3 = _mm_sha1msg1_epu32(mg3, mg);                \
+    if( (g) >= 2 && (g) <= 17 )                         \
+      mg2 = _mm_xor_si128(mg2, mg);
+
+    for( ; n != 0; --n, data += 64 ) {
+      __m128i const abcd_save = abcd;
+      __m128i const e0_save = e0;
+      __m128i const * const p = reinterpret_cast<__m128i const *>(data);
+
+      m0 = _mm_shuffle_epi8(_mm_loadu_si128(p + 0), mask);
+      e0 = _mm_add_epi32(e0, m0);
+      e1 = abcd;
+      abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+      m1 = _mm_shuffle_epi8(_mm_loadu_si128(p + 1), mask);
+      CET_SHA1_GROUP( 1, e1, e0, m1, m2, m3, m0)
+      m2 = _mm_shuffle_epi8(_mm_loadu_si128(p + 2), mask);
+      CET_SHA1_GROUP( 2, e0, e1, m2, m3, m0, m1)
+      m3 = _mm_shuffle_epi8(_mm_loadu_si128(p + 3), mask);
+      CET_SHA1_GROUP( 3, e1, e0, m3, m0, m1, m2)
+      CET_SHA1_GROUP( 4, e0, e1, m0, m1, m2, m3)
+      CET_SHA1_GROUP( 5, e1, e0, m1, m2, m3, m0)
+      CET_SHA1_GROUP( 6, e0, e1, m2, m3, m0, m1)
+      CET_SHA1_GROUP( 7, e1, e0, m3, m0, m1, m2)
+      CET_SHA1_GROUP( 8, e0, e1, m0, m1, m2, m3)
+      CET_SHA1_GROUP( 9, e1, e0, m1, m2, m3, m0)
+      CET_SHA1_GROUP(10, e0, e1, m2, m3, m0, m1)
+      CET_SHA1_GROUP(11, e1, e0, m3, m0, m1, m2)
+      CET_SHA1_GROUP(12, e0, e1, m0, m1, m2, m3)
+      CET_SHA1_GROUP(13, e1, e0, m1, m2, m3, m0)
+      CET_SHA1_GROUP(14, e0, e1, m2, m3, m0, m1)
+      CET_SHA1_GROUP(15, e1, e0, m3, m0, m1, m2)
+      CET_SHA1_GROUP(16, e0, e1, m0, m1, m2, m3)
+      CET_SHA1_GROUP(17, e1, e0, m1, m2, m3, m0)
+      CET_SHA1_GROUP(18, e0, e1, m2, m3, m0, m1)
+      CET_SHA1_GROUP(19, e1, e0, m3, m0, m1, m2)
+
+      e0 = _mm_sha1nexte_epu32(e0, e0_save);
+      abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+#undef CET_SHA1_GROUP
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = std::uint32_t(_mm_extract_epi32(e0, 3));
+  }
+
+  struct cpu_features
+  {
+    bool ssse3, avx2, sha;
+
+    cpu_features( ) : ssse3(false), avx2(false), sha(false)
+    {
+      unsigned a, b, c, d;
+      if( ! __get_cpuid(1, &a, &b, &c, &d) )
+        return;
+      ssse3 = c & bit_SSSE3;
+      bool const sse41 = c & bit_SSE4_1;
+      // AVX2 also needs the OS to save the ymm registers.
+      bool os_ymm = false;
+      if( c & bit_OSXSAVE ) {
+        unsigned lo, hi;
+        __asm__( "xgetbv" : "=a"(lo), "=d"(hi) : "c"(0) );
+        os_ymm = (lo & 6u) == 6u;
+      }
+      if( __get_cpuid_max(0, 0) < 7 )
+        return;
+      __cpuid_count(7, 0, a, b, c, d);
+      avx2 = os_ymm && (b & bit_AVX2);
+      sha  = ssse3 && sse41 && (b & bit_SHA);
+    }
+  };
+
+#endif  // CET_SHA1_X86
+
+  typedef  cet::detail::implementation_choice<blocks_t>  choice_t;
+
+  // Supported by this CPU, best first.
+  std::vector<choice_t::entry>
+    supported( )
+  {
+    std::vector<choice_t::entry> result;
+#ifdef CET_SHA1_X86
+    static cpu_features const cpu;
+    if( cpu.sha )   result.push_back(choice_t::entry{"shani", shani_blocks});
+    if( cpu.avx2 )  result.push_back(choice_t::entry{"avx2",  avx2_blocks});
+    if( cpu.ssse3 ) result.push_back(choice_t::entry{"ssse3", ssse3_blocks});
+#endif
+    result.push_back(choice_t::entry{"portable", portable_blocks});
+    return result;
+  }
+
+  choice_t &
+    choice( )
+  {
+    static choice_t c(supported(), "CET_SHA1_IMPLEMENTATION");
+    return c;
+  }
+
+  void
+    put_be( std::uint32_t n, unsigned char * b )
+  {
+    b[0] = (unsigned char)(n >> 24);
+    b[1] = (unsigned char)(n >> 16);
+    b[2] = (unsigned char)(n >>  8);
+    b[3] = (unsigned char)(n      );
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+void
+  sha1::reset( )
+{
+  state[0] = 0x67452301;
+  state[1] = 0xEFCDAB89;
+  state[2] = 0x98BADCFE;
+  state[3] = 0x10325476;
+  state[4] = 0xC3D2E1F0;
+  length = 0u;
+}
+
+sha1 &
+  sha1::update( void const * data, std::size_t size )
+{
+  if( size == 0u )
+    return *this;
+  uchar const * mesg = static_cast<uchar const *>(data);
+  blocks_t * const blocks = choice().get();
+
+  std::size_t const used = length % 64u;
+  length += size;
+  if( used != 0u ) {
+    std::size_t const fill = 64u - used;
+    if( size < fill ) {
+      std::memcpy(buffer + used, mesg, size);
+      return *this;
+    }
+    std::memcpy(buffer + used, mesg, fill);
+    blocks(state, buffer, 1u);
+    mesg += fill;
+    size -= fill;
+  }
+  if( size >= 64u ) {
+    blocks(state, mesg, size / 64u);
+    mesg += size & ~std::size_t(63);
+    size %= 64u;
+  }
+  std::memcpy(buffer, mesg, size);
+  return *this;
+}
+
+sha1::digest_t
+  sha1::digest( )
+{
+  static uchar const padding[64] = { 0x80 };
+  std::uint64_t const bits = length * 8u;
+  uchar msglen[8];
+  put_be(std::uint32_t(bits >> 32), msglen);
+  put_be(std::uint32_t(bits), msglen + 4);
+
+  std::size_t const used = length % 64u;
+  update(padding, used < 56u ? 56u - used : 120u - used);
+  update(msglen, 8u);
+
+  digest_t result;
+  for( int i = 0; i != 5; ++i )
+    put_be(state[i], & result[4 * i]);
+  std::memset(state, 0, sizeof state);
+  length = 0u;
+  return result;
+}
+
+// ----------------------------------------------------------------------
+
+std::vector<std::string>
+  sha1::implementations( )
+{
+  return choice().names();
+}
+
+std::string
+  sha1::implementation( )
+{
+  return choice().name();
+}
+
+bool
+  sha1::use_implementation( std::string const & name )
+{
+  return choice().use(name);
+}
+
+// ======================================================================
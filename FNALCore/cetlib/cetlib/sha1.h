@@ -5,12 +5,20 @@
 //
 // sha1: Secure Hash Algorithm as defined in FIPS PUB 180-1, 1993-05-11
 //
+// The compression function is chosen at run time: SHA-NI instructions
+// if the CPU has them, else a vectorized message schedule (AVX2 or
+// SSSE3), else the portable polarssl code. All give the same digests.
+// CET_SHA1_IMPLEMENTATION, if set in the environment, names the one to
+// use instead.
+//
 // ======================================================================
 
 #include "boost/array.hpp"
-#include "polarssl/sha1.h"
+#include "cetlib/detail/update_range.h"
+#include "cpp0x/cstdint"
 #include <cstring>
 #include <string>
+#include <vector>
 
 namespace cet {
   class sha1;
@@ -31,39 +39,40 @@ public:
   explicit
     sha1( char const mesg ) { reset(); operator<<(mesg); }
 
-  void  reset( ) { polarssl::sha1_starts( & context ); }
+  void  reset( );
 
   sha1 &
-    operator << ( std::string const & mesg )
+    update( void const * mesg, std::size_t size );
+  template< class InputIt >
+  sha1 &
+    update( InputIt first, InputIt last )
   {
-    polarssl::sha1_update( & context
-                         , (uchar const *)( & mesg[0] )
-                         , mesg.size()
-                         );
+    detail::update_range(*this, first, last);
     return *this;
   }
 
+  sha1 &
+    operator << ( std::string const & mesg )
+  { return update( mesg.data(), mesg.size() ); }
+
   sha1 &
     operator << ( char const mesg )
-  {
-    polarssl::sha1_update( & context
-                         , (uchar const *)( & mesg )
-                         , 1u
-                         );
-    return *this;
-  }
+  { return update( & mesg, 1u ); }
 
   digest_t
-    digest( )
-  {
-    digest_t result;
-    polarssl::sha1_finish( & context, & result[0] );
-    std::memset( & context, 0, sizeof(polarssl::sha1_context) );
-    return result;
-  }
+    digest( );
+
+  // Names of the implementations this CPU supports, best first, and of
+  // the one in use. use_implementation() switches the whole process to
+  // another; it fails if the CPU doesn't support it.
+  static  std::vector<std::string>  implementations( );
+  static  std::string               implementation( );
+  static  bool                      use_implementation( std::string const & name );
 
 private:
-  polarssl::sha1_context  context;
+  std::uint32_t  state[5];
+  std::uint64_t  length;       // bytes hashed so far
+  uchar          buffer[64];   // partial block
 
 };  // sha1
 
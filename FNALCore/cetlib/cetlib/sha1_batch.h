@@ -0,0 +1,56 @@
+#ifndef CETLIB_SHA1_BATCH_H
+#define CETLIB_SHA1_BATCH_H
+
+// ======================================================================
+//
+// sha1_batch: SHA-1 digests of many independent messages at once
+//
+// The messages are hashed several at a time in the lanes of a SIMD
+// kernel (16 with AVX-512, 8 with AVX2), or one after another with
+// cet::sha1 if that is faster on this CPU; optionally, the batch is
+// also split across threads. The digests are those cet::sha1 gives.
+// CET_SHA1_BATCH_IMPLEMENTATION, if set in the environment, names the
+// implementation to use.
+//
+// ======================================================================
+
+#include "cetlib/sha1.h"
+#include <string>
+#include <vector>
+
+namespace cet {
+  class sha1_batch;
+}
+
+// ======================================================================
+
+class cet::sha1_batch
+{
+public:
+  typedef  sha1::digest_t  digest_t;
+
+  // out[i] = the digest of the size[i] bytes at data[i], for i < n.
+  static  void
+    digest( void const * const * data, std::size_t const * sizes
+          , std::size_t n, digest_t * out, unsigned threads = 1u );
+
+  // out[i] = the digest of mesgs[i], for i < n.
+  static  void
+    digest( std::string const * mesgs, std::size_t n
+          , digest_t * out, unsigned threads = 1u );
+
+  static  std::vector<digest_t>
+    digest( std::vector<std::string> const & mesgs, unsigned threads = 1u );
+
+  // Names of the implementations this CPU supports, best first, and of
+  // the one in use. use_implementation() switches the whole process to
+  // another; it fails if the CPU doesn't support it.
+  static  std::vector<std::string>  implementations( );
+  static  std::string               implementation( );
+  static  bool                      use_implementation( std::string const & name );
+
+};  // sha1_batch
+
+// ======================================================================
+
+#endif
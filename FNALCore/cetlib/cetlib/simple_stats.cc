@@ -22,7 +22,8 @@ simple_stats::simple_stats( ) noexcept
 , max_   ( - std::numeric_limits<double>::infinity() )
 , small_ ( + std::numeric_limits<double>::infinity() )
 , sum_   ( 0.0 )
-, sumsq_ ( 0.0 )
+, mean_  ( 0.0 )
+, m2_    ( 0.0 )
 {
   ;
 }
@@ -33,11 +34,21 @@ simple_stats::simple_stats( double x ) noexcept
 , max_   ( - std::numeric_limits<double>::infinity() )
 , small_ ( + std::numeric_limits<double>::infinity() )
 , sum_   ( 0.0 )
-, sumsq_ ( 0.0 )
+, mean_  ( 0.0 )
+, m2_    ( 0.0 )
 {
   sample(x);
 }
 
+// ----------------------------------------------------------------------
+// statistics observers:
+
+double
+  simple_stats::sumsq( ) const noexcept
+{
+  return m2_ + double(n_) * square(mean_);
+}
+
 // ----------------------------------------------------------------------
 // statistics calculators:
 
@@ -45,7 +56,7 @@ double
   simple_stats::mean( ) const noexcept
 {
   return n_ == 0u  ?  std::numeric_limits<double>::quiet_NaN()
-                   :  sum_ / double(n_);
+                   :  mean_;
 }
 
 double
@@ -68,14 +79,7 @@ double
   if( n_ <= nparams )
     return std::numeric_limits<double>::quiet_NaN();
 
-  double  diff  = sumsq_ / double(n_)
-                - square(mean());
-  if( diff < 0.0 )
-    return 0.0;
-
-  double  factor  = double(n_)
-                  / double(n_-nparams);
-  return std::sqrt(factor * diff);
+  return std::sqrt(m2_ / double(n_-nparams));
 }
 
 double
@@ -84,13 +88,7 @@ double
   if( n_ <= nparams )
     return std::numeric_limits<double>::quiet_NaN();
 
-  double  diff  = sumsq_ / double(n_);
-  if( diff < 0.0 )
-    return 0.0;
-
-  double  factor  = double(n_)
-                  / double(n_-nparams);
-  return std::sqrt(factor * diff);
+  return std::sqrt(sumsq() / double(n_-nparams));
 }
 
 double
@@ -119,7 +117,35 @@ void
   max_   = std::max(x, max_);
   small_ = std::min( std::abs(x), small_);
   sum_   += x;
-  sumsq_ += square(x);
+
+  double const  delta  = x - mean_;
+  mean_  += delta / double(n_);
+  m2_    += delta * (x - mean_);
+}
+
+void
+  simple_stats::merge( simple_stats const & other ) noexcept
+{
+  if( other.n_ == 0u )
+    return;
+  if( n_ == 0u ) {
+    *this = other;
+    return;
+  }
+
+  // Chan, Golub and LeVeque's pairwise combination.
+  double const  n1     = double(n_);
+  double const  n2     = double(other.n_);
+  double const  n      = n1 + n2;
+  double const  delta  = other.mean_ - mean_;
+
+  n_     += other.n_;
+  min_   = std::min(min_, other.min_);
+  max_   = std::max(max_, other.max_);
+  small_ = std::min(small_, other.small_);
+  sum_   += other.sum_;
+  mean_  += delta * (n2 / n);
+  m2_    += other.m2_ + square(delta) * (n1 * n2 / n);
 }
 
 // ======================================================================
@@ -5,6 +5,14 @@
 //
 // simple_stats: yield simple statistics from individually-presented data
 //
+// The mean and the sum of squared deviations from it are accumulated by
+// Welford's method, which keeps the rms accurate for long series whose
+// spread is small beside their mean. Statistics gathered separately
+// (e.g. one per thread) may be combined with merge(), giving the same
+// results, to rounding, as gathering them together.
+//
+// For quantiles, see cetlib/quantile_sketch.h.
+//
 // ======================================================================
 
 #include "cpp0x/cstddef"  // size_t
@@ -39,7 +47,7 @@ public:
   double       min  ( ) const noexcept  { return min_; }
   double       small( ) const noexcept  { return small_; }
   double       sum  ( ) const noexcept  { return sum_; }
-  double       sumsq( ) const noexcept  { return sumsq_; }
+  double       sumsq( ) const noexcept;
 
   // statistics calculators:
   double       mean    ( ) const noexcept;
@@ -59,11 +67,13 @@ public:
     for(  ; begin != end;  ++begin )
       sample(*begin);
   }
+  void  merge( simple_stats const & other ) noexcept;
 
 private:
   std::size_t  n_;             // counter
   double  min_, max_, small_;  // extrema
-  double  sum_, sumsq_;        // accumulations
+  double  sum_;                // accumulation
+  double  mean_, m2_;          // mean, and sum of squared deviations
 
 };  // simple_stats
 
@@ -0,0 +1,291 @@
+#ifndef CETLIB_SOA_MAP_VECTOR_H
+#define CETLIB_SOA_MAP_VECTOR_H
+
+// ======================================================================
+//
+// soa_map_vector: A map_vector keeping its keys apart from its values
+//
+// The keys are held, sorted, in one vector and the values, in the same
+// order, in another. A lookup searches the keys alone, touching one
+// cache line per few levels of the search whatever the size of the
+// values, and then the one value found. Elements are addressed by
+// their position, from index(); there are no iterators over pairs.
+//
+// ======================================================================
+
+#include "cetlib/exception.h"
+#include "cetlib/map_vector.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cet  {
+  template< class Value >  class soa_map_vector;
+}
+
+// ======================================================================
+
+template< class Value >
+  class cet::soa_map_vector
+{
+public:
+  // types:
+  typedef  map_vector_key                        key_type;
+  typedef  Value                                 mapped_type;
+  typedef  std::pair<key_type,mapped_type>       value_type;
+  typedef  std::vector<key_type>                 key_container;
+  typedef  std::vector<mapped_type>              mapped_container;
+  typedef  typename mapped_container::size_type  size_type;
+
+  // c'tors:
+  soa_map_vector( ) : keys_(), values_()  { }
+
+  template< class InIter >
+    soa_map_vector( InIter b, InIter e ) : keys_(), values_()  { assign(b, e); }
+
+  explicit
+    soa_map_vector( map_vector<Value> const & m );
+
+  // use compiler-generated copy c'tor, copy assignment, and d'tor
+
+  // properties:
+  bool       empty( )    const  { return keys_.empty(); }
+  size_type  size( )     const  { return keys_.size();  }
+  size_type  capacity( ) const  { return keys_.capacity(); }
+
+  // observers:
+  key_container    const &  keys  ( ) const  { return keys_;   }
+  mapped_container const &  values( ) const  { return values_; }
+  mapped_container       &  values( )        { return values_; }
+
+  size_t  delta( ) const  { return keys_.empty() ? 0 : 1 + keys_.back().asInt(); }
+
+  // The position of key, or size() if it is absent.
+  size_type  index( key_type key ) const;
+
+  bool  has( key_type key ) const  { return index(key) != size(); }
+
+  mapped_type       *   getOrNull( key_type key );
+  mapped_type const *   getOrNull( key_type key ) const;
+
+  mapped_type       &   getOrThrow( key_type key );
+  mapped_type const &   getOrThrow( key_type key ) const;
+
+  mapped_type       &  operator [] ( key_type key );
+  mapped_type const &  operator [] ( key_type key ) const  { return getOrThrow(key); }
+  mapped_type const &  at          ( key_type key ) const  { return getOrThrow(key); }
+
+  // mutators:
+  void  clear( )  { keys_.clear(); values_.clear(); }
+
+  void  reserve( size_type n )  { keys_.reserve(n); values_.reserve(n); }
+
+  void  swap( soa_map_vector<mapped_type> & other );
+
+  // As for map_vector:
+  void  push_back( value_type const & x );
+
+  template< class InIter >
+    void  assign( InIter b, InIter e );
+
+  template< class InIter >
+    void  merge( InIter b, InIter e );
+
+private:
+  key_container     keys_;
+  mapped_container  values_;
+
+  size_type  lower_bound( key_type key ) const;
+
+  void  split( std::vector<value_type> && v );
+
+};  // soa_map_vector<>
+
+// ======================================================================
+// c'tors:
+
+template< class Value >
+cet::soa_map_vector<Value>::
+  soa_map_vector( map_vector<Value> const & m )
+  : keys_()
+  , values_()
+{
+  reserve(m.size());
+  for( auto const & x : m ) {
+    keys_.push_back(x.first);
+    values_.push_back(x.second);
+  }
+}
+
+// ----------------------------------------------------------------------
+// observers:
+
+template< class Value >
+typename cet::soa_map_vector<Value>::size_type
+  cet::soa_map_vector<Value>::
+  index( key_type key ) const
+{
+  size_type const  i = lower_bound(key);
+  return i != size()  &&  keys_[i] == key  ?  i  :  size();
+}
+
+template< class Value >
+Value *
+  cet::soa_map_vector<Value>::
+  getOrNull( key_type key )
+{
+  size_type const  i = index(key);
+  return i == size()  ?  nullptr  :  & values_[i];
+}
+
+template< class Value >
+Value const *
+  cet::soa_map_vector<Value>::
+  getOrNull( key_type key ) const
+{
+  size_type const  i = index(key);
+  return i == size()  ?  nullptr  :  & values_[i];
+}
+
+template< class Value >
+Value &
+  cet::soa_map_vector<Value>::
+  getOrThrow( key_type key )
+{
+  Value *  p = getOrNull(key);
+  if( p == nullptr )
+    throw cet::exception("soa_map_vector::getOrThrow")
+      << "out of range (no such key): " << key.asInt()
+      << std::endl;
+
+  return *p;
+}
+
+template< class Value >
+Value const &
+  cet::soa_map_vector<Value>::
+  getOrThrow( key_type key ) const
+{
+  Value const *  p = getOrNull(key);
+  if( p == nullptr )
+    throw cet::exception("soa_map_vector::getOrThrow")
+      << "out of range (no such key): " << key.asInt()
+      << std::endl;
+
+  return *p;
+}
+
+template< class Value >
+Value &
+  cet::soa_map_vector<Value>::
+  operator [] ( key_type key )
+{
+  size_type const  i = lower_bound(key);
+  if( i == size()  ||  keys_[i] != key ) {
+    keys_.insert(keys_.begin() + i, key);
+    values_.insert(values_.begin() + i, mapped_type());
+  }
+  return values_[i];
+}
+
+// ----------------------------------------------------------------------
+// mutators:
+
+template< class Value >
+void
+  cet::soa_map_vector<Value>::
+  swap( soa_map_vector<mapped_type> & other )
+{
+  keys_.swap(other.keys_);
+  values_.swap(other.values_);
+}
+
+template< class Value >
+void
+  cet::soa_map_vector<Value>::
+  push_back( value_type const & x )
+{
+  x.first.ensure_valid();
+  keys_.emplace_back(x.first.asInt() + delta());
+  values_.push_back(x.second);
+}
+
+template< class Value >
+template< class InIter >
+void
+  cet::soa_map_vector<Value>::
+  assign( InIter b, InIter e )
+{
+  clear();
+  split(detail::map_vector_sorted<value_type>(b, e));
+}
+
+template< class Value >
+template< class InIter >
+void
+  cet::soa_map_vector<Value>::
+  merge( InIter b, InIter e )
+{
+  std::vector<value_type>  added = detail::map_vector_sorted<value_type>(b, e);
+  if( added.empty() )
+    return;
+  if( keys_.empty()  ||  keys_.back() < added.front().first ) {
+    split(std::move(added));
+    return;
+  }
+
+  soa_map_vector  result;
+  result.reserve(size() + added.size());
+  size_type  i1 = 0;
+  auto       i2 = added.begin(), e2 = added.end();
+  while( i1 != size()  &&  i2 != e2 ) {
+    if( i2->first < keys_[i1] ) {
+      result.keys_.push_back(i2->first);
+      result.values_.push_back(std::move(i2->second));
+      ++i2;
+    }
+    else {
+      if( i2->first == keys_[i1] )
+        ++i2;
+      result.keys_.push_back(keys_[i1]);
+      result.values_.push_back(std::move(values_[i1]));
+      ++i1;
+    }
+  }
+  for(  ;  i1 != size();  ++i1 ) {
+    result.keys_.push_back(keys_[i1]);
+    result.values_.push_back(std::move(values_[i1]));
+  }
+  swap(result);
+  split(std::vector<value_type>( std::make_move_iterator(i2)
+                               , std::make_move_iterator(e2) ));
+}
+
+// ----------------------------------------------------------------------
+// helpers:
+
+template< class Value >
+typename cet::soa_map_vector<Value>::size_type
+  cet::soa_map_vector<Value>::
+  lower_bound( key_type key ) const
+{
+  auto const  key_of = []( key_type const & k ) { return k.asInt(); };
+  return detail::map_vector_lower_bound(keys_.begin(), keys_.size(), key.asInt(), key_of)
+       - keys_.begin();
+}
+
+// Append v, whose keys all follow ours.
+template< class Value >
+void
+  cet::soa_map_vector<Value>::
+  split( std::vector<value_type> && v )
+{
+  reserve(size() + v.size());
+  for( auto & x : v ) {
+    keys_.push_back(x.first);
+    values_.push_back(std::move(x.second));
+  }
+}
+
+// ======================================================================
+#endif
@@ -5,11 +5,20 @@
 //
 // ston: produce number from string
 //
+// Leading whitespace and a leading '+' are skipped; the rest of the
+// string must be the number. Throws std::invalid_argument if it isn't,
+// std::out_of_range if the number doesn't fit the requested type. The
+// conversions themselves are those of cetlib/charconv.h.
+//
+// An integer must be written as one: ston<int> no longer accepts
+// "1.5", "1e3" or "0x10", as it did when it converted by way of stod.
+//
 // ======================================================================
 
-#include "boost/lexical_cast.hpp"
+#include "cetlib/charconv.h"
 #include "cpp0x/string"
 #include "cpp0x/type_traits"
+#include <cctype>
 #include <limits>
 #include <stdexcept>
 
@@ -37,118 +46,86 @@ namespace cet {
                          , T
                          >::type
     ston( std::string );
+
+  namespace detail {
+    template< class T >
+      T  ston( std::string const &, char const * name );
+  }
 }
 
 // ======================================================================
 
+template< class T >
+T
+  cet::detail::ston( std::string const & s, char const * name )
+{
+  char const *       first = s.data();
+  char const * const last  = first + s.size();
+  while( first != last && std::isspace(static_cast<unsigned char>(*first)) )
+    ++first;
+  // Only one sign: from_chars for floating types accepts another.
+  if( last - first > 1 && *first == '+' && first[1] != '-' && first[1] != '+' )
+    ++first;
+
+  T result;
+  from_chars_result const r = from_chars(first, last, result);
+  if( r.ec == std::errc::result_out_of_range )
+    throw std::out_of_range(name);
+  if( r.ec != std::errc() || r.ptr != last )
+    throw std::invalid_argument(name);
+  return result;
+}
+
 // ----------------------------------------------------------------------
 
 template<>
-int
+inline int
   cet::ston<int>( std::string s )
-{
-  std::size_t size;
-  int result = stod(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<int>");
-  return result;
-}
+{ return detail::ston<int>(s, "ston<int>"); }
 
 template<>
-long
+inline long
   cet::ston<long>( std::string s )
-{
-  std::size_t size;
-  long result = stol(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<long>");
-  return result;
-}
+{ return detail::ston<long>(s, "ston<long>"); }
 
 template<>
-long long
+inline long long
   cet::ston<long long>( std::string s )
-{
-  std::size_t size;
-  long long result = stoll(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<long long>");
-  return result;
-}
+{ return detail::ston<long long>(s, "ston<long long>"); }
 
 // ----------------------------------------------------------------------
 
 template<>
-unsigned
+inline unsigned
   cet::ston<unsigned>( std::string s )
-{
-  std::size_t size;
-  unsigned long result = stoul(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<unsigned long>");
-  if(    result < std::numeric_limits<unsigned>::min()
-      || std::numeric_limits<unsigned>::max() < result
-    )
-    throw std::out_of_range("ston<unsigned long>");
-  return static_cast<unsigned>(result);
-}
+{ return detail::ston<unsigned>(s, "ston<unsigned>"); }
 
 template<>
-unsigned long
+inline unsigned long
   cet::ston<unsigned long>( std::string s )
-{
-  std::size_t size;
-  unsigned long result = stoul(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<unsigned long>");
-  return result;
-}
+{ return detail::ston<unsigned long>(s, "ston<unsigned long>"); }
 
 template<>
-unsigned long long
+inline unsigned long long
   cet::ston<unsigned long long>( std::string s )
-{
-  std::size_t size;
-  unsigned long long result = stoull(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<unsigned long long>");
-  return result;
-}
+{ return detail::ston<unsigned long long>(s, "ston<unsigned long long>"); }
 
 // ----------------------------------------------------------------------
 
 template<>
-float
+inline float
   cet::ston<float>( std::string s )
-{
-  std::size_t size;
-  float result = stof(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<float>");
-  return result;
-}
+{ return detail::ston<float>(s, "ston<float>"); }
 
 template<>
-double
+inline double
   cet::ston<double>( std::string s )
-{
-  std::size_t size;
-  double result = stod(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<double>");
-  return result;
-}
+{ return detail::ston<double>(s, "ston<double>"); }
 
 template<>
-long double
+inline long double
   cet::ston<long double>( std::string s )
-{
-  std::size_t size;
-  long double result = stold(s, &size);
-  if( size < s.size() )
-    throw std::invalid_argument("ston<long double>");
-  return result;
-}
+{ return detail::ston<long double>(s, "ston<long double>"); }
 
 // ----------------------------------------------------------------------
 
@@ -158,13 +135,8 @@ typename std::enable_if<    std::is_integral<T>::value
                        , T
                        >::type
   cet::ston( std::string s )
-try
-{
-  return boost::lexical_cast<T>(s);
-}
-catch( boost::bad_lexical_cast )
 {
-  throw std::invalid_argument("ston<large>");
+  return detail::ston<T>(s, "ston<large>");
 }
 
 // ======================================================================
@@ -71,6 +71,9 @@ void sha1_update( sha1_context *ctx, const unsigned char *input, size_t ilen );
  */
 void sha1_finish( sha1_context *ctx, unsigned char output[20] );
 
+/* Internal use: compression of one 64-byte block into ctx->state */
+void sha1_process( sha1_context *ctx, const unsigned char data[64] );
+
 /**
  * \brief          Output = SHA-1( input buffer )
  *
@@ -0,0 +1,126 @@
+// ======================================================================
+//
+// LibraryManager_prefetch_benchmark: time from the start of a simulated
+//                                    configuration parse to having
+//                                    loaded every library of a type,
+//                                    loading them afterwards or
+//                                    prefetching them meanwhile
+//
+// Each mode is run in its own process, after asking the kernel to drop
+// the libraries from the page cache, so that no mode benefits from the
+// loads of another. The libraries are found in LD_LIBRARY_PATH.
+//
+// Usage: LibraryManager_prefetch_benchmark [lib_type [parse_ms]]
+//
+// ======================================================================
+
+#include "cetlib/LibraryManager.h"
+#include "cetlib/exception.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+using cet::LibraryManager;
+
+namespace {
+
+  typedef  std::chrono::steady_clock  clock_type;
+
+  double
+    ms_since( clock_type::time_point start )
+  {
+    std::chrono::duration<double, std::milli> const t = clock_type::now() - start;
+    return t.count();
+  }
+
+  void
+    drop_from_cache( std::vector<std::string> const & paths )
+  {
+#ifdef POSIX_FADV_DONTNEED
+    for( auto const & path : paths ) {
+      int const fd = ::open(path.c_str(), O_RDONLY);
+      if( fd != -1 ) {
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+      }
+    }
+#else
+    (void) paths;
+#endif
+  }
+
+  // Stands in for parsing the configuration: keeps this thread busy.
+  void
+    parse( double ms )
+  {
+    auto const start = clock_type::now();
+    while( ms_since(start) < ms )
+      ;
+  }
+
+  void
+    run( std::string const & lib_type, double parse_ms, int mode )
+  {
+    auto const start = clock_type::now();
+    LibraryManager const lm(lib_type);
+    std::vector<std::string> specs;
+    lm.getValidLibspecs(specs);
+    if( mode == 1 )
+      lm.prefetch(specs, LibraryManager::prefetch_mode::readahead);
+    else if( mode == 2 )
+      lm.prefetch(specs);
+    parse(parse_ms);
+    auto const parsed = clock_type::now();
+    std::size_t loaded = 0u;
+    for( auto const & spec : specs ) {
+      try {
+        lm.getSymbolByLibspec<void *>(spec, "no_such_symbol", LibraryManager::nothrow);
+        ++loaded;
+      }
+      catch( cet::exception const & ) {  // Ambiguous libspec.
+      }
+    }
+    static char const * const names[] = { "none", "readahead", "load" };
+    std::printf("%-10s %8zu %10.2fms %10.2fms\n"
+               , names[mode], loaded, ms_since(parsed), ms_since(start));
+  }
+
+}  // namespace
+
+int
+  main( int argc, char * argv[] )
+{
+  std::string const lib_type = argc > 1 ? argv[1] : "cetlibtest";
+  double const parse_ms = argc > 2 ? std::atof(argv[2]) : 50.0;
+
+  std::vector<std::string> paths;
+  LibraryManager(lib_type).getLoadableLibraries(paths);
+  std::printf("%zu libraries of type %s, %.0fms parse\n"
+             , paths.size(), lib_type.c_str(), parse_ms);
+  std::printf("%-10s %8s %12s %12s\n", "prefetch", "libspecs", "after parse", "total");
+  std::fflush(stdout);
+
+  for( int mode = 0; mode != 3; ++mode ) {
+    drop_from_cache(paths);
+    pid_t const pid = ::fork();
+    if( pid == -1 )
+      return 1;
+    if( pid == 0 ) {
+      run(lib_type, parse_ms, mode);
+      std::fflush(stdout);
+      std::_Exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+  }
+  return 0;
+}
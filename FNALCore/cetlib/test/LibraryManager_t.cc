@@ -153,6 +153,45 @@ BOOST_AUTO_TEST_CASE(dictLoaded)
   BOOST_REQUIRE(lm_ref.libraryIsLoaded(*lib_list.begin()));
 }
 
+BOOST_AUTO_TEST_CASE(prefetchLoads)
+{
+  lm_ref.prefetch({ "2/1/5", "1/2/3", "3", "NoSuchLibrary" });
+  lm_ref.waitForPrefetch();
+  std::vector<std::string> loaded;
+  BOOST_REQUIRE_EQUAL(lm_ref.getLoadedLibraries(loaded), 2u);
+  cettest::idString_t idString = nullptr;
+  BOOST_CHECK_NO_THROW(idString = lm_ref.getSymbolByLibspec<cettest::idString_t> ("2/1/5", "idString"));
+  verify("2/1/5", idString);
+  BOOST_REQUIRE_EQUAL(lm_ref.getLoadedLibraries(loaded), 2u);
+  // Ambiguous libspecs are still reported on request.
+  BOOST_CHECK_THROW(lm_ref.getSymbolByLibspec<void *> ("3", "idString"),
+                    cet::exception);
+}
+
+BOOST_AUTO_TEST_CASE(prefetchReadahead)
+{
+  lm_ref.prefetch({ "2/1/5" }, LibraryManager::prefetch_mode::readahead);
+  lm_ref.waitForPrefetch();
+  std::vector<std::string> loaded;
+  BOOST_REQUIRE_EQUAL(lm_ref.getLoadedLibraries(loaded), 0u);
+  BOOST_REQUIRE(lm_ref.getSymbolByLibspec<void *>("2/1/5",
+                "idString") != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(prefetchConcurrentRequests)
+{
+  lm_ref.prefetch({ "1/1/1", "1/1/2", "1/1/3", "1/2/3", "2/1/5" });
+  cettest::idString_t idString = nullptr;
+  BOOST_CHECK_NO_THROW(idString = lm_ref.getSymbolByLibspec<cettest::idString_t> ("1/1/3", "idString"));
+  verify("1/1/3", idString);
+  lm_ref.prefetch({ "1/1/2" });
+  BOOST_CHECK_NO_THROW(idString = lm_ref.getSymbolByLibspec<cettest::idString_t> ("1/1/2", "idString"));
+  verify("1/1/2", idString);
+  lm_ref.waitForPrefetch();
+  std::vector<std::string> loaded;
+  BOOST_REQUIRE_EQUAL(lm_ref.getLoadedLibraries(loaded), 5u);
+}
+
 BOOST_AUTO_TEST_CASE(dictNotLoadable)
 {
   std::vector<std::string> lib_list;
@@ -9,6 +9,8 @@
 
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace cet;
 
@@ -50,6 +52,56 @@ BOOST_AUTO_TEST_CASE(CheckFinder)
                                      cet::PluginFactory::nothrow) == 0);
 }
 
+BOOST_AUTO_TEST_CASE(checkResolve)
+{
+  auto maker = pf.resolve<std::unique_ptr<cettest::TestPluginBase>,
+                          std::string>("TestPlugin", "makePlugin");
+  BOOST_REQUIRE(maker);
+  for (auto const & msg : { "one", "two", "three" }) {
+    BOOST_REQUIRE_EQUAL(maker(msg)->message(), std::string(msg));
+  }
+  // Served from the factory's cache the second time, for any type.
+  BOOST_REQUIRE(pf.find<std::string>("TestPlugin", "pluginType") ==
+                pf.resolve<std::string>("TestPlugin", "pluginType"));
+  BOOST_REQUIRE(pf.find<std::string>("TestPlugin", "makePlugin",
+                                     cet::PluginFactory::nothrow) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(checkFailuresNotCached)
+{
+  for (int i = 0; i != 2; ++i) {
+    BOOST_REQUIRE(pf.find<std::string>("TestPlugin",
+                                       "oops",
+                                       cet::PluginFactory::nothrow) == 0);
+    BOOST_CHECK_THROW(pf.resolve<std::string>("TestPlugin", "oops"),
+                      cet::exception);
+    BOOST_CHECK_THROW(pf.resolve<std::string>("TestPluginX", "pluginType"),
+                      cet::exception);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(checkConcurrentFind)
+{
+  // Threads missing the cache together all get the one address.
+  using type_fn = std::string (*) ();
+  std::vector<type_fn> found(8u, nullptr);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t != found.size(); ++t) {
+    threads.emplace_back([this, &found, t] {
+      for (int i = 0; i != 100; ++i) {
+        found[t] = pf.find<std::string>("TestPlugin", "pluginType");
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  for (auto const f : found) {
+    BOOST_REQUIRE(f != nullptr);
+    BOOST_REQUIRE(f == found.front());
+  }
+}
+
 BOOST_AUTO_TEST_CASE(checkError)
 {
   BOOST_CHECK_EXCEPTION(pf.makePlugin<std::unique_ptr<cettest::TestPluginBase> >("TestPluginX", "Hi"), \
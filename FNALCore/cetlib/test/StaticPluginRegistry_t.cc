@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE ( StaticPluginRegistry_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/BasicPluginFactory.h"
+#include "cetlib/StaticPluginRegistry.h"
+#include "cetlib/exception.h"
+#include "cetlib/library_index.h"
+#include "cetlib/make_unique.h"
+
+#include "TestPluginBase.h"
+
+#include <memory>
+#include <string>
+
+using namespace cet;
+
+namespace {
+
+  class StaticTestPlugin : public cettest::TestPluginBase {
+  public:
+    StaticTestPlugin(std::string message)
+      : TestPluginBase("static " + message) { }
+  };
+
+  std::unique_ptr<cettest::TestPluginBase>
+  makeStaticTestPlugin(std::string message)
+  {
+    return cet::make_unique<StaticTestPlugin>(std::move(message));
+  }
+
+}
+
+CET_REGISTER_STATIC_PLUGIN_FUNC(staticplugin, StaticTest, makePlugin, makeStaticTestPlugin)
+DEFINE_STATIC_BASIC_PLUGINTYPE_FUNC(staticplugin, StaticTest, cettest::TestPluginBase)
+
+struct StaticPluginRegistryTestFixture {
+  StaticPluginRegistryTestFixture() : pf("staticplugin") { pf.setDiagReleaseVersion("ETERNAL"); }
+
+  BasicPluginFactory pf;
+};
+
+BOOST_FIXTURE_TEST_SUITE(StaticPluginRegistry_t, StaticPluginRegistryTestFixture)
+
+BOOST_AUTO_TEST_CASE(checkRegistry)
+{
+  BOOST_REQUIRE(StaticPluginRegistry::has("staticplugin", "StaticTest"));
+  BOOST_REQUIRE(!StaticPluginRegistry::has("staticplugin", "Other"));
+  BOOST_REQUIRE(!StaticPluginRegistry::has("plugin", "StaticTest"));
+  BOOST_REQUIRE(StaticPluginRegistry::find("staticplugin", "StaticTest", "makePlugin") != nullptr);
+  BOOST_REQUIRE(StaticPluginRegistry::find("staticplugin", "StaticTest", "oops") == nullptr);
+  BOOST_REQUIRE(StaticPluginRegistry::libspecs("staticplugin") ==
+                std::vector<std::string>{ "StaticTest" });
+}
+
+BOOST_AUTO_TEST_CASE(checkFactory)
+{
+  auto const before = library_index::stats();
+  BOOST_REQUIRE_EQUAL(pf.pluginType("StaticTest"),
+                      PluginTypeDeducer<cettest::TestPluginBase>::value);
+  auto p = pf.makePlugin<std::unique_ptr<cettest::TestPluginBase>,
+                         std::string>("StaticTest", "Hi");
+  BOOST_REQUIRE_EQUAL(p->message(), std::string("static Hi"));
+  // Found without looking for any library.
+  auto const after = library_index::stats();
+  BOOST_REQUIRE_EQUAL(after.scans, before.scans);
+  BOOST_REQUIRE_EQUAL(after.memory_hits, before.memory_hits);
+  BOOST_REQUIRE_EQUAL(after.file_hits, before.file_hits);
+}
+
+BOOST_AUTO_TEST_CASE(checkMissingFunction)
+{
+  BOOST_REQUIRE(pf.find<std::string>("StaticTest",
+                                     "oops",
+                                     cet::PluginFactory::nothrow) == nullptr);
+  BOOST_CHECK_EXCEPTION(pf.resolve<std::string>("StaticTest", "oops"),
+                        cet::exception,
+                        [](cet::exception const & e)
+                        {
+                          return e.category() == "Configuration" &&
+                            std::string(e.what()).find("ETERNAL") !=
+                            std::string::npos;
+                        });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
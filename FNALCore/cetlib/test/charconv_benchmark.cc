@@ -0,0 +1,118 @@
+// ======================================================================
+//
+// charconv_benchmark: cet::ston and cet::ntos, as rebased on
+//                     cetlib/charconv.h, against the std::sto* and
+//                     std::to_string conversions they used before, and
+//                     against boost::lexical_cast and iostreams
+//
+// Usage: charconv_benchmark [iterations]
+//
+// ======================================================================
+
+#include "boost/lexical_cast.hpp"
+#include "cetlib/charconv.h"
+#include "cetlib/ntos.h"
+#include "cetlib/ston.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // ns per item of f(item) over items, repeated n times.
+  template< class T, class F >
+  double
+    time( std::vector<T> const & items, unsigned n, F f )
+  {
+    std::size_t sink = 0u;
+    auto const start = std::chrono::steady_clock::now();
+    for( unsigned i = 0; i != n; ++i )
+      for( auto const & item : items )
+        sink += f(item);
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    if( sink == 1u )
+      std::printf(" ");
+    return 1e9 * t.count() / (double(n) * items.size());
+  }
+
+  void
+    report( char const * what, double old_ns, double cast_ns, double new_ns, double raw_ns )
+  {
+    std::printf( "%-18s %9.1f %9.1f %9.1f %9.1f   x%.1f\n"
+               , what, old_ns, cast_ns, new_ns, raw_ns, old_ns / new_ns );
+  }
+
+}
+
+int
+  main( int argc, char * argv[] )
+{
+  unsigned const n = argc > 1 ? std::atoi(argv[1]) : 50u;
+  std::mt19937_64 rng(1u);
+
+  std::vector<long> longs;
+  std::vector<double> doubles;
+  std::vector<std::string> long_strings, double_strings;
+  for( int i = 0; i != 10000; ++i ) {
+    long const l = long(rng() >> (rng() % 64u)) * ((i & 1) ? -1 : 1);
+    double const d = std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+    longs.push_back(l);
+    doubles.push_back(d);
+    long_strings.push_back(std::to_string(l));
+    char buf[32];
+    std::snprintf(buf, sizeof buf, "%.17g", d);
+    double_strings.push_back(buf);
+  }
+
+  std::printf( "%-18s %9s %9s %9s %9s   (ns; old/new)\n"
+             , "", "old", "lexical", "new", "charconv" );
+
+  report( "ston<long>"
+        , time(long_strings, n, [](std::string const & s) {
+            std::size_t size; long const r = std::stol(s, &size); return std::size_t(r); })
+        , time(long_strings, n, [](std::string const & s) {
+            return std::size_t(boost::lexical_cast<long>(s)); })
+        , time(long_strings, n, [](std::string const & s) {
+            return std::size_t(cet::ston<long>(s)); })
+        , time(long_strings, n, [](std::string const & s) {
+            long r = 0; cet::from_chars(s.data(), s.data() + s.size(), r); return std::size_t(r); }) );
+
+  report( "ston<double>"
+        , time(double_strings, n, [](std::string const & s) {
+            std::size_t size; return std::size_t(std::stod(s, &size) > 0); })
+        , time(double_strings, n, [](std::string const & s) {
+            return std::size_t(boost::lexical_cast<double>(s) > 0); })
+        , time(double_strings, n, [](std::string const & s) {
+            return std::size_t(cet::ston<double>(s) > 0); })
+        , time(double_strings, n, [](std::string const & s) {
+            double r = 0; cet::from_chars(s.data(), s.data() + s.size(), r); return std::size_t(r > 0); }) );
+
+  report( "ntos(long)"
+        , time(longs, n, [](long l) { return std::to_string(l).size(); })
+        , time(longs, n, [](long l) { return boost::lexical_cast<std::string>(l).size(); })
+        , time(longs, n, [](long l) { return cet::ntos(l).size(); })
+        , time(longs, n, [](long l) {
+            char buf[24]; return std::size_t(cet::to_chars(buf, buf + sizeof buf, l).ptr - buf); }) );
+
+  report( "ntos(double)"
+        , time(doubles, n, [](double d) { return std::to_string(d).size(); })
+        , time(doubles, n, [](double d) {
+            std::ostringstream os; os.precision(6); os << std::fixed << d; return os.str().size(); })
+        , time(doubles, n, [](double d) { return cet::ntos(d).size(); })
+        , time(doubles, n, [](double d) {
+            char buf[64];
+            return std::size_t( cet::to_chars(buf, buf + sizeof buf, d, cet::chars_format::fixed, 6).ptr
+                              - buf ); }) );
+
+  std::printf( "%-18s %9s %9.1f %9s %9.1f   (round trip)\n", "double shortest", ""
+             , time(doubles, n, [](double d) { return boost::lexical_cast<std::string>(d).size(); })
+             , ""
+             , time(doubles, n, [](double d) {
+                 char buf[64]; return std::size_t(cet::to_chars(buf, buf + sizeof buf, d).ptr - buf); }) );
+  return 0;
+}
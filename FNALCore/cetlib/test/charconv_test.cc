@@ -0,0 +1,202 @@
+#define BOOST_TEST_MODULE ( charconv test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/charconv.h"
+#include "cetlib/ntos.h"
+#include "cetlib/ston.h"
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using cet::chars_format;
+using cet::from_chars;
+using cet::to_chars;
+using std::string;
+
+namespace {
+
+  template< class T >
+  string
+    str( T value )
+  {
+    char buf[64];
+    cet::to_chars_result const r = to_chars(buf, buf + sizeof buf, value);
+    BOOST_REQUIRE(r.ec == std::errc());
+    return string(buf, r.ptr);
+  }
+
+  template< class T >
+  T
+    num( string const & s )
+  {
+    T value = T();
+    cet::from_chars_result const r = from_chars(s.data(), s.data() + s.size(), value);
+    BOOST_REQUIRE(r.ec == std::errc());
+    BOOST_REQUIRE(r.ptr == s.data() + s.size());
+    return value;
+  }
+
+  template< class T >
+  void
+    round_trip_integers( std::mt19937_64 & rng )
+  {
+    T const special[] = { T(0), T(1), T(9), T(10), T(99), T(100),
+                          std::numeric_limits<T>::min(), std::numeric_limits<T>::max() };
+    for( T v : special ) {
+      BOOST_CHECK_EQUAL(str(v), std::to_string(v));
+      BOOST_CHECK_EQUAL(num<T>(str(v)), v);
+    }
+    for( int i = 0; i != 10000; ++i ) {
+      T const v = T(rng() >> (rng() % 64u));
+      BOOST_REQUIRE_EQUAL(str(v), std::to_string(v));
+      BOOST_REQUIRE_EQUAL(num<T>(str(v)), v);
+    }
+  }
+
+  template< class T >
+  void
+    round_trip_floating( std::mt19937_64 & rng )
+  {
+    std::uniform_int_distribution<int> exponent( std::numeric_limits<T>::min_exponent - 10
+                                               , std::numeric_limits<T>::max_exponent - 1 );
+    for( int i = 0; i != 20000; ++i ) {
+      T v = std::ldexp(T(rng()) / T(18446744073709551616.0L), exponent(rng));
+      if( rng() & 1u )
+        v = -v;
+      string const s = str(v);
+      BOOST_REQUIRE_EQUAL(num<T>(s), v);
+    }
+  }
+
+}
+
+BOOST_AUTO_TEST_SUITE( charconv_test )
+
+BOOST_AUTO_TEST_CASE( integers )
+{
+  std::mt19937_64 rng(7u);
+  round_trip_integers<int>(rng);
+  round_trip_integers<long>(rng);
+  round_trip_integers<long long>(rng);
+  round_trip_integers<unsigned>(rng);
+  round_trip_integers<unsigned long>(rng);
+  round_trip_integers<unsigned long long>(rng);
+  BOOST_CHECK_EQUAL(str(short(-32768)), "-32768");
+  BOOST_CHECK_EQUAL(num<signed char>("-128"), -128);
+}
+
+BOOST_AUTO_TEST_CASE( integer_errors )
+{
+  int i = 42;
+  string s = "12x";
+  cet::from_chars_result r = from_chars(s.data(), s.data() + s.size(), i);
+  BOOST_CHECK(r.ec == std::errc() && r.ptr == s.data() + 2 && i == 12);
+
+  i = 42;
+  for( string const & bad : { string(""), string("-"), string("+1"), string(" 1"), string("x") } ) {
+    r = from_chars(bad.data(), bad.data() + bad.size(), i);
+    BOOST_CHECK(r.ec == std::errc::invalid_argument && r.ptr == bad.data());
+  }
+  s = "2147483648";
+  r = from_chars(s.data(), s.data() + s.size(), i);
+  BOOST_CHECK(r.ec == std::errc::result_out_of_range && r.ptr == s.data() + s.size());
+  unsigned u = 42u;
+  s = "-1";
+  r = from_chars(s.data(), s.data() + s.size(), u);
+  BOOST_CHECK(r.ec == std::errc::invalid_argument);
+  BOOST_CHECK_EQUAL(i, 42);
+  BOOST_CHECK_EQUAL(u, 42u);
+
+  char buf[3];
+  BOOST_CHECK(to_chars(buf, buf + 3, 1234).ec == std::errc::value_too_large);
+  BOOST_CHECK(to_chars(buf, buf + 3, -123).ec == std::errc::value_too_large);
+  BOOST_CHECK(to_chars(buf, buf + 3, -12).ptr == buf + 3);
+}
+
+BOOST_AUTO_TEST_CASE( floating )
+{
+  std::mt19937_64 rng(11u);
+  round_trip_floating<float>(rng);
+  round_trip_floating<double>(rng);
+  round_trip_floating<long double>(rng);
+
+  BOOST_CHECK_EQUAL(str(0.1), "0.1");
+  BOOST_CHECK_EQUAL(str(0.1F), "0.1");
+  BOOST_CHECK_EQUAL(str(1.0 / 3), "0.3333333333333333");
+  BOOST_CHECK_EQUAL(str(-0.0), "-0");
+  BOOST_CHECK_EQUAL(str(1e300), "1e+300");
+  BOOST_CHECK_EQUAL(str(std::numeric_limits<double>::infinity()), "inf");
+
+  char buf[400];
+  auto fixed = [&buf](double v, int p) {
+    return string(buf, to_chars(buf, buf + sizeof buf, v, chars_format::fixed, p).ptr);
+  };
+  BOOST_CHECK_EQUAL(fixed(2.5, 2), "2.50");
+  string const big = fixed(1e300, 0);
+  BOOST_CHECK_EQUAL(big.size(), 301u);
+  BOOST_CHECK(to_chars(buf, buf + 300, 1e300, chars_format::fixed, 0).ec == std::errc::value_too_large);
+  cet::to_chars_result const exact = to_chars(buf, buf + 301, 1e300, chars_format::fixed, 0);
+  BOOST_CHECK(exact.ec == std::errc() && string(buf, exact.ptr) == big);
+  BOOST_CHECK_EQUAL( string(buf, to_chars(buf, buf + sizeof buf, 1234.5, chars_format::scientific, 3).ptr)
+                   , "1.234e+03" );
+}
+
+BOOST_AUTO_TEST_CASE( floating_errors )
+{
+  double d = 42.;
+  for( string const & bad : { string(""), string(" 1"), string("x"), string(".") } ) {
+    cet::from_chars_result const r = from_chars(bad.data(), bad.data() + bad.size(), d);
+    BOOST_CHECK(r.ec == std::errc::invalid_argument && r.ptr == bad.data());
+  }
+  string s = "1e999";
+  cet::from_chars_result r = from_chars(s.data(), s.data() + s.size(), d);
+  BOOST_CHECK(r.ec == std::errc::result_out_of_range && r.ptr == s.data() + s.size());
+  BOOST_CHECK_EQUAL(d, 42.);
+
+  // Only [first, last) is read.
+  s = "2.5e1";
+  r = from_chars(s.data(), s.data() + 3, d);
+  BOOST_CHECK(r.ec == std::errc() && d == 2.5);
+}
+
+BOOST_AUTO_TEST_CASE( locale_independence )
+{
+  char const * const locales[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8" };
+  char const * installed = nullptr;
+  for( char const * l : locales )
+    if( std::setlocale(LC_ALL, l) ) { installed = l; break; }
+  if( installed == nullptr ) {
+    BOOST_TEST_MESSAGE("No locale with a decimal comma; skipped.");
+    return;
+  }
+  BOOST_CHECK_EQUAL(str(2.5), "2.5");
+  BOOST_CHECK_EQUAL(num<double>("2.5"), 2.5);
+  BOOST_CHECK_EQUAL(cet::ntos(2.5), "2.500000");
+  BOOST_CHECK_EQUAL(cet::ston<double>("2.5"), 2.5);
+  std::setlocale(LC_ALL, "C");
+}
+
+BOOST_AUTO_TEST_CASE( ston_ntos )
+{
+  BOOST_CHECK_EQUAL(cet::ston<int>(" +12"), 12);
+  BOOST_CHECK_EQUAL(cet::ston<int>("-2147483648"), std::numeric_limits<int>::min());
+  BOOST_CHECK_THROW(cet::ston<int>("2147483648"), std::out_of_range);
+  BOOST_CHECK_THROW(cet::ston<int>("1.5"), std::invalid_argument);
+  BOOST_CHECK_THROW(cet::ston<int>("+-1"), std::invalid_argument);
+  BOOST_CHECK_THROW(cet::ston<unsigned>("4294967296"), std::out_of_range);
+  BOOST_CHECK_THROW(cet::ston<double>("1e999"), std::out_of_range);
+  BOOST_CHECK_THROW(cet::ston<double>(""), std::invalid_argument);
+  BOOST_CHECK_EQUAL(cet::ston<double>("0x1p3"), 8.);
+
+  BOOST_CHECK_EQUAL(cet::ntos(-42), "-42");
+  BOOST_CHECK_EQUAL(cet::ntos(std::numeric_limits<unsigned long long>::max()), "18446744073709551615");
+  BOOST_CHECK_EQUAL(cet::ntos(1e300), std::to_string(1e300));
+  BOOST_CHECK_EQUAL(cet::ntos(-1.5e-7F), std::to_string(-1.5e-7F));
+  BOOST_CHECK_EQUAL(cet::ntos(1e4000L), std::to_string(1e4000L));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+// ======================================================================
+//
+// concurrent_registry_benchmark: throughput of concurrent_registry, and
+//                                of registry behind one mutex, with
+//                                1 to 8 threads each making lookups and
+//                                occasional puts
+//
+// Usage: concurrent_registry_benchmark [keys [operations per thread]]
+//
+// ======================================================================
+
+#include "cetlib/concurrent_registry.h"
+#include "cetlib/registry.h"
+#include "cpp0x/cstdint"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using cet::concurrent_registry;
+using cet::registry;
+
+namespace {
+
+  typedef  registry<long, long>             serial_reg;
+  typedef  concurrent_registry<long, long>  concurrent_reg;
+
+  std::mutex  serial_mutex;
+
+  // Millions of operations per second by n_threads threads each making
+  // ops calls of op(key, is_put), one in a hundred a put.
+  double
+    measure( unsigned n_threads, std::size_t ops, long n_keys
+           , std::function<long (long, bool)> const & op )
+  {
+    std::vector<std::thread>  threads;
+    auto const start = std::chrono::steady_clock::now();
+    for( unsigned t = 0;  t != n_threads;  ++t )
+      threads.emplace_back([&, t]{
+        std::mt19937_64  rng(t + 1u);
+        long sink = 0;
+        for( std::size_t i = 0;  i != ops;  ++i ) {
+          // Lookups find a key; puts may add one.
+          std::uint64_t const r = rng();
+          bool const is_put = (r >> 32) % 100u == 0u;
+          sink += op(long(r % std::uint64_t(is_put ? 2 * n_keys : n_keys)), is_put);
+        }
+        if( sink == 1 )
+          std::printf(" ");
+      });
+    for( auto & thread : threads )
+      thread.join();
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    return n_threads * ops / t.count() / 1e6;
+  }
+
+}  // namespace
+
+int
+  main( int argc, char * argv[] )
+{
+  long const         n_keys = argc > 1 ? std::atol(argv[1]) : 100000;
+  std::size_t const  ops    = argc > 2 ? std::atol(argv[2]) : 2000000u;
+
+  for( long k = 0;  k != n_keys;  ++k ) {
+    serial_reg::put(k, k);
+    concurrent_reg::put(k, k);
+  }
+
+  auto const serial = []( long key, bool is_put ) -> long {
+    std::lock_guard<std::mutex> lock(serial_mutex);
+    if( is_put ) {
+      serial_reg::put(key, key);
+      return 0;
+    }
+    long value = 0;
+    serial_reg::get(key, value);
+    return value;
+  };
+  auto const concurrent = []( long key, bool is_put ) -> long {
+    if( is_put ) {
+      concurrent_reg::put(key, key);
+      return 0;
+    }
+    long value = 0;
+    concurrent_reg::get(key, value);
+    return value;
+  };
+
+  std::printf("%ld keys, %zu operations per thread, 1%% puts (Mops/s)\n", n_keys, ops);
+  std::printf("%8s %22s %22s\n", "threads", "registry + mutex", "concurrent_registry");
+  for( unsigned n_threads : { 1u, 2u, 4u, 8u } ) {
+    double const s = measure(n_threads, ops, n_keys, serial);
+    double const c = measure(n_threads, ops, n_keys, concurrent);
+    std::printf("%8u %22.1f %22.1f\n", n_threads, s, c);
+  }
+  return 0;
+}
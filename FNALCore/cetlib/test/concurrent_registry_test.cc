@@ -0,0 +1,184 @@
+// ======================================================================
+//
+// test concurrent_registry and concurrent_registry_via_id
+//
+// ======================================================================
+
+#include "cetlib/concurrent_registry.h"
+#include "cetlib/concurrent_registry_via_id.h"
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using cet::concurrent_registry;
+using cet::concurrent_registry_via_id;
+
+void
+  ensure(  int which, bool claim )
+{
+  if( not claim )
+    std::exit(which);
+}
+
+
+struct Int
+{
+  int i;
+  Int(int i = 0) : i(i) { }
+  float id() const { return i; }
+  bool operator == ( int other ) const { return i == other; }
+};
+
+
+// The checks of registry_test.
+void
+  test_registry( )
+{
+  int i;
+
+  typedef  concurrent_registry<char const *, int>  reg;
+  ensure( 1, reg::empty() );
+  ensure( 2, reg::size() == 0 );
+
+  reg::put("one"  , 1);
+  reg::put("two"  , 2);
+  reg::put("three", 3);
+  ensure( 3, reg::size() == 3 );
+  reg::put("four" , 4);
+  reg::put("five" , 5);
+  reg::put("six"  , 6);
+  reg::put("seven", 7);
+  reg::put("eight", 8);
+  reg::put("nine" , 9);
+  reg::put("zero" , 0);
+  reg::put("one"  , 11);
+
+  ensure( 11, ! reg::empty() );
+  ensure( 12, reg::size() == 10 );
+  ensure( 13, reg::get("seven") == 7 );
+  ensure( 14, reg::get("five") == 5 );
+  ensure( 15, ! reg::get("bleen", i) );
+  ensure( 16, reg::get("two", i) && i == 2 );
+  ensure( 17, reg::get("one") == 1 );
+
+  try {
+    reg::get("ten");
+    ensure( 21, false );
+  }
+  catch( cet::exception const & e ) {
+    ensure( 22, e.category() == "cet::concurrent_registry" );
+    std::string s = e.explain_self();
+    ensure( 23, s.find("not found in registry") != std::string::npos );
+  }
+  catch( ... ) {
+    ensure( 24, false );
+  }
+
+  int sum = 0;
+  reg::for_each([&sum]( char const *, int v ) { sum += v; });
+  ensure( 25, sum == 45 );
+}
+
+
+// The checks of registry_via_id_test.
+void
+  test_registry_via_id( )
+{
+  Int i;
+
+  typedef  concurrent_registry_via_id<float, Int>  reg;
+  ensure( 31, reg::empty() );
+  ensure( 32, reg::size() == 0 );
+
+  reg::put(1);
+  reg::put(2);
+  reg::put(3);
+  ensure( 33, reg::size() == 3 );
+  reg::put(4);
+  reg::put(5);
+  reg::put(6);
+  reg::put(7);
+  reg::put(8);
+  reg::put(9);
+  ensure( 34, reg::put(0) == 0.0F );
+
+  ensure( 41, ! reg::empty() );
+  ensure( 42, reg::size() == 10 );
+  ensure( 43, reg::get(7.0F) == 7 );
+  ensure( 44, reg::get(5.0F) == 5 );
+  ensure( 45, reg::get(2.0F, i) && i == 2 );
+  ensure( 46, ! reg::get(3.14F, i) && i == 2 );
+
+  try {
+    reg::get(10.0F);
+    ensure( 51, false );
+  }
+  catch( cet::exception const & e ) {
+    ensure( 52, e.category() == "cet::concurrent_registry_via_id" );
+    std::string s = e.explain_self();
+    ensure( 53, s.find("not found in registry") != std::string::npos );
+  }
+  catch( ... ) {
+    ensure( 54, false );
+  }
+
+  reg::collection_type x { { 25.0, 25 }, { 36.0, 36 }, { 49.0, 49 } };
+  reg::put(x);
+  reg::put(x.cbegin(), x.cend());
+  std::vector<reg::mapped_type> v { 64, 81, 100 };
+  reg::put(v.cbegin(), v.cend());
+  ensure( 55, reg::size() == 16 );
+
+  reg::collection_type const s = reg::snapshot();
+  ensure( 56, s.size() == 16 );
+  ensure( 57, s.begin()->first == 0.0F && s.rbegin()->second == 100 );
+}
+
+
+// Threads putting overlapping ranges of keys, while others read them.
+void
+  test_threads( )
+{
+  typedef  concurrent_registry<int, long>  reg;
+  int const  n_keys    = 20000;
+  int const  n_writers = 4;
+  int const  n_readers = 4;
+
+  std::atomic<bool>  bad(false);
+  std::vector<std::thread>  threads;
+  for( int t = 0;  t != n_writers;  ++t )
+    threads.emplace_back([&, t]{
+      for( int k = 0;  k != n_keys;  ++k ) {
+        int const key = (k + t * n_keys / n_writers) % n_keys;
+        reg::put(key, 3L * key);
+      }
+    });
+  for( int t = 0;  t != n_readers;  ++t )
+    threads.emplace_back([&]{
+      for( int k = 0;  k != n_keys;  ++k ) {
+        long value = 0;
+        if( reg::get(k, value)  &&  value != 3L * k )
+          bad = true;
+      }
+    });
+  for( auto & thread : threads )
+    thread.join();
+
+  ensure( 61, ! bad );
+  ensure( 62, reg::size() == std::size_t(n_keys) );
+  for( int k = 0;  k != n_keys;  ++k )
+    ensure( 63, reg::get(k) == 3L * k );
+}
+
+
+int
+  main( )
+{
+  test_registry();
+  test_registry_via_id();
+  test_threads();
+  return 0;
+
+}  // main()
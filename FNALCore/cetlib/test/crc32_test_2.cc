@@ -0,0 +1,150 @@
+#define BOOST_TEST_MODULE ( crc32 implementations test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/crc32.h"
+#include "cetlib/crc32c.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using cet::crc32;
+using cet::crc32c;
+using std::string;
+
+namespace {
+
+  std::vector<string>
+    messages( )
+  {
+    // Every length up to a few folds, and longer messages.
+    std::mt19937 rng(7u);
+    std::vector<string> result;
+    for( std::size_t size = 0; size != 300u; ++size ) {
+      string m(size, '\0');
+      for( char & c : m )
+        c = char(rng());
+      result.push_back(m);
+    }
+    for( std::size_t size : { 1000u, 4096u, 65537u, 1000003u } ) {
+      string m(size, '\0');
+      for( char & c : m )
+        c = char(rng());
+      result.push_back(m);
+    }
+    return result;
+  }
+
+  // The checksum of mesg, fed in pieces of at most step characters,
+  // the first starting offset bytes into a buffer.
+  template< class Hasher >
+  typename Hasher::digest_t
+    checksum( string const & mesg, std::size_t step, std::size_t offset = 0u )
+  {
+    string const buf = string(offset, 'x') + mesg;
+    Hasher h;
+    for( std::size_t i = 0; i < mesg.size(); i += step )
+      h.update(buf.data() + offset + i, std::min(step, mesg.size() - i));
+    return h.digest();
+  }
+
+  // Runs check() with each implementation the CPU supports in turn.
+  template< class Hasher, class F >
+  void
+    for_each_implementation( F check )
+  {
+    string const original = Hasher::implementation();
+    for( string const & name : Hasher::implementations() ) {
+      BOOST_TEST_MESSAGE("implementation: " << name);
+      BOOST_REQUIRE(Hasher::use_implementation(name));
+      BOOST_REQUIRE_EQUAL(Hasher::implementation(), name);
+      check();
+    }
+    BOOST_REQUIRE(Hasher::use_implementation(original));
+  }
+
+  template< class Hasher >
+  void
+    check_agreement( )
+  {
+    std::vector<string> const mesgs = messages();
+    std::vector<typename Hasher::digest_t> expected;
+    BOOST_REQUIRE(Hasher::use_implementation("bytewise"));
+    for( string const & m : mesgs )
+      expected.push_back(checksum<Hasher>(m, m.size() + 1u));
+
+    for_each_implementation<Hasher>([&] {
+      for( std::size_t i = 0; i != mesgs.size(); ++i ) {
+        for( std::size_t step : { mesgs[i].size() + 1u, std::size_t(1u), std::size_t(15u), std::size_t(67u), std::size_t(4099u) } )
+          BOOST_REQUIRE_EQUAL(checksum<Hasher>(mesgs[i], step), expected[i]);
+        for( std::size_t offset : { 1u, 3u, 7u } )
+          BOOST_REQUIRE_EQUAL(checksum<Hasher>(mesgs[i], mesgs[i].size() + 1u, offset), expected[i]);
+      }
+    });
+  }
+
+  template< class Hasher >
+  void
+    check_combine( )
+  {
+    std::vector<string> const mesgs = messages();
+    for( string const & m : mesgs ) {
+      typename Hasher::digest_t const whole = Hasher(m).digest();
+      for( std::size_t split : { std::size_t(0u), m.size() / 3u, m.size() / 2u, m.size() } ) {
+        typename Hasher::digest_t const a = Hasher(m.substr(0, split)).digest();
+        typename Hasher::digest_t const b = Hasher(m.substr(split)).digest();
+        BOOST_REQUIRE_EQUAL(Hasher::combine(a, b, m.size() - split), whole);
+      }
+    }
+    // Many chunks, merged left to right.
+    string const & big = mesgs.back();
+    typename Hasher::digest_t merged = Hasher().digest();
+    for( std::size_t i = 0; i < big.size(); i += 100003u ) {
+      string const chunk = big.substr(i, 100003u);
+      merged = Hasher::combine(merged, Hasher(chunk).digest(), chunk.size());
+    }
+    BOOST_CHECK_EQUAL(merged, Hasher(big).digest());
+  }
+
+}
+
+BOOST_AUTO_TEST_SUITE( crc32_test_2 )
+
+BOOST_AUTO_TEST_CASE( check_values )
+{
+  for_each_implementation<crc32>([] {
+    BOOST_CHECK_EQUAL(crc32("").digest(), 0x00000000u);
+    BOOST_CHECK_EQUAL(crc32("123456789").digest(), 0xCBF43926u);
+    BOOST_CHECK_EQUAL(crc32(string(1000000, 'a')).digest(), 0xDC25BFBCu);
+  });
+  for_each_implementation<crc32c>([] {
+    BOOST_CHECK_EQUAL(crc32c("").digest(), 0x00000000u);
+    BOOST_CHECK_EQUAL(crc32c("123456789").digest(), 0xE3069283u);
+    // RFC 3720, B.4.
+    BOOST_CHECK_EQUAL(crc32c(string(32, '\0')).digest(), 0x8A9136AAu);
+    BOOST_CHECK_EQUAL(crc32c(string(32, '\xFF')).digest(), 0x62A8AB43u);
+  });
+}
+
+BOOST_AUTO_TEST_CASE( selection )
+{
+  for( std::vector<string> const & names : { crc32::implementations(), crc32c::implementations() } ) {
+    BOOST_REQUIRE(names.size() >= 3u);
+    BOOST_CHECK_EQUAL(names.back(), "bytewise");
+  }
+  BOOST_CHECK(! crc32::use_implementation("no such implementation"));
+  BOOST_CHECK(! crc32c::use_implementation("sse42x"));
+}
+
+BOOST_AUTO_TEST_CASE( agreement )
+{
+  check_agreement<crc32>();
+  check_agreement<crc32c>();
+}
+
+BOOST_AUTO_TEST_CASE( combine )
+{
+  check_combine<crc32>();
+  check_combine<crc32c>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+// ======================================================================
+//
+// crc32_test_performance: throughput, in MB/s, of each implementation
+//                         of cet::crc32 and cet::crc32c this CPU
+//                         supports, for messages of several sizes
+//
+// Usage: crc32_test_performance [megabytes per measurement]
+//
+// ======================================================================
+
+#include "cetlib/crc32.h"
+#include "cetlib/crc32c.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // MB/s of checksumming mesg, repeated to cover about megabytes in all.
+  template< class Hasher >
+  double
+    throughput( std::string const & mesg, double megabytes )
+  {
+    std::size_t const n = std::size_t(megabytes * 1e6 / mesg.size()) + 1u;
+    unsigned sink = 0u;
+    auto const start = std::chrono::steady_clock::now();
+    for( std::size_t i = 0; i != n; ++i )
+      sink += Hasher(mesg).digest();
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    if( sink == 1u )
+      std::printf(" ");
+    return 1e-6 * double(n) * mesg.size() / t.count();
+  }
+
+  template< class Hasher >
+  void
+    report( char const * hasher, std::vector<std::string> const & mesgs, double megabytes )
+  {
+    std::string const original = Hasher::implementation();
+    for( std::string const & name : Hasher::implementations() ) {
+      Hasher::use_implementation(name);
+      std::printf("%-7s %-10s", hasher, name.c_str());
+      for( std::string const & m : mesgs )
+        std::printf(" %10.0f", throughput<Hasher>(m, megabytes));
+      std::printf("\n");
+    }
+    Hasher::use_implementation(original);
+  }
+
+}
+
+int
+  main( int argc, char * argv[] )
+{
+  double const megabytes = argc > 1 ? std::atof(argv[1]) : 500.;
+
+  std::vector<std::string> mesgs;
+  for( std::size_t size : { 64u, 1024u, 65536u, 4194304u } ) {
+    std::string m(size, '\0');
+    for( std::size_t i = 0; i != size; ++i )
+      m[i] = char(i * 2654435761u >> 24);
+    mesgs.push_back(m);
+  }
+
+  std::printf("%-18s", "MB/s");
+  for( std::string const & m : mesgs )
+    std::printf(" %9zuB", m.size());
+  std::printf("\n");
+  report<cet::crc32>("crc32", mesgs, megabytes);
+  report<cet::crc32c>("crc32c", mesgs, megabytes);
+  return 0;
+}
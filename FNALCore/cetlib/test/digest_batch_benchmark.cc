@@ -0,0 +1,89 @@
+// ======================================================================
+//
+// digest_batch_benchmark: throughput of cet::sha1_batch and
+//                         cet::md5_batch, per implementation, for
+//                         batches of messages of one size, over a
+//                         sweep of sizes
+//
+// Usage: digest_batch_benchmark [megabytes per measurement [threads]]
+//
+// ======================================================================
+
+#include "cetlib/md5_batch.h"
+#include "cetlib/sha1_batch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+  std::size_t const  batch_sz = 4096u;
+
+  // MB/s and ns per message of digesting mesgs, repeated to cover about
+  // megabytes in all.
+  template< class Batch >
+  void
+    measure( std::vector<std::string> const & mesgs, double megabytes, unsigned threads )
+  {
+    std::size_t const bytes = mesgs.size() * (mesgs.front().size() + 1u);
+    std::size_t const n = std::size_t(megabytes * 1e6 / bytes) + 1u;
+    std::vector<typename Batch::digest_t> out(mesgs.size());
+    unsigned sink = 0u;
+    auto const start = std::chrono::steady_clock::now();
+    for( std::size_t i = 0; i != n; ++i ) {
+      Batch::digest(mesgs.data(), mesgs.size(), out.data(), threads);
+      sink += out[i % out.size()][0];
+    }
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    if( sink == 1u )
+      std::printf(" ");
+    double const msgs = double(n) * mesgs.size();
+    std::printf(" %8.0f %7.1f", 1e-6 * msgs * mesgs.front().size() / t.count()
+                              , 1e9 * t.count() / msgs);
+  }
+
+  template< class Batch >
+  void
+    report( char const * hash, std::vector<std::size_t> const & sizes
+          , double megabytes, unsigned threads )
+  {
+    std::string const original = Batch::implementation();
+    for( std::string const & name : Batch::implementations() ) {
+      Batch::use_implementation(name);
+      std::printf("%-5s %-8s", hash, name.c_str());
+      for( std::size_t size : sizes ) {
+        std::vector<std::string> mesgs(batch_sz);
+        for( std::size_t i = 0; i != batch_sz; ++i ) {
+          mesgs[i].resize(size);
+          for( std::size_t j = 0; j != size; ++j )
+            mesgs[i][j] = char((i + 1u) * (j + 7u));
+        }
+        measure<Batch>(mesgs, megabytes, threads);
+      }
+      std::printf("\n");
+    }
+    Batch::use_implementation(original);
+  }
+
+}
+
+int
+  main( int argc, char * argv[] )
+{
+  double const megabytes = argc > 1 ? std::atof(argv[1]) : 200.;
+  unsigned const threads = argc > 2 ? unsigned(std::atoi(argv[2])) : 1u;
+
+  std::vector<std::size_t> const sizes = { 16u, 64u, 200u, 1024u, 8192u };
+  std::printf("%u messages per batch, %u thread(s); MB/s and ns/message\n"
+             , unsigned(batch_sz), threads);
+  std::printf("%-14s", "");
+  for( std::size_t size : sizes )
+    std::printf(" %14zuB", size);
+  std::printf("\n");
+  report<cet::sha1_batch>("sha1", sizes, megabytes, threads);
+  report<cet::md5_batch>("md5", sizes, megabytes, threads);
+  return 0;
+}
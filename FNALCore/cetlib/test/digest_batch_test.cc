@@ -0,0 +1,110 @@
+#define BOOST_TEST_MODULE ( digest batch test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/detail/multibuffer.h"
+#include "cetlib/md5_batch.h"
+#include "cetlib/sha1_batch.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::string;
+
+namespace {
+
+  // Every length around one and two blocks, in a mixed order so that
+  // lanes finish at different times, and a few longer messages.
+  std::vector<string>
+    messages( )
+  {
+    std::mt19937 rng(11u);
+    std::vector<string> result;
+    for( std::size_t size = 0; size != 200u; ++size ) {
+      string m(size, '\0');
+      for( char & c : m )
+        c = char(rng());
+      result.push_back(m);
+    }
+    std::shuffle(result.begin(), result.end(), rng);
+    for( std::size_t size : { 1000u, 4096u, 65537u } )
+      result.insert(result.begin() + size % 7u, string(size, char(size)));
+    return result;
+  }
+
+  template< class Batch, class Hasher >
+  void
+    check_batch( )
+  {
+    std::vector<string> const mesgs = messages();
+    std::vector<typename Batch::digest_t> expected;
+    for( string const & m : mesgs )
+      expected.push_back(Hasher(m).digest());
+
+    string const original = Batch::implementation();
+    for( string const & name : Batch::implementations() ) {
+      BOOST_TEST_MESSAGE("implementation: " << name);
+      BOOST_REQUIRE(Batch::use_implementation(name));
+      BOOST_CHECK(Batch::digest(mesgs) == expected);
+      BOOST_CHECK(Batch::digest(mesgs, 3u) == expected);
+      // Fewer messages than lanes, and none.
+      std::vector<string> const few(mesgs.begin(), mesgs.begin() + 5);
+      BOOST_CHECK(Batch::digest(few) ==
+                  std::vector<typename Batch::digest_t>(expected.begin(), expected.begin() + 5));
+      BOOST_CHECK(Batch::digest(std::vector<string>()).empty());
+    }
+    BOOST_REQUIRE(Batch::use_implementation(original));
+    BOOST_CHECK(! Batch::use_implementation("no such implementation"));
+  }
+
+}
+
+BOOST_AUTO_TEST_SUITE( digest_batch_test )
+
+BOOST_AUTO_TEST_CASE( sha1_batch )
+{
+  check_batch<cet::sha1_batch, cet::sha1>();
+}
+
+BOOST_AUTO_TEST_CASE( md5_batch )
+{
+  check_batch<cet::md5_batch, cet::md5>();
+}
+
+BOOST_AUTO_TEST_CASE( raw_buffers )
+{
+  std::vector<string> const mesgs = messages();
+  std::vector<void const *> data;
+  std::vector<std::size_t> sizes;
+  for( string const & m : mesgs ) {
+    data.push_back(m.data());
+    sizes.push_back(m.size());
+  }
+  std::vector<cet::sha1_batch::digest_t> out(mesgs.size());
+  cet::sha1_batch::digest(data.data(), sizes.data(), mesgs.size(), out.data());
+  BOOST_CHECK(out == cet::sha1_batch::digest(mesgs));
+}
+
+BOOST_AUTO_TEST_CASE( slices )
+{
+  using cet::detail::for_each_slice;
+  std::atomic<std::size_t> covered(0u);
+  for_each_slice(1000u, 4u, 1u, [&covered]( std::size_t b, std::size_t e )
+                                { covered += e - b; });
+  BOOST_CHECK_EQUAL(covered.load(), 1000u);
+
+  // The caller's own slice throwing leaves no thread unjoined.
+  covered = 0u;
+  BOOST_CHECK_THROW(for_each_slice(1000u, 4u, 1u,
+                                   [&covered]( std::size_t b, std::size_t e ) {
+                                     if( b == 0u )
+                                       throw std::runtime_error("slice");
+                                     covered += e - b;
+                                   }),
+                    std::runtime_error);
+  BOOST_CHECK_EQUAL(covered.load(), 750u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
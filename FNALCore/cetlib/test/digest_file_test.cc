@@ -0,0 +1,130 @@
+#define BOOST_TEST_MODULE ( digest_file test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/crc32.h"
+#include "cetlib/digest_file.h"
+#include "cetlib/exception.h"
+#include "cetlib/md5.h"
+#include "cetlib/sha1.h"
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using std::string;
+
+namespace {
+
+  string
+    random_bytes( std::size_t size )
+  {
+    std::mt19937 rng(static_cast<unsigned>(size));
+    string result(size, '\0');
+    for( char & c : result )
+      c = char(rng());
+    return result;
+  }
+
+  struct tmp_dir
+  {
+    string path;
+    tmp_dir( )
+    {
+      char templ[] = "/tmp/digest_file_test_XXXXXX";
+      BOOST_REQUIRE(::mkdtemp(templ) != nullptr);
+      path = templ;
+    }
+    ~tmp_dir( ) { std::system(("rm -rf " + path).c_str()); }
+  };
+
+  string
+    write_file( tmp_dir const & dir, string const & name, string const & contents )
+  {
+    string const path = dir.path + '/' + name;
+    std::ofstream(path.c_str(), std::ios::binary) << contents;
+    return path;
+  }
+
+  template< class Hasher >
+  typename Hasher::digest_t
+    digest_of( string const & contents )
+  {
+    Hasher h;
+    h << contents;
+    return h.digest();
+  }
+
+  template< class Hasher >
+  void
+    check_ranges( string const & s )
+  {
+    typename Hasher::digest_t const expected = digest_of<Hasher>(s);
+    std::vector<char> const v(s.begin(), s.end());
+    std::list<unsigned char> const l(s.begin(), s.end());
+    std::deque<signed char> const d(s.begin(), s.end());
+
+    BOOST_CHECK(Hasher().update(s.data(), s.size()).digest() == expected);
+    BOOST_CHECK(Hasher().update(s.begin(), s.end()).digest() == expected);
+    BOOST_CHECK(Hasher().update(v.data(), v.data() + v.size()).digest() == expected);
+    BOOST_CHECK(Hasher().update(l.begin(), l.end()).digest() == expected);
+    BOOST_CHECK(Hasher().update(d.begin(), d.end()).digest() == expected);
+    Hasher split;
+    split.update(s.data(), s.size() / 3).update(s.begin() + s.size() / 3, s.end());
+    BOOST_CHECK(split.digest() == expected);
+  }
+
+}
+
+BOOST_AUTO_TEST_SUITE( digest_file_test )
+
+BOOST_AUTO_TEST_CASE( ranges )
+{
+  for( std::size_t size : { 0u, 1u, 64u, 4095u, 10000u } ) {
+    string const s = random_bytes(size);
+    check_ranges<cet::sha1>(s);
+    check_ranges<cet::md5>(s);
+    check_ranges<cet::crc32>(s);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( regular_files )
+{
+  tmp_dir const dir;
+  // Sizes around page boundaries, and past one 16 MiB mapping window.
+  for( std::size_t size : { 0u, 1u, 4095u, 4096u, 4097u, 1000000u, 17000001u } ) {
+    string const contents = random_bytes(size);
+    string const path = write_file(dir, "f" + std::to_string(size), contents);
+    BOOST_CHECK(cet::digest_file<cet::sha1>(path) == digest_of<cet::sha1>(contents));
+    BOOST_CHECK(cet::digest_file<cet::md5>(path) == digest_of<cet::md5>(contents));
+    BOOST_CHECK_EQUAL(cet::digest_file<cet::crc32>(path), digest_of<cet::crc32>(contents));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( pipe )
+{
+  tmp_dir const dir;
+  string const path = dir.path + "/fifo";
+  BOOST_REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+  string const contents = random_bytes(3000001u);
+  std::thread writer([&] {
+    std::ofstream(path.c_str(), std::ios::binary) << contents;
+  });
+  cet::sha1::digest_t const d = cet::digest_file<cet::sha1>(path);
+  writer.join();
+  BOOST_CHECK(d == digest_of<cet::sha1>(contents));
+}
+
+BOOST_AUTO_TEST_CASE( errors )
+{
+  BOOST_CHECK_THROW(cet::digest_file<cet::sha1>("/no/such/file"), cet::exception);
+  BOOST_CHECK_THROW(cet::digest_file<cet::sha1>("/"), cet::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+// ======================================================================
+//
+// file_cache_test
+//
+// ======================================================================
+
+#define BOOST_TEST_MODULE ( file_cache test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/file_cache.h"
+#include "cetlib/filepath_maker.h"
+#include "cetlib/includer.h"
+#include "cetlib/search_path.h"
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using cet::file_cache;
+
+namespace {
+
+  void
+    write_file( std::string const & name, std::string const & contents )
+  {
+    std::ofstream f(name.c_str());
+    f << contents;
+  }
+
+  std::string
+    expand( std::string const & filename )
+  {
+    cet::filepath_lookup lookup("./:/no/such/dir");
+    cet::includer inc(filename, lookup);
+    return std::string(inc.begin(), inc.end());
+  }
+
+}
+
+BOOST_AUTO_TEST_SUITE( file_cache_test )
+
+BOOST_AUTO_TEST_CASE( disabled_by_default )
+{
+  BOOST_CHECK(! file_cache::enabled());
+  write_file("fc_a.txt", "abc\n");
+  auto c = file_cache::read("fc_a.txt");
+  BOOST_REQUIRE(c);
+  BOOST_CHECK_EQUAL(*c, "abc\n");
+  BOOST_CHECK(! file_cache::read("fc_missing.txt"));
+  BOOST_CHECK_EQUAL(file_cache::stats().content_misses, 0u);
+}
+
+BOOST_AUTO_TEST_CASE( contents )
+{
+  file_cache::enable();
+  file_cache::clear();
+  write_file("fc_a.txt", "abc\n");
+  auto c1 = file_cache::read("fc_a.txt");
+  auto c2 = file_cache::read("fc_a.txt");
+  BOOST_REQUIRE(c1 && c2);
+  BOOST_CHECK_EQUAL(c1.get(), c2.get());
+  BOOST_CHECK_EQUAL(file_cache::stats().content_misses, 1u);
+  BOOST_CHECK_EQUAL(file_cache::stats().content_hits, 1u);
+
+  // A modified file is read again.
+  write_file("fc_a.txt", "abcdef\n");
+  auto c3 = file_cache::read("fc_a.txt");
+  BOOST_REQUIRE(c3);
+  BOOST_CHECK_EQUAL(*c3, "abcdef\n");
+  BOOST_CHECK_EQUAL(file_cache::stats().content_stale, 1u);
+  BOOST_CHECK(! file_cache::read("fc_missing.txt"));
+  file_cache::enable(false);
+}
+
+BOOST_AUTO_TEST_CASE( lookups )
+{
+  file_cache::enable();
+  file_cache::clear();
+  write_file("fc_b.txt", "b\n");
+  cet::search_path p("./:/no/such/dir");
+  std::string result;
+  BOOST_CHECK(p.find_file("fc_b.txt", result));
+  BOOST_CHECK_EQUAL(result, "./fc_b.txt");
+  result.clear();
+  BOOST_CHECK(p.find_file("fc_b.txt", result));
+  BOOST_CHECK_EQUAL(result, "./fc_b.txt");
+  BOOST_CHECK(! p.find_file("fc_nothere.txt", result));
+  BOOST_CHECK(! p.find_file("fc_nothere.txt", result));
+  BOOST_CHECK_EQUAL(file_cache::stats().lookup_misses, 2u);
+  BOOST_CHECK_EQUAL(file_cache::stats().lookup_hits, 2u);
+  file_cache::enable(false);
+}
+
+BOOST_AUTO_TEST_CASE( includer_unchanged )
+{
+  write_file("fc_i.txt", "x\n#include \"fc_j.txt\"\ny");
+  write_file("fc_j.txt", "#include \"fc_a.txt\"\nj\n");
+  write_file("fc_a.txt", "a\n");
+  std::string const uncached = expand("fc_i.txt");
+  BOOST_CHECK_EQUAL(uncached, "x\na\nj\ny\n");
+
+  file_cache::enable();
+  file_cache::clear();
+  std::vector<std::string> results(8);
+  std::vector<std::thread> threads;
+  for( auto & r : results )
+    threads.emplace_back([&r]{ for( int k = 0; k != 50; ++k ) r = expand("fc_i.txt"); });
+  for( auto & t : threads )
+    t.join();
+  for( auto const & r : results )
+    BOOST_CHECK_EQUAL(r, uncached);
+  BOOST_CHECK(file_cache::stats().content_hits > 0u);
+  file_cache::enable(false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
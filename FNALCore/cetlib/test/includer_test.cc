@@ -231,4 +231,31 @@ BOOST_AUTO_TEST_CASE( highlighted_backtrace_test )
   BOOST_REQUIRE_EQUAL(j.highlighted_whereis(it), cmp);
 }
 
+BOOST_AUTO_TEST_CASE( include_graph_test )
+{
+  // Without digests, the structure alone is recorded.
+  cet::includer plain(file_k, policy);
+  BOOST_REQUIRE_EQUAL( plain.graph().nodes().size(), 6u );
+  BOOST_CHECK_EQUAL( plain.graph().changed_files().size(), 5u );
+
+  cet::includer k(file_k, policy, true);
+  auto const & nodes = k.graph().nodes();
+  BOOST_REQUIRE_EQUAL( nodes.size(), 6u );
+  BOOST_CHECK_EQUAL( nodes[0].filepath, "././k.txt" );
+  BOOST_CHECK( nodes[0].includes == std::vector<std::size_t>({ 1u, 4u }) );
+  BOOST_CHECK_EQUAL( nodes[1].filepath, "././j.txt" );
+  BOOST_CHECK( nodes[1].includes == std::vector<std::size_t>({ 2u, 3u }) );
+  BOOST_CHECK_EQUAL( nodes[5].filepath, "././a.txt" );
+  BOOST_CHECK_EQUAL( nodes[5].parent, 4u );
+  BOOST_CHECK( nodes[5].digest == nodes[2].digest );
+  BOOST_CHECK_EQUAL( k.graph().files().size(), 5u );
+  BOOST_CHECK( k.graph().depends_on("././b.txt") );
+  BOOST_CHECK( k.graph().up_to_date() );
+
+  { std::ofstream b(file_b);  b << contents_b << "more\n"; }
+  BOOST_CHECK( k.graph().changed_files() == std::vector<std::string>({ "././b.txt" }) );
+  write_files();
+  BOOST_CHECK( k.graph().up_to_date() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
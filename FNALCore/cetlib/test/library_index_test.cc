@@ -0,0 +1,150 @@
+#define BOOST_TEST_MODULE ( library_index test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/library_index.h"
+#include "cetlib/search_path.h"
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <sys/time.h>
+#include <vector>
+
+using cet::library_index;
+using std::string;
+
+namespace {
+
+  struct fixture
+  {
+    string root, dir1, dir2;
+
+    fixture( )
+    {
+      char templ[] = "/tmp/library_index_test_XXXXXX";
+      BOOST_REQUIRE(::mkdtemp(templ) != nullptr);
+      root = templ;
+      dir1 = root + "/a";
+      dir2 = root + "/b";
+      std::system(("mkdir " + dir1 + ' ' + dir2).c_str());
+      touch(dir1, "libx_y_thing.so");
+      touch(dir1, "liby_thing.so");
+      touch(dir2, "libx_y_thing.so");
+      touch(dir2, "libz_other.so");
+      library_index::clear();
+      library_index::set_cache_file("");
+    }
+
+    ~fixture( )
+    {
+      library_index::set_cache_file("");
+      std::system(("rm -rf " + root).c_str());
+    }
+
+    void
+      touch( string const & dir, string const & name )
+    { std::ofstream((dir + '/' + name).c_str()); }
+
+    // Age the directories, so their indices are no longer racy; each
+    // time to a different modification time.
+    void
+      age( )
+    {
+      static long aged = 0;
+      long const t = std::time(nullptr) - 60 + aged++;
+      struct timeval const old[2] = { { t, 0 }, { t, 0 } };
+      BOOST_REQUIRE(::utimes(dir1.c_str(), old) == 0);
+      BOOST_REQUIRE(::utimes(dir2.c_str(), old) == 0);
+    }
+
+    library_index::entry_ptr
+      get( )
+    {
+      cet::search_path const path(dir1 + ':' + dir2);
+      return library_index::get(path, "thing", "pattern",
+        [&]( library_index::entry & e ) {
+          std::vector<string> found;
+          path.find_files("lib.*_thing\\.so", found);
+          for( auto i = found.rbegin(); i != found.rend(); ++i )
+            e.lib_loc_map[i->substr(i->rfind('/') + 1u)] = *i;
+          for( auto const & lib : e.lib_loc_map )
+            e.spec_trans_map[lib.first.substr(3, lib.first.find('_') - 3u)].insert(lib.second);
+        });
+    }
+  };
+
+}
+
+BOOST_FIXTURE_TEST_SUITE( library_index_test, fixture )
+
+BOOST_AUTO_TEST_CASE( scan_and_share )
+{
+  age();
+  library_index::entry_ptr const first = get();
+  BOOST_CHECK_EQUAL(first->lib_loc_map.size(), 2u);
+  BOOST_CHECK_EQUAL(first->lib_loc_map.at("libx_y_thing.so"), dir1 + "/libx_y_thing.so");
+  BOOST_CHECK_EQUAL(first->good_spec_trans_map.size(), 2u);
+  BOOST_CHECK_EQUAL(library_index::stats().scans, 1u);
+
+  library_index::entry_ptr const second = get();
+  BOOST_CHECK(second == first);
+  BOOST_CHECK_EQUAL(library_index::stats().memory_hits, 1u);
+  BOOST_CHECK_EQUAL(library_index::stats().scans, 1u);
+}
+
+BOOST_AUTO_TEST_CASE( racy_directories )
+{
+  // Just modified: scanned every time.
+  get();
+  get();
+  BOOST_CHECK_EQUAL(library_index::stats().scans, 2u);
+  BOOST_CHECK_EQUAL(library_index::stats().memory_hits, 0u);
+}
+
+BOOST_AUTO_TEST_CASE( invalidation )
+{
+  age();
+  get();
+  touch(dir2, "libw_thing.so");
+  library_index::entry_ptr const after = get();
+  BOOST_CHECK_EQUAL(after->lib_loc_map.size(), 3u);
+  BOOST_CHECK_EQUAL(library_index::stats().scans, 2u);
+  BOOST_CHECK_EQUAL(library_index::stats().stale, 1u);
+}
+
+BOOST_AUTO_TEST_CASE( cache_file )
+{
+  string const file = root + "/index";
+  library_index::set_cache_file(file);
+  BOOST_CHECK_EQUAL(library_index::cache_file(), file);
+  age();
+  library_index::entry_ptr const scanned = get();
+
+  // As by another process.
+  library_index::clear();
+  library_index::entry_ptr const loaded = get();
+  BOOST_CHECK(loaded != scanned);
+  BOOST_CHECK(loaded->lib_loc_map == scanned->lib_loc_map);
+  BOOST_CHECK(loaded->spec_trans_map == scanned->spec_trans_map);
+  BOOST_CHECK(loaded->good_spec_trans_map == scanned->good_spec_trans_map);
+  BOOST_CHECK_EQUAL(library_index::stats().file_hits, 1u);
+  BOOST_CHECK_EQUAL(library_index::stats().scans, 0u);
+
+  // Outdated on disk.
+  library_index::clear();
+  touch(dir1, "libv_thing.so");
+  age();
+  BOOST_CHECK_EQUAL(get()->lib_loc_map.size(), 3u);
+  BOOST_CHECK_EQUAL(library_index::stats().stale, 1u);
+  library_index::clear();
+  BOOST_CHECK_EQUAL(get()->lib_loc_map.size(), 3u);
+  BOOST_CHECK_EQUAL(library_index::stats().file_hits, 1u);
+
+  // Unreadable.
+  std::ofstream(file.c_str()) << "garbage\n";
+  library_index::clear();
+  BOOST_CHECK_EQUAL(get()->lib_loc_map.size(), 3u);
+  BOOST_CHECK_EQUAL(library_index::stats().scans, 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+// ======================================================================
+//
+// map_vector_benchmark: time of building and searching cet::map_vector
+//                       and cet::soa_map_vector of 128-byte values,
+//                       against the former lookup (std::lower_bound
+//                       over the pairs, with a value made per call)
+//
+// Usage: map_vector_benchmark [entries [lookups]]
+//
+// ======================================================================
+
+#include "cetlib/map_vector.h"
+#include "cetlib/soa_map_vector.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+using cet::map_vector;
+using cet::map_vector_key;
+using cet::soa_map_vector;
+
+namespace {
+
+  typedef  std::array<double, 16>                 value_t;
+  typedef  std::pair<map_vector_key, value_t>     pair_t;
+
+  // Milliseconds taken by f.
+  double
+    measure( std::function<std::size_t ()> const & f )
+  {
+    auto const start = std::chrono::steady_clock::now();
+    std::size_t const sink = f();
+    std::chrono::duration<double, std::milli> const t = std::chrono::steady_clock::now() - start;
+    if( sink == 1u )
+      std::printf(" ");
+    return t.count();
+  }
+
+  // The lookup as map_vector made it before keys were compared alone.
+  value_t const *
+    former_find( map_vector<value_t> const & m, map_vector_key key )
+  {
+    pair_t const  v(key, value_t());
+    auto const  it = std::lower_bound( m.begin(), m.end(), v
+                                     , []( pair_t const & a, pair_t const & b )
+                                       { return a.first < b.first; } );
+    return it != m.end()  &&  it->first == key  ?  & it->second  :  nullptr;
+  }
+
+}  // namespace
+
+int
+  main( int argc, char * argv[] )
+{
+  std::size_t const n       = argc > 1 ? std::atol(argv[1]) : 1000000u;
+  std::size_t const lookups = argc > 2 ? std::atol(argv[2]) : 4000000u;
+  std::size_t const n_small = std::min<std::size_t>(n, 20000u);
+
+  // Sparse keys, on average one in four, in random order.
+  std::mt19937 rng(42);
+  std::vector<pair_t> input;
+  input.reserve(n);
+  for( unsigned k = 0;  input.size() != n;  ++k )
+    if( rng() % 4u == 0u )
+      input.emplace_back(map_vector_key(k), value_t{ { double(k) } });
+  std::shuffle(input.begin(), input.end(), rng);
+
+  std::vector<map_vector_key> probes;
+  probes.reserve(lookups);
+  unsigned const max_key = input.empty() ? 1u : 4u * n;
+  for( std::size_t i = 0;  i != lookups;  ++i )
+    probes.emplace_back(unsigned(rng() % max_key));
+
+  std::printf("%zu entries of %zu bytes, %zu lookups\n", n, sizeof(value_t), lookups);
+
+  map_vector<value_t> mv;
+  soa_map_vector<value_t> sm;
+
+  double const build_each = measure([&]{
+    map_vector<value_t> m;
+    for( std::size_t i = 0;  i != n_small;  ++i )
+      m[input[i].first] = input[i].second;
+    return m.size();
+  });
+  double const build_mv  = measure([&]{ mv.assign(input.begin(), input.end()); return mv.size(); });
+  double const build_sm  = measure([&]{ sm.assign(input.begin(), input.end()); return sm.size(); });
+
+  auto const lookup = [&]( std::function<value_t const * (map_vector_key)> const & find ) {
+    return measure([&]{
+      std::size_t found = 0u;
+      for( auto const & key : probes ) {
+        value_t const * p = find(key);
+        found += p != nullptr  &&  (*p)[0] >= 0.0;
+      }
+      return found;
+    });
+  };
+  double const find_former = lookup([&]( map_vector_key k ){ return former_find(mv, k); });
+  double const find_mv     = lookup([&]( map_vector_key k ){ return mv.getOrNull(k); });
+  double const find_sm     = lookup([&]( map_vector_key k ){ return sm.getOrNull(k); });
+
+  std::printf("build, operator[] x %zu: %10.1f ms\n", n_small, build_each);
+  std::printf("build, map_vector::assign:     %10.1f ms\n", build_mv);
+  std::printf("build, soa_map_vector::assign: %10.1f ms\n", build_sm);
+  double const per = 1e6 / double(lookups ? lookups : 1u);
+  std::printf("lookup, former map_vector:     %10.1f ns\n", find_former * per);
+  std::printf("lookup, map_vector:            %10.1f ns\n", find_mv * per);
+  std::printf("lookup, soa_map_vector:        %10.1f ns\n", find_sm * per);
+  return 0;
+}
@@ -5,6 +5,8 @@
 #include "cetlib/map_vector.h"
 #include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 using cet::map_vector;
 using cet::map_vector_key;
@@ -163,4 +165,70 @@ BOOST_AUTO_TEST_CASE( nonemptymap_test )
 
 }
 
+BOOST_AUTO_TEST_CASE( lookup_test )
+{
+  map_vector<int> m;
+  for( unsigned k = 0;  k != 1000u;  ++k )
+    m[map_vector_key(3u * (999u - k))] = k;
+  BOOST_CHECK_EQUAL( m.size(), 1000u );
+  for( unsigned k = 0;  k != 3000u;  ++k ) {
+    BOOST_CHECK_EQUAL( m.has(map_vector_key(k)), k % 3u == 0u );
+    if( k % 3u == 0u )
+      BOOST_CHECK_EQUAL( m.getOrThrow(map_vector_key(k)), int(999u - k / 3u) );
+  }
+  BOOST_CHECK( m.find(map_vector_key(3000u)) == m.end() );
+}
+
+BOOST_AUTO_TEST_CASE( assign_test )
+{
+  typedef  std::pair<map_vector_key,std::string>  pair_t;
+  std::vector<pair_t> const v
+    { pair_t(map_vector_key(7), "seven")
+    , pair_t(map_vector_key(2), "two")
+    , pair_t(map_vector_key(5), "five")
+    , pair_t(map_vector_key(2), "deux")
+    };
+
+  map_vector<std::string> m;
+  m[map_vector_key(1)] = "one";
+  m.assign(v.begin(), v.end());
+  BOOST_REQUIRE_EQUAL( m.size(), 3u );
+  BOOST_CHECK( ! m.has(map_vector_key(1)) );
+  BOOST_CHECK_EQUAL( m.begin()->first.asInt(), 2u );
+  BOOST_CHECK_EQUAL( m[map_vector_key(2)], "two" );
+  BOOST_CHECK_EQUAL( m.back().second, "seven" );
+
+  std::vector<pair_t> const bad{ pair_t(map_vector_key(), "invalid") };
+  BOOST_CHECK_THROW( m.assign(bad.begin(), bad.end()), cet::exception );
+}
+
+BOOST_AUTO_TEST_CASE( merge_test )
+{
+  typedef  std::pair<map_vector_key,int>  pair_t;
+  map_vector<int> m;
+  for( unsigned k : { 2u, 4u, 6u } )
+    m[map_vector_key(k)] = k;
+
+  std::vector<pair_t> const v
+    { pair_t(map_vector_key(5), 50)
+    , pair_t(map_vector_key(1), 10)
+    , pair_t(map_vector_key(4), 40)
+    , pair_t(map_vector_key(9), 90)
+    };
+  m.merge(v.begin(), v.end());
+  std::vector<unsigned> keys;
+  std::vector<int> values;
+  for( auto const & x : m ) {
+    keys.push_back(x.first.asInt());
+    values.push_back(x.second);
+  }
+  BOOST_CHECK( keys == (std::vector<unsigned>{ 1u, 2u, 4u, 5u, 6u, 9u }) );
+  BOOST_CHECK( values == (std::vector<int>{ 10, 2, 4, 50, 6, 90 }) );
+
+  std::vector<pair_t> const after{ pair_t(map_vector_key(11), 110) };
+  m.merge(after.begin(), after.end());
+  BOOST_CHECK_EQUAL( m.size(), 7u );
+  BOOST_CHECK_EQUAL( m.back().second, 110 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+// ======================================================================
+//
+// mapped_includer_test
+//
+// ======================================================================
+
+#define BOOST_TEST_MODULE ( mapped_includer test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/exception.h"
+#include "cetlib/filepath_maker.h"
+#include "cetlib/includer.h"
+#include "cetlib/mapped_includer.h"
+#include <fstream>
+#include <string>
+
+char const file_a[] = "./a.txt";
+char const file_b[] = "./b.txt";
+char const file_e[] = "./e.txt";
+char const file_j[] = "./j.txt";
+char const file_k[] = "./k.txt";
+char const file_n[] = "./n.txt";
+char const file_r[] = "./r.txt";
+char const file_x[] = "./x.txt";
+
+char const contents_a [] = "abcde\n"
+                           "vwxyz\n";
+char const contents_b [] = "12345\n"
+                           "67890";  // no trailing newline
+char const contents_e [] = "";
+char const contents_j [] = "begin\n"
+                           "#include \"./a.txt\"\n"
+                           "#include \"./b.txt\"\t\r\n"
+                           "end\n";
+char const contents_k [] = "begin\n"
+                           "#include \"./j.txt\"\n"
+                           "#include \"./e.txt\"\n"
+                           "middle\n"
+                           "#include \"./n.txt\"";
+char const contents_n [] = "#include \"./a.txt\"\n"
+                           "#include \"./b.txt\"\n"
+                           "last";
+char const contents_r [] = "begin\n"
+                           "#include \"./r.txt\"\n"
+                           "end\n";
+char const contents_x [] = "#include ./a.txt\"\n";
+
+BOOST_AUTO_TEST_SUITE( mapped_includer_test )
+
+void
+  write_files( )
+{
+  std::ofstream a(file_a);  a << contents_a;
+  std::ofstream b(file_b);  b << contents_b;
+  std::ofstream e(file_e);  e << contents_e;
+  std::ofstream j(file_j);  j << contents_j;
+  std::ofstream k(file_k);  k << contents_k;
+  std::ofstream n(file_n);  n << contents_n;
+  std::ofstream r(file_r);  r << contents_r;
+  std::ofstream x(file_x);  x << contents_x;
+}
+
+cet::filepath_lookup policy(".:./test");
+
+// Compare text and diagnostics against cet::includer at every position.
+void
+  check_against_includer( char const * filename, std::size_t limit )
+{
+  cet::includer ref(filename, policy);
+  cet::mapped_includer m(filename, policy, limit);
+  std::string const expected(ref.begin(), ref.end());
+
+  BOOST_REQUIRE_EQUAL( m.size(), expected.size() );
+  BOOST_REQUIRE_EQUAL( std::string(m.begin(), m.end()), expected );
+  if( m.is_contiguous() )
+    BOOST_REQUIRE_EQUAL( std::string(m.data(), m.size()), expected );
+
+  auto r = ref.begin();
+  auto it = m.begin();
+  for( std::size_t pos = 0u; pos <= expected.size(); ++pos, ++r ) {
+    BOOST_CHECK_EQUAL( m.whereis(it), ref.whereis(r) );
+    BOOST_CHECK_EQUAL( m.highlighted_whereis(it), ref.highlighted_whereis(r) );
+    if( m.is_contiguous() )
+      BOOST_CHECK_EQUAL( m.whereis(m.data() + pos), ref.whereis(r) );
+    if( pos != expected.size() )
+      ++it;
+  }
+  BOOST_CHECK( it == m.end() );
+}
+
+BOOST_AUTO_TEST_CASE( segmented_test )
+{
+  write_files();
+  for( char const * f : { file_a, file_b, file_e, file_j, file_k, file_n } ) {
+    check_against_includer(f, 0u);
+  }
+  cet::mapped_includer k(file_k, policy, 0u);
+  BOOST_CHECK( ! k.is_contiguous() );
+}
+
+BOOST_AUTO_TEST_CASE( contiguous_test )
+{
+  for( char const * f : { file_a, file_b, file_e, file_j, file_k, file_n } ) {
+    check_against_includer(f, cet::mapped_includer::default_contiguous_limit);
+  }
+  cet::mapped_includer k(file_k, policy);
+  BOOST_CHECK( k.is_contiguous() );
+  cet::mapped_includer a(file_a, policy, 0u);  // single mapping, no copy
+  BOOST_CHECK( a.is_contiguous() );
+}
+
+BOOST_AUTO_TEST_CASE( error_test )
+{
+  BOOST_CHECK_THROW( cet::mapped_includer(file_x, policy), cet::exception );
+  BOOST_CHECK_THROW( cet::mapped_includer("./missing.txt", policy), cet::exception );
+  BOOST_CHECK_EXCEPTION(cet::mapped_includer(file_r, policy), \
+                        cet::exception, \
+                        [](cet::exception const & e) -> bool \
+                        { \
+                          return e.category() == "Recursive #include directive:"; \
+                        });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// ======================================================================
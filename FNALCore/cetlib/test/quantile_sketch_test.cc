@@ -0,0 +1,145 @@
+#define BOOST_TEST_MODULE ( quantile_sketch test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/exception.h"
+#include "cetlib/quantile_sketch.h"
+#include "cpp0x/algorithm"
+#include "cpp0x/cmath"
+#include <limits>
+#include <random>
+#include <vector>
+
+using cet::quantile_sketch;
+
+namespace {
+
+  // The sample of rank q * (n - 1), rounded down, as the sketch counts.
+  double
+    exact_quantile( std::vector<double> v, double q )
+  {
+    std::sort(v.begin(), v.end());
+    return v[std::size_t(q * double(v.size() - 1u))];
+  }
+
+  std::vector<double>
+    timings( std::size_t n, unsigned seed )
+  {
+    std::mt19937  rng(seed);
+    std::lognormal_distribution<double>  timing(3.0, 1.5);
+    std::vector<double>  v(n);
+    for( auto & x : v )
+      x = timing(rng);
+    return v;
+  }
+
+  double const  qs[] = { 0.0, 0.01, 0.25, 0.5, 0.9, 0.99, 0.999, 1.0 };
+
+}
+
+BOOST_AUTO_TEST_SUITE( quantile_sketch_test )
+
+BOOST_AUTO_TEST_CASE( empty_test )
+{
+  quantile_sketch  s;
+  BOOST_CHECK_EQUAL( s.size(), 0u );
+  BOOST_CHECK_EQUAL( s.bucket_count(), 0u );
+  BOOST_CHECK( std::isnan(s.quantile(0.5)) );
+
+  s.sample(2.0);
+  BOOST_CHECK( std::isnan(s.quantile(1.5)) );
+  BOOST_CHECK_THROW( quantile_sketch(0.0), cet::exception );
+  BOOST_CHECK_THROW( quantile_sketch(0.01, 0u), cet::exception );
+}
+
+BOOST_AUTO_TEST_CASE( accuracy_test )
+{
+  std::vector<double> const  v = timings(200000u, 1u);
+  quantile_sketch  s(0.01);
+  s.sample(v.begin(), v.end());
+
+  BOOST_CHECK_EQUAL( s.size(), v.size() );
+  BOOST_CHECK( s.bucket_count() < 2048u );
+  BOOST_CHECK_EQUAL( s.quantile(0.0), s.min() );
+  BOOST_CHECK_EQUAL( s.quantile(1.0), s.max() );
+  for( double q : qs )
+    BOOST_CHECK_CLOSE( s.quantile(q), exact_quantile(v, q), 1.0 );
+}
+
+BOOST_AUTO_TEST_CASE( signs_test )
+{
+  std::vector<double>  v;
+  for( int i = -1000; i <= 1000; ++i )
+    v.push_back(i * 0.5);
+  quantile_sketch  s(0.001);
+  s.sample(v.begin(), v.end());
+
+  BOOST_CHECK_EQUAL( s.quantile(0.5), 0.0 );
+  BOOST_CHECK_EQUAL( s.quantile(0.0), -500.0 );
+  for( double q : { 0.1, 0.25, 0.75, 0.9 } )
+    BOOST_CHECK_CLOSE( s.quantile(q), exact_quantile(v, q), 0.1 );
+}
+
+BOOST_AUTO_TEST_CASE( nonfinite_test )
+{
+  double const  inf = std::numeric_limits<double>::infinity();
+  quantile_sketch  s;
+  s.sample(std::numeric_limits<double>::quiet_NaN());
+  BOOST_CHECK_EQUAL( s.size(), 0u );
+  BOOST_CHECK( std::isnan(s.quantile(0.5)) );
+
+  for( int i = 1; i <= 100; ++i )
+    s.sample(i);
+  s.sample(std::numeric_limits<double>::quiet_NaN());
+  s.sample(inf);
+  s.sample(-inf);
+
+  BOOST_CHECK_EQUAL( s.size(), 102u );
+  BOOST_CHECK_EQUAL( s.min(), -inf );
+  BOOST_CHECK_EQUAL( s.max(), inf );
+  BOOST_CHECK_EQUAL( s.quantile(0.0), -inf );
+  BOOST_CHECK_EQUAL( s.quantile(1.0), inf );
+  BOOST_CHECK( std::isfinite(s.quantile(0.999)) );
+  BOOST_CHECK_CLOSE( s.quantile(0.5), 50.0, 1.0 );  // rank 50 of -inf, 1..100, inf
+}
+
+BOOST_AUTO_TEST_CASE( merge_test )
+{
+  std::vector<double> const  v = timings(100000u, 2u);
+  quantile_sketch  serial;
+  serial.sample(v.begin(), v.end());
+
+  std::vector<quantile_sketch>  parts(4);
+  for( std::size_t i = 0; i != v.size(); ++i )
+    parts[i % 4u].sample(v[i]);
+  quantile_sketch  merged;
+  for( auto const & part : parts )
+    merged.merge(part);
+
+  BOOST_CHECK_EQUAL( merged.size(), serial.size() );
+  BOOST_CHECK_EQUAL( merged.bucket_count(), serial.bucket_count() );
+  for( double q : qs )
+    BOOST_CHECK_EQUAL( merged.quantile(q), serial.quantile(q) );
+
+  BOOST_CHECK_THROW( merged.merge(quantile_sketch(0.02)), cet::exception );
+}
+
+BOOST_AUTO_TEST_CASE( bounded_test )
+{
+  // Values spanning many decades, in few buckets: the upper quantiles
+  // keep their accuracy.
+  std::vector<double>  v;
+  for( int i = 0; i != 100000; ++i )
+    v.push_back(std::pow(10.0, -9.0 + 13.0 * i / 100000.0));
+  quantile_sketch  s(0.01, 256u);
+  s.sample(v.begin(), v.end());
+
+  BOOST_CHECK( s.bucket_count() <= 256u );
+  for( double q : { 0.9, 0.99, 0.999 } )
+    BOOST_CHECK_CLOSE( s.quantile(q), exact_quantile(v, q), 1.0 );
+
+  s.reset();
+  BOOST_CHECK_EQUAL( s.size(), 0u );
+  BOOST_CHECK_EQUAL( s.bucket_count(), 0u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
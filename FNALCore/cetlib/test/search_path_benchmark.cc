@@ -0,0 +1,88 @@
+// ======================================================================
+//
+// search_path_benchmark: time of cet::search_path::find_files() and
+//                        find_file(), with and without cached listings,
+//                        over a synthetic path of 50 directories of 200
+//                        files each
+//
+// Usage: search_path_benchmark [repetitions]
+//
+// ======================================================================
+
+#include "cetlib/search_path.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using cet::search_path;
+
+namespace {
+
+  std::size_t const  n_dirs  = 50u;
+  std::size_t const  n_files = 200u;
+
+  // Microseconds per call of f.
+  double
+    measure( std::size_t reps, std::function<std::size_t ()> const & f )
+  {
+    std::size_t sink = 0u;
+    auto const start = std::chrono::steady_clock::now();
+    for( std::size_t i = 0; i != reps; ++i )
+      sink += f();
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    if( sink == 1u )
+      std::printf(" ");
+    return 1e6 * t.count() / reps;
+  }
+
+}  // namespace
+
+int
+  main( int argc, char * argv[] )
+{
+  std::size_t const reps = argc > 1 ? std::atol(argv[1]) : 200u;
+
+  char templ[] = "/tmp/search_path_benchmark_XXXXXX";
+  if( ::mkdtemp(templ) == nullptr )
+    return 1;
+  std::string const root = templ;
+  std::string path;
+  for( std::size_t d = 0; d != n_dirs; ++d ) {
+    std::string const dir = root + "/d" + std::to_string(d);
+    std::system(("mkdir " + dir).c_str());
+    for( std::size_t f = 0; f != n_files; ++f ) {
+      std::string const stem = "lib" + std::to_string(d) + "_" + std::to_string(f);
+      std::ofstream((dir + '/' + stem + (f % 4u ? ".txt" : "_plugin.so")).c_str());
+    }
+    path += (d ? ":" : "") + dir;
+  }
+  std::string const last = "lib" + std::to_string(n_dirs - 1u) + "_1.txt";
+
+  std::printf("%-10s %12s %12s %12s\n"
+             , "listing", "find_files", "find_file", "miss");
+  for( int cached = 0; cached != 2; ++cached ) {
+    search_path const sp(path, cached ? search_path::cached_listing
+                                      : search_path::uncached_listing);
+    std::vector<std::string> out;
+    std::string found;
+    double const files = measure(reps, [&]{
+      out.clear();
+      return sp.find_files("lib([-A-Za-z0-9]*_)*[A-Za-z0-9]+_plugin\\.so", out);
+    });
+    double const hit  = measure(reps * 10u, [&]{ return std::size_t(sp.find_file(last, found)); });
+    double const miss = measure(reps * 10u, [&]{ return std::size_t(sp.find_file("missing.txt", found)); });
+    std::printf("%-10s %10.1fus %10.1fus %10.1fus\n"
+               , cached ? "cached" : "uncached", files, hit, miss);
+  }
+
+  std::system(("rm -rf " + root).c_str());
+  return 0;
+}
+
+// ======================================================================
@@ -0,0 +1,165 @@
+#define BOOST_TEST_MODULE ( search_path_test_4 test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/detail/filename_matcher.h"
+#include "cetlib/search_path.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using cet::detail::filename_matcher;
+using cet::search_path;
+using std::string;
+
+namespace {
+
+  struct fixture
+  {
+    string root, dir1, dir2;
+
+    fixture( )
+    {
+      char templ[] = "/tmp/search_path_test_4_XXXXXX";
+      BOOST_REQUIRE(::mkdtemp(templ) != nullptr);
+      root = templ;
+      dir1 = root + "/a";
+      dir2 = root + "/b";
+      std::system(("mkdir -p " + dir1 + "/sub " + dir2).c_str());
+      touch(dir1, "libx_y_plugin.so");
+      touch(dir1, "sub/nested.txt");
+      touch(dir2, "libx_y_plugin.so");
+      touch(dir2, "libz_plugin.so");
+      touch(dir2, "notes.txt");
+      BOOST_REQUIRE(::symlink("nowhere", (dir2 + "/dangling").c_str()) == 0);
+      search_path::clear_listings();
+      search_path::set_listing_ttl(std::chrono::milliseconds(0));
+    }
+
+    ~fixture( )
+    {
+      search_path::set_listing_ttl(std::chrono::milliseconds(1000));
+      search_path::clear_listings();
+      std::system(("rm -rf " + root).c_str());
+    }
+
+    void
+      touch( string const & dir, string const & name )
+    { std::ofstream((dir + '/' + name).c_str()); }
+
+    std::vector<string>
+      sorted_matches( search_path const & sp, string const & pattern )
+    {
+      std::vector<string> result;
+      sp.find_files(pattern, result);
+      std::sort(result.begin(), result.end());
+      return result;
+    }
+  };
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE ( search_path_test_4 )
+
+BOOST_AUTO_TEST_CASE( matcher_literals )
+{
+  filename_matcher const m("lib([-A-Za-z0-9]*_)*[A-Za-z0-9]+_plugin\\.so");
+  BOOST_CHECK_EQUAL(m.prefix(), "lib");
+  BOOST_CHECK_EQUAL(m.suffix(), "_plugin.so");
+  BOOST_CHECK(! m.literal());
+  BOOST_CHECK(m("libx_y_plugin.so"));
+  BOOST_CHECK(m("libz_plugin.so"));
+  BOOST_CHECK(! m("libz_plugin.so.1"));
+  BOOST_CHECK(! m("lib_plugin.so"));
+  BOOST_CHECK(! m("x"));
+
+  filename_matcher const lit("^notes\\.txt$");
+  BOOST_CHECK(lit.literal());
+  BOOST_CHECK(lit("notes.txt"));
+  BOOST_CHECK(! lit("notesXtxt"));
+  BOOST_CHECK(! lit("notes.txt~"));
+}
+
+BOOST_AUTO_TEST_CASE( matcher_quantifiers )
+{
+  filename_matcher const opt("ab?c.*d");
+  BOOST_CHECK_EQUAL(opt.prefix(), "a");
+  BOOST_CHECK_EQUAL(opt.suffix(), "d");
+  BOOST_CHECK(opt("acd"));
+  BOOST_CHECK(opt("abcxd"));
+
+  filename_matcher const plus("a+");
+  BOOST_CHECK_EQUAL(plus.prefix(), "a");
+  BOOST_CHECK_EQUAL(plus.suffix(), "");
+  BOOST_CHECK(plus("a"));
+  BOOST_CHECK(plus("aaa"));
+  BOOST_CHECK(! plus(""));
+
+  filename_matcher const esc("\\x41\\d[.]z{2}");
+  BOOST_CHECK_EQUAL(esc.prefix(), "");
+  BOOST_CHECK_EQUAL(esc.suffix(), "");
+  BOOST_CHECK(esc("A1.zz"));
+
+  filename_matcher const alt("abc|xyz");
+  BOOST_CHECK_EQUAL(alt.prefix(), "");
+  BOOST_CHECK_EQUAL(alt.suffix(), "");
+  BOOST_CHECK(alt("xyz"));
+  BOOST_CHECK(! alt("abcxyz"));
+}
+
+BOOST_AUTO_TEST_CASE( matcher_cache )
+{
+  BOOST_CHECK(filename_matcher::get("a.*b") == filename_matcher::get("a.*b"));
+  BOOST_CHECK(filename_matcher::get("a.*b") != filename_matcher::get("a.*c"));
+}
+
+BOOST_FIXTURE_TEST_CASE( cached_agrees_with_uncached, fixture )
+{
+  search_path const uncached(dir1 + ':' + dir2);
+  search_path const cached(dir1 + ':' + dir2, search_path::cached_listing);
+
+  char const * const patterns[]
+    = { ".*_plugin\\.so", "libz_plugin\\.so", ".*\\.txt", "nothing", ".*" };
+  for( char const * p : patterns )
+    BOOST_CHECK(sorted_matches(cached, p) == sorted_matches(uncached, p));
+
+  char const * const files[]
+    = { "libx_y_plugin.so", "libz_plugin.so", "notes.txt", "sub/nested.txt"
+      , "sub", "dangling", "missing", "sub/missing", "missing/x", "." };
+  for( char const * f : files ) {
+    string a, b;
+    BOOST_CHECK_EQUAL(cached.find_file(f, a), uncached.find_file(f, b));
+    BOOST_CHECK_EQUAL(a, b);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( cached_sees_changes, fixture )
+{
+  search_path const cached(dir1 + ':' + dir2, search_path::cached_listing);
+  string found;
+  BOOST_CHECK(! cached.find_file("new.txt", found));
+  touch(dir2, "new.txt");
+  BOOST_CHECK(cached.find_file("new.txt", found));
+  BOOST_CHECK_EQUAL(found, dir2 + "/new.txt");
+  std::remove((dir2 + "/new.txt").c_str());
+  BOOST_CHECK(! cached.find_file("new.txt", found));
+}
+
+BOOST_FIXTURE_TEST_CASE( cached_within_ttl, fixture )
+{
+  search_path::set_listing_ttl(std::chrono::hours(1));
+  BOOST_CHECK(search_path::listing_ttl() == std::chrono::hours(1));
+  search_path const cached(dir2 + ':', search_path::cached_listing);
+  string found;
+  BOOST_CHECK(! cached.find_file("new.txt", found));
+  touch(dir2, "new.txt");
+  BOOST_CHECK(! cached.find_file("new.txt", found));
+  search_path::clear_listings();
+  BOOST_CHECK(cached.find_file("new.txt", found));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
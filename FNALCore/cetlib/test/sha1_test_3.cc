@@ -0,0 +1,120 @@
+#define BOOST_TEST_MODULE ( sha1 implementations test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/sha1.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using cet::sha1;
+using std::string;
+
+namespace {
+
+  string
+    hex( sha1::digest_t const & d )
+  {
+    string result;
+    char buf[3];
+    for( auto c : d ) {
+      std::snprintf(buf, sizeof buf, "%02x", unsigned(c));
+      result += buf;
+    }
+    return result;
+  }
+
+  // The digest of mesg, fed in pieces of at most step characters.
+  string
+    digest_of( string const & mesg, std::size_t step )
+  {
+    sha1 s;
+    for( std::size_t i = 0; i < mesg.size(); i += step )
+      s << mesg.substr(i, step);
+    return hex(s.digest());
+  }
+
+  // Runs check() with each implementation the CPU supports in turn.
+  template< class F >
+  void
+    for_each_implementation( F check )
+  {
+    string const original = sha1::implementation();
+    for( string const & name : sha1::implementations() ) {
+      BOOST_TEST_MESSAGE("implementation: " << name);
+      BOOST_REQUIRE(sha1::use_implementation(name));
+      BOOST_REQUIRE_EQUAL(sha1::implementation(), name);
+      check(name);
+    }
+    BOOST_REQUIRE(sha1::use_implementation(original));
+  }
+
+}
+
+BOOST_AUTO_TEST_SUITE( sha1_test_3 )
+
+BOOST_AUTO_TEST_CASE( selection )
+{
+  std::vector<string> const names = sha1::implementations();
+  BOOST_REQUIRE(! names.empty());
+  BOOST_CHECK_EQUAL(names.back(), "portable");
+  BOOST_CHECK(! sha1::use_implementation("no such implementation"));
+  for( char const * name : { "shani", "avx2", "ssse3" } )
+    if( std::find(names.begin(), names.end(), name) == names.end() )
+      BOOST_TEST_MESSAGE(name << " is not supported by this CPU; not tested.");
+}
+
+BOOST_AUTO_TEST_CASE( fips_vectors )
+{
+  for_each_implementation([]( string const & ) {
+    BOOST_CHECK_EQUAL( digest_of("", 1u)
+                     , "da39a3ee5e6b4b0d3255bfef95601890afd80709" );
+    BOOST_CHECK_EQUAL( digest_of("abc", 1u)
+                     , "a9993e364706816aba3e25717850c26c9cd0d89d" );
+    BOOST_CHECK_EQUAL( digest_of("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 7u)
+                     , "84983e441c3bd26ebaae4aa1f95129e5e54670f1" );
+    BOOST_CHECK_EQUAL( digest_of(string(1000000, 'a'), 100000u)
+                     , "34aa973cd4c4daa4f61eeb2bdbad27316534016f" );
+  });
+}
+
+BOOST_AUTO_TEST_CASE( agreement )
+{
+  // Every length up to a few blocks, and longer messages, each fed
+  // whole and in pieces straddling the block boundaries.
+  std::mt19937 rng(5u);
+  std::vector<string> mesgs;
+  for( std::size_t size = 0; size != 300u; ++size ) {
+    string m(size, '\0');
+    for( char & c : m )
+      c = char(rng());
+    mesgs.push_back(m);
+  }
+  for( std::size_t size : { 1000u, 4096u, 65537u } )
+    mesgs.push_back(string(size, char(size)));
+
+  std::vector<string> expected;
+  BOOST_REQUIRE(sha1::use_implementation("portable"));
+  for( string const & m : mesgs )
+    expected.push_back(digest_of(m, m.size() + 1u));
+
+  for_each_implementation([&]( string const & ) {
+    for( std::size_t i = 0; i != mesgs.size(); ++i )
+      for( std::size_t step : { mesgs[i].size() + 1u, std::size_t(1u), std::size_t(63u), std::size_t(65u), std::size_t(129u) } )
+        BOOST_REQUIRE_EQUAL(digest_of(mesgs[i], step), expected[i]);
+  });
+}
+
+BOOST_AUTO_TEST_CASE( reuse )
+{
+  for_each_implementation([]( string const & ) {
+    sha1 s("abc");
+    string const first = hex(s.digest());
+    s.reset();
+    s << 'a' << 'b' << 'c';
+    BOOST_CHECK_EQUAL(hex(s.digest()), first);
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,12 +1,23 @@
+// ======================================================================
+//
+// sha1_test_performance: throughput, in MB/s, of each implementation of
+//                        cet::sha1 this CPU supports, and of the
+//                        reference SHA1 of sha1.cpp, for messages of
+//                        several sizes
+//
+// Usage: sha1_test_performance [megabytes per measurement]
+//
+// ======================================================================
+
 #include "cetlib/sha1.h"
+#include "sha1.h"
+
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
-
-#include "sha1.h"
-
-#define TESTA  "abc"
-#define TESTB  "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"
 #define TESTC  "\
 1 First God made heaven & earth \
 2 The earth was without form and void, and darkness was upon the face of the deep; and the Spirit of God was moving over the face of the waters. \
@@ -43,62 +54,65 @@
 
 using cet::sha1;
 
-#include <stdio.h>
-#include <sys/time.h>
-
-int
-  main( )
-{
-  typedef  sha1::digest_t  digest_t;
+namespace {
 
+  // MB/s of hash(mesg), repeated to hash about megabytes in all.
+  template< class F >
+  double
+    throughput( std::string const & mesg, double megabytes, F hash )
   {
-    timeval start, end;
-    long long int start_;
-    long long int end_;
-
-// =====================================
-
-    gettimeofday(&start, NULL);
-
-    fhicl::SHA1 s;
-    unsigned r[5];
-    for(int i=0; i<10000; ++i) {
-      s.Reset();
-      s << TESTC;
-      s.Result(r);
-    }
-
-    gettimeofday(&end, NULL);
-
-    start_ = start.tv_sec*1000000 + start.tv_usec;
-    end_   = end.tv_sec*1000000 + end.tv_usec;
-    printf( "Reference SHA1 %gs for 10,000 SHA1 calculations\n"
-          , (end_ - start_) / 1000000.0);
-
-// =====================================
-
-    gettimeofday(&start, NULL);
-
-    sha1 c;
-    digest_t d;
-
-    for(int i=0; i<10000; ++i) {
-      c.reset();
-      c << TESTC;
-      d = c.digest();
-    }
-
-    gettimeofday(&end, NULL);
-
-    start_ = start.tv_sec*1000000 + start.tv_usec;
-    end_   = end.tv_sec*1000000 + end.tv_usec;
-    printf( "cet::SHA1 %gs for 10,000 SHA calcuations\n"
-          , (end_ - start_) / 1000000.0);
+    std::size_t const n = std::size_t(megabytes * 1e6 / mesg.size()) + 1u;
+    unsigned sink = 0u;
+    auto const start = std::chrono::steady_clock::now();
+    for( std::size_t i = 0; i != n; ++i )
+      sink += hash(mesg);
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    if( sink == 1u )
+      std::printf(" ");
+    return 1e-6 * double(n) * mesg.size() / t.count();
+  }
 
-// =====================================
+}
 
+int
+  main( int argc, char * argv[] )
+{
+  double const megabytes = argc > 1 ? std::atof(argv[1]) : 200.;
+
+  std::vector<std::pair<std::string, std::string>> mesgs;
+  mesgs.emplace_back("55 B", std::string(55, 'x'));
+  mesgs.emplace_back("Genesis", TESTC);
+  mesgs.emplace_back("64 KiB", std::string(65536, 'x'));
+  mesgs.emplace_back("1 MiB", std::string(1 << 20, 'x'));
+
+  std::printf("%-12s", "MB/s");
+  for( auto const & m : mesgs )
+    std::printf("%12s", m.first.c_str());
+  std::printf("\n");
+
+  std::printf("%-12s", "reference");
+  for( auto const & m : mesgs )
+    std::printf( "%12.1f"
+               , throughput(m.second, megabytes / 10., []( std::string const & s ) {
+                   fhicl::SHA1 ref;
+                   unsigned r[5];
+                   ref.Input(s.data(), unsigned(s.size()));
+                   ref.Result(r);
+                   return r[0];
+                 }) );
+  std::printf("\n");
+
+  std::string const original = sha1::implementation();
+  for( std::string const & name : sha1::implementations() ) {
+    sha1::use_implementation(name);
+    std::printf("%-12s", name.c_str());
+    for( auto const & m : mesgs )
+      std::printf( "%12.1f"
+                 , throughput(m.second, megabytes, []( std::string const & s ) {
+                     return unsigned(sha1(s).digest()[0]);
+                   }) );
+    std::printf("%s\n", name == original ? "  (default)" : "");
   }
-
   return 0;
 
 }  // main()
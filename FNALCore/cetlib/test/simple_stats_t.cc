@@ -3,6 +3,8 @@
 
 #include "cetlib/simple_stats.h"
 #include "cpp0x/cmath"
+#include <random>
+#include <vector>
 
 using cet::simple_stats;
 
@@ -56,4 +58,53 @@ BOOST_AUTO_TEST_CASE( sample_test )
   BOOST_CHECK_EQUAL( s.mean(), 0.0 );
 }
 
+BOOST_AUTO_TEST_CASE( stability_test )
+{
+  // A long series with a small spread about a large mean: the rms of
+  // sumsq/n - mean^2 would be lost to cancellation.
+  simple_stats  s;
+  for( int i = 0; i != 1000000; ++i )
+    s.sample(1e9 + (i % 2 ? 1.0 : -1.0));
+
+  BOOST_CHECK_CLOSE( s.mean(), 1e9, 1e-12 );
+  BOOST_CHECK_CLOSE( s.rms(0u), 1.0, 1e-6 );
+  BOOST_CHECK_CLOSE( s.rms(), 1.0, 1e-3 );
+}
+
+BOOST_AUTO_TEST_CASE( merge_test )
+{
+  std::mt19937  rng(1234);
+  std::lognormal_distribution<double>  timing(3.0, 1.5);
+  std::vector<double>  v(100001);
+  for( auto & x : v )
+    x = timing(rng);
+
+  simple_stats  serial;
+  serial.sample(v.begin(), v.end());
+
+  // Per-"thread" accumulators of unequal sizes, one of them empty.
+  std::vector<simple_stats>  parts(5);
+  std::size_t const  bounds[] = { 0u, 7u, 30000u, 30000u, 81234u, v.size() };
+  for( std::size_t p = 0; p != parts.size(); ++p )
+    parts[p].sample(v.begin() + bounds[p], v.begin() + bounds[p + 1]);
+  simple_stats  merged;
+  for( auto const & part : parts )
+    merged.merge(part);
+
+  BOOST_CHECK_EQUAL( merged.size(), serial.size() );
+  BOOST_CHECK_EQUAL( merged.min(), serial.min() );
+  BOOST_CHECK_EQUAL( merged.max(), serial.max() );
+  BOOST_CHECK_EQUAL( merged.small(), serial.small() );
+  BOOST_CHECK_CLOSE( merged.sum(), serial.sum(), 1e-10 );
+  BOOST_CHECK_CLOSE( merged.sumsq(), serial.sumsq(), 1e-10 );
+  BOOST_CHECK_CLOSE( merged.mean(), serial.mean(), 1e-10 );
+  BOOST_CHECK_CLOSE( merged.rms(), serial.rms(), 1e-10 );
+  BOOST_CHECK_CLOSE( merged.rms0(), serial.rms0(), 1e-10 );
+  BOOST_CHECK_CLOSE( merged.err_rms(), serial.err_rms(), 1e-10 );
+
+  simple_stats  empty;
+  merged.merge(empty);
+  BOOST_CHECK_EQUAL( merged.size(), serial.size() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+#define BOOST_TEST_MODULE ( soa_map_vector test )
+
+#include "boost/test/auto_unit_test.hpp"
+#include "cetlib/map_vector.h"
+#include "cetlib/soa_map_vector.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using cet::map_vector;
+using cet::map_vector_key;
+using cet::soa_map_vector;
+
+BOOST_AUTO_TEST_SUITE( soa_map_vector_test )
+
+BOOST_AUTO_TEST_CASE( emptymap_test )
+{
+  map_vector_key k(3);
+  soa_map_vector<int> const m;
+  BOOST_CHECK( m.empty() );
+  BOOST_CHECK( m.size() == 0u );
+  BOOST_CHECK( ! m.has(k) );
+  BOOST_CHECK( m.index(k) == m.size() );
+  BOOST_CHECK( m.getOrNull(k) == 0 );
+  BOOST_CHECK_THROW( m.getOrThrow(k), cet::exception );
+}
+
+BOOST_AUTO_TEST_CASE( same_as_map_vector_test )
+{
+  map_vector<int> mv;
+  soa_map_vector<int> sm;
+  for( unsigned k = 0;  k != 1000u;  ++k ) {
+    map_vector_key const key((k * 7919u) % 3001u);
+    mv[key] = k;
+    sm[key] = k;
+  }
+  BOOST_REQUIRE_EQUAL( sm.size(), mv.size() );
+  BOOST_CHECK_EQUAL( sm.delta(), mv.delta() );
+  for( unsigned k = 0;  k != 3100u;  ++k ) {
+    map_vector_key const key(k);
+    BOOST_CHECK_EQUAL( sm.has(key), mv.has(key) );
+    if( mv.has(key) )
+      BOOST_CHECK_EQUAL( sm.at(key), mv.at(key) );
+  }
+
+  soa_map_vector<int> const copy(mv);
+  BOOST_CHECK( copy.keys() == sm.keys() );
+  BOOST_CHECK( copy.values() == sm.values() );
+}
+
+BOOST_AUTO_TEST_CASE( bulk_test )
+{
+  typedef  std::pair<map_vector_key,std::string>  pair_t;
+  std::vector<pair_t> const v
+    { pair_t(map_vector_key(7), "seven")
+    , pair_t(map_vector_key(2), "two")
+    , pair_t(map_vector_key(5), "five")
+    , pair_t(map_vector_key(2), "deux")
+    };
+  soa_map_vector<std::string> m(v.begin(), v.end());
+  BOOST_REQUIRE_EQUAL( m.size(), 3u );
+  BOOST_CHECK_EQUAL( m[map_vector_key(2)], "two" );
+  BOOST_CHECK_EQUAL( m.values().back(), "seven" );
+
+  std::vector<pair_t> const w
+    { pair_t(map_vector_key(9), "nine")
+    , pair_t(map_vector_key(5), "cinq")
+    , pair_t(map_vector_key(1), "one")
+    };
+  m.merge(w.begin(), w.end());
+  BOOST_CHECK( m.values() == (std::vector<std::string>{ "one", "two", "five", "seven", "nine" }) );
+  BOOST_CHECK_EQUAL( m.keys()[3].asInt(), 7u );
+
+  m.push_back(pair_t(map_vector_key(0), "ten"));
+  BOOST_CHECK_EQUAL( m.at(map_vector_key(10)), "ten" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,9 @@ BOOST_AUTO_TEST_CASE( signed_test )
   BOOST_CHECK_THROW( ston<int      >("1X"), invalid_argument );
   BOOST_CHECK_THROW( ston<long     >("Y2"), invalid_argument );
   BOOST_CHECK_THROW( ston<long long>("3."), invalid_argument );
+  BOOST_CHECK_THROW( ston<int      >("++5"), invalid_argument );
+  BOOST_CHECK_THROW( ston<int      >("+-5"), invalid_argument );
+  BOOST_CHECK_THROW( ston<int      >("1e3"), invalid_argument );
 }
 
 BOOST_AUTO_TEST_CASE( unsigned_test )
@@ -42,6 +45,13 @@ BOOST_AUTO_TEST_CASE( floating_test )
   BOOST_CHECK_THROW( ston<float      >("21.X"), invalid_argument );
   BOOST_CHECK_THROW( ston<double     >("2Y." ), invalid_argument );
   BOOST_CHECK_THROW( ston<long double>("Z3." ), invalid_argument );
+  BOOST_CHECK_EQUAL( ston<double     >("+5" ), 5. );
+  BOOST_CHECK_THROW( ston<float      >("++5"), invalid_argument );
+  BOOST_CHECK_THROW( ston<double     >("++5"), invalid_argument );
+  BOOST_CHECK_THROW( ston<long double>("++5"), invalid_argument );
+  BOOST_CHECK_THROW( ston<float      >("+-5"), invalid_argument );
+  BOOST_CHECK_THROW( ston<double     >("+-5"), invalid_argument );
+  BOOST_CHECK_THROW( ston<long double>("+-5"), invalid_argument );
 }
 
 BOOST_AUTO_TEST_SUITE_END()
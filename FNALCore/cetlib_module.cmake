@@ -16,43 +16,58 @@ set(cetlib_PUBLIC_HDRS
   ${cetlib_INCLUDE_DIR}/bit_manipulation.h
   ${cetlib_INCLUDE_DIR}/canonical_number.h
   ${cetlib_INCLUDE_DIR}/canonical_string.h
+  ${cetlib_INCLUDE_DIR}/charconv.h
   ${cetlib_INCLUDE_DIR}/coded_exception.h
   ${cetlib_INCLUDE_DIR}/column_width.h
+  ${cetlib_INCLUDE_DIR}/concurrent_registry.h
+  ${cetlib_INCLUDE_DIR}/concurrent_registry_via_id.h
   ${cetlib_INCLUDE_DIR}/container_algorithms.h
   ${cetlib_INCLUDE_DIR}/cpu_timer.h
   ${cetlib_INCLUDE_DIR}/crc32.h
+  ${cetlib_INCLUDE_DIR}/crc32c.h
   ${cetlib_INCLUDE_DIR}/demangle.h
+  ${cetlib_INCLUDE_DIR}/digest_file.h
   ${cetlib_INCLUDE_DIR}/exception_collector.h
   ${cetlib_INCLUDE_DIR}/exception.h
   ${cetlib_INCLUDE_DIR}/exempt_ptr.h
+  ${cetlib_INCLUDE_DIR}/file_cache.h
+  ${cetlib_INCLUDE_DIR}/file_watcher.h
   ${cetlib_INCLUDE_DIR}/filepath_maker.h
   ${cetlib_INCLUDE_DIR}/filesystem.h
   ${cetlib_INCLUDE_DIR}/getenv.h
   ${cetlib_INCLUDE_DIR}/hard_cast.h
   ${cetlib_INCLUDE_DIR}/hypot.h
   ${cetlib_INCLUDE_DIR}/include.h
+  ${cetlib_INCLUDE_DIR}/include_graph.h
   ${cetlib_INCLUDE_DIR}/includer.h
+  ${cetlib_INCLUDE_DIR}/mapped_includer.h
   ${cetlib_INCLUDE_DIR}/LibraryManager.h
+  ${cetlib_INCLUDE_DIR}/library_index.h
   ${cetlib_INCLUDE_DIR}/lpad.h
   ${cetlib_INCLUDE_DIR}/make_unique.h
   ${cetlib_INCLUDE_DIR}/map_vector.h
   ${cetlib_INCLUDE_DIR}/maybe_ref.h
   ${cetlib_INCLUDE_DIR}/md5.h
+  ${cetlib_INCLUDE_DIR}/md5_batch.h
   ${cetlib_INCLUDE_DIR}/name_of.h
   ${cetlib_INCLUDE_DIR}/ntos.h
   ${cetlib_INCLUDE_DIR}/nybbler.h
   ${cetlib_INCLUDE_DIR}/PluginFactory.h
   ${cetlib_INCLUDE_DIR}/PluginTypeDeducer.h
   ${cetlib_INCLUDE_DIR}/pow.h
+  ${cetlib_INCLUDE_DIR}/quantile_sketch.h
   ${cetlib_INCLUDE_DIR}/registry.h
   ${cetlib_INCLUDE_DIR}/registry_via_id.h
   ${cetlib_INCLUDE_DIR}/rpad.h
   ${cetlib_INCLUDE_DIR}/search_path.h
   ${cetlib_INCLUDE_DIR}/sha1.h
+  ${cetlib_INCLUDE_DIR}/sha1_batch.h
   ${cetlib_INCLUDE_DIR}/shlib_utils.h
   ${cetlib_INCLUDE_DIR}/simple_stats.h
+  ${cetlib_INCLUDE_DIR}/soa_map_vector.h
   ${cetlib_INCLUDE_DIR}/split.h
   ${cetlib_INCLUDE_DIR}/split_path.h
+  ${cetlib_INCLUDE_DIR}/StaticPluginRegistry.h
   ${cetlib_INCLUDE_DIR}/ston.h
   ${cetlib_INCLUDE_DIR}/trim.h
   ${cetlib_INCLUDE_DIR}/value_ptr.h
@@ -60,6 +75,12 @@ set(cetlib_PUBLIC_HDRS
   )
 
 set(cetlib_DETAIL_HDRS
+  ${cetlib_INCLUDE_DIR}/detail/crc32_kernels.h
+  ${cetlib_INCLUDE_DIR}/detail/filename_matcher.h
+  ${cetlib_INCLUDE_DIR}/detail/implementation_choice.h
+  ${cetlib_INCLUDE_DIR}/detail/multibuffer.h
+  ${cetlib_INCLUDE_DIR}/detail/sharded_map.h
+  ${cetlib_INCLUDE_DIR}/detail/update_range.h
   ${cetlib_INCLUDE_DIR}/detail/wrapLibraryManagerException.h
   )
 
@@ -72,6 +93,7 @@ set(cetlib_SSL_HDRS
 
 set(cetlib_SRCS
   ${CMAKE_CURRENT_BINARY_DIR}/shlib_utils.cc
+  ${cetlib_INCLUDE_DIR}/detail/filename_matcher.cc
   ${cetlib_INCLUDE_DIR}/detail/wrapLibraryManagerException.cc
   ${cetlib_ROOT_DIR}/polarssl/md5.cc
   ${cetlib_ROOT_DIR}/polarssl/sha1.cc
@@ -79,25 +101,38 @@ set(cetlib_SRCS
   ${cetlib_INCLUDE_DIR}/BasicPluginFactory.cc
   ${cetlib_INCLUDE_DIR}/canonical_number.cc
   ${cetlib_INCLUDE_DIR}/canonical_string.cc
+  ${cetlib_INCLUDE_DIR}/charconv.cc
   ${cetlib_INCLUDE_DIR}/cpu_timer.cc
   ${cetlib_INCLUDE_DIR}/crc32.cc
+  ${cetlib_INCLUDE_DIR}/crc32c.cc
   ${cetlib_INCLUDE_DIR}/demangle.cc
+  ${cetlib_INCLUDE_DIR}/digest_file.cc
   ${cetlib_INCLUDE_DIR}/exception.cc
   ${cetlib_INCLUDE_DIR}/exception_collector.cc
+  ${cetlib_INCLUDE_DIR}/file_cache.cc
+  ${cetlib_INCLUDE_DIR}/file_watcher.cc
   ${cetlib_INCLUDE_DIR}/filepath_maker.cc
   ${cetlib_INCLUDE_DIR}/filesystem.cc
   ${cetlib_INCLUDE_DIR}/getenv.cc
   ${cetlib_INCLUDE_DIR}/inc-expand.cc
   ${cetlib_INCLUDE_DIR}/include.cc
+  ${cetlib_INCLUDE_DIR}/include_graph.cc
   ${cetlib_INCLUDE_DIR}/includer.cc
+  ${cetlib_INCLUDE_DIR}/mapped_includer.cc
   ${cetlib_INCLUDE_DIR}/LibraryManager.cc
+  ${cetlib_INCLUDE_DIR}/library_index.cc
   ${cetlib_INCLUDE_DIR}/lpad.cc
+  ${cetlib_INCLUDE_DIR}/md5_batch.cc
   ${cetlib_INCLUDE_DIR}/nybbler.cc
   ${cetlib_INCLUDE_DIR}/PluginFactory.cc
+  ${cetlib_INCLUDE_DIR}/quantile_sketch.cc
   ${cetlib_INCLUDE_DIR}/rpad.cc
   ${cetlib_INCLUDE_DIR}/search_path.cc
+  ${cetlib_INCLUDE_DIR}/sha1.cc
+  ${cetlib_INCLUDE_DIR}/sha1_batch.cc
   ${cetlib_INCLUDE_DIR}/simple_stats.cc
   ${cetlib_INCLUDE_DIR}/split_path.cc
+  ${cetlib_INCLUDE_DIR}/StaticPluginRegistry.cc
   )
 
 include_directories(${CMAKE_CURRENT_SOURCE_DIR})
@@ -0,0 +1,458 @@
+// ======================================================================
+//
+// fhiclcpp_benchmarks: timings of the fhiclcpp hot paths on synthetic
+//                      documents and on the checked-in configurations
+//                      of configs/, written as JSON
+//
+// Usage: fhiclcpp_benchmarks [-o file] [--configs dir] [--filter text]
+//                            [--min-time seconds] [--repetitions n]
+//
+// Each benchmark is run in batches of a calibrated number of
+// iterations, each batch lasting at least --min-time; the minimum and
+// median time per operation over --repetitions batches are reported.
+// Benchmarks whose name or configuration does not contain --filter are
+// skipped. Progress is written to stderr, the JSON document to stdout
+// or to -o.
+//
+// The registry benchmarks act on the one ParameterSetRegistry of the
+// process, which accumulates the ParameterSets of every configuration
+// measured so far; each of their results records its size.
+//
+// ======================================================================
+
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/ParameterSetID.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/intermediate_table.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "fhiclcpp/parse.h"
+
+#include "sqlite3.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef FHICLCPP_BENCHMARKS_CONFIG_DIR
+#define FHICLCPP_BENCHMARKS_CONFIG_DIR "."
+#endif
+
+#ifndef FNALCORE_VERSION
+#define FNALCORE_VERSION "unknown"
+#endif
+
+using namespace fhicl;
+
+namespace {
+
+  // ----------------------------------------------------------------------
+  // Options.
+
+  struct options
+  {
+    std::string output;
+    std::string configs = FHICLCPP_BENCHMARKS_CONFIG_DIR;
+    std::string filter;
+    double      min_time = 0.05;
+    unsigned    repetitions = 5u;
+  };
+
+  void
+  usage(char const * self)
+  {
+    std::cerr << "Usage: " << self
+              << " [-o file] [--configs dir] [--filter text]"
+                 " [--min-time seconds] [--repetitions n]\n";
+    std::exit(2);
+  }
+
+  options
+  parse_options(int argc, char * argv[])
+  {
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+      std::string const arg = argv[i];
+      if (i + 1 == argc) { usage(argv[0]); }
+      std::string const value = argv[++i];
+      if (arg == "-o") { opts.output = value; }
+      else if (arg == "--configs") { opts.configs = value; }
+      else if (arg == "--filter") { opts.filter = value; }
+      else if (arg == "--min-time") { opts.min_time = std::atof(value.c_str()); }
+      else if (arg == "--repetitions") { opts.repetitions = std::max(1, std::atoi(value.c_str())); }
+      else { usage(argv[0]); }
+    }
+    return opts;
+  }
+
+  // ----------------------------------------------------------------------
+  // Documents.
+
+  struct leaf
+  {
+    ParameterSet const * parent;
+    std::string          local_key;
+    std::string          full_key;
+  };
+
+  struct document
+  {
+    std::string          name;
+    std::string          text;
+    ParameterSet         pset;
+    std::deque<ParameterSet> tables;  // nested, at any depth
+    std::vector<leaf>    leaves;  // non-nil atoms, in key order
+  };
+
+  // A job of n modules, each of a dozen parameters of every kind, two
+  // levels of nested tables and a sequence of tables.
+  std::string
+  synthetic(unsigned n)
+  {
+    std::ostringstream os;
+    os << "process_name: Synthetic\n"
+          "physics: {\n  producers: {\n";
+    for (unsigned i = 0; i != n; ++i) {
+      os << "    module" << i << ": {\n"
+            "      module_type: \"Producer" << i % 17 << "\"\n"
+            "      label: \"module" << i << "\"\n"
+            "      verbose: " << (i % 2 ? "true" : "false") << "\n"
+            "      threshold: " << i * 0.25 + 1.5 << "\n"
+            "      count: " << i << "\n"
+            "      weights: [ " << i << ", " << i + 1 << ", " << i + 2 << ", 1.5e-3 ]\n"
+            "      names: [ \"a" << i << "\", \"b\", \"c\" ]\n"
+            "      empty: @nil\n"
+            "      alg: {\n"
+            "        tool_type: \"Tool" << i % 5 << "\"\n"
+            "        cut: " << i % 100 << ".5\n"
+            "        fit: { order: 3 tolerance: 1e-6 seeds: [ 1, 2, 3 ] }\n"
+            "      }\n"
+            "      planes: [ { id: 0 gain: 1.1 }, { id: 1 gain: 1.2 }, { id: 2 gain: 0.9 } ]\n"
+            "    }\n";
+    }
+    os << "  }\n  p1: [ ";
+    for (unsigned i = 0; i != n; ++i) { os << (i ? ", " : "") << "module" << i; }
+    os << " ]\n  trigger_paths: [ p1 ]\n}\n";
+    return os.str();
+  }
+
+  // The nested tables are copies, kept in doc.tables for the leaves to
+  // refer to.
+  void
+  collect_leaves(ParameterSet const & ps, std::string const & prefix, document & doc)
+  {
+    for (auto const & key : ps.get_keys()) {
+      std::string const full = prefix.empty() ? key : prefix + "." + key;
+      if (ps.is_key_to_table(key)) {
+        doc.tables.push_back(ps.get<ParameterSet>(key));
+        collect_leaves(doc.tables.back(), full, doc);
+      }
+      else if (ps.is_key_to_atom(key)) {
+        std::string s;
+        try { s = ps.get<std::string>(key); } catch (fhicl::exception const &) { continue; }
+        doc.leaves.push_back(leaf{&ps, key, full});
+      }
+    }
+  }
+
+  // What the JSON records of a document.
+  struct config
+  {
+    std::string  name;
+    std::size_t  bytes;
+    std::size_t  tables;
+    std::size_t  atoms;
+  };
+
+  bool
+  read_file(std::string const & filename, std::string & text)
+  {
+    std::ifstream in(filename.c_str());
+    if (!in) { return false; }
+    std::ostringstream os;
+    os << in.rdbuf();
+    text = os.str();
+    return true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Timing.
+
+  struct measurement
+  {
+    unsigned long iterations = 0u;
+    double        ns_min = 0.;
+    double        ns_median = 0.;
+  };
+
+  template <class F>
+  double
+  batch(F & f, unsigned long n)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i != n; ++i) { f(); }
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    return t.count();
+  }
+
+  template <class F>
+  measurement
+  measure(options const & opts, F f)
+  {
+    measurement m;
+    m.iterations = 1u;
+    for (double t = batch(f, 1u); t < opts.min_time; t = batch(f, m.iterations)) {
+      double const scale = t > 0. ? 1.2 * opts.min_time / t : 10.;
+      m.iterations = static_cast<unsigned long>(m.iterations * std::min(std::max(scale, 1.5), 10.));
+    }
+    std::vector<double> ns;
+    for (unsigned r = 0; r != opts.repetitions; ++r) {
+      ns.push_back(1e9 * batch(f, m.iterations) / m.iterations);
+    }
+    std::sort(ns.begin(), ns.end());
+    m.ns_min = ns.front();
+    m.ns_median = ns[ns.size() / 2];
+    return m;
+  }
+
+  // ----------------------------------------------------------------------
+  // Results.
+
+  struct result
+  {
+    std::string  benchmark;
+    std::string  config;
+    measurement  m;
+    std::size_t  ops_per_iteration;  // e.g. keys looked up
+    std::size_t  bytes_per_iteration;  // 0 if not a throughput
+    std::size_t  registry_size;  // 0 if not a registry benchmark
+  };
+
+  std::string
+  json_string(std::string const & s)
+  {
+    std::string r = "\"";
+    for (char c : s) {
+      switch (c) {
+      case '"': r += "\\\""; break;
+      case '\\': r += "\\\\"; break;
+      case '\n': r += "\\n"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof buf, "\\u%04x", c);
+          r += buf;
+        }
+        else { r += c; }
+      }
+    }
+    return r + "\"";
+  }
+
+  void
+  write_json(std::ostream & os, options const & opts,
+             std::vector<config> const & configs, std::vector<result> const & results)
+  {
+#ifdef __OPTIMIZE__
+    bool const optimized = true;
+#else
+    bool const optimized = false;
+#endif
+    char buf[64];
+    os << "{\n"
+       << "  \"suite\": \"fhiclcpp_benchmarks\",\n"
+       << "  \"version\": " << json_string(FNALCORE_VERSION) << ",\n"
+       << "  \"optimized\": " << (optimized ? "true" : "false") << ",\n"
+       << "  \"min_time\": " << opts.min_time << ",\n"
+       << "  \"repetitions\": " << opts.repetitions << ",\n"
+       << "  \"configs\": [";
+    for (std::size_t i = 0; i != configs.size(); ++i) {
+      os << (i ? "," : "") << "\n    { \"name\": " << json_string(configs[i].name)
+         << ", \"bytes\": " << configs[i].bytes
+         << ", \"tables\": " << configs[i].tables
+         << ", \"atoms\": " << configs[i].atoms << " }";
+    }
+    os << "\n  ],\n  \"results\": [";
+    for (std::size_t i = 0; i != results.size(); ++i) {
+      result const & r = results[i];
+      os << (i ? "," : "") << "\n    { \"benchmark\": " << json_string(r.benchmark)
+         << ", \"config\": " << json_string(r.config)
+         << ", \"iterations\": " << r.m.iterations;
+      std::snprintf(buf, sizeof buf, "%.1f", r.m.ns_min / r.ops_per_iteration);
+      os << ", \"ns_per_op_min\": " << buf;
+      std::snprintf(buf, sizeof buf, "%.1f", r.m.ns_median / r.ops_per_iteration);
+      os << ", \"ns_per_op_median\": " << buf
+         << ", \"ops_per_iteration\": " << r.ops_per_iteration;
+      if (r.bytes_per_iteration != 0u) {
+        std::snprintf(buf, sizeof buf, "%.2f", 1e3 * r.bytes_per_iteration / r.m.ns_median);
+        os << ", \"mb_per_s\": " << buf;
+      }
+      if (r.registry_size != 0u) {
+        os << ", \"registry_size\": " << r.registry_size;
+      }
+      os << " }";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  // ----------------------------------------------------------------------
+  // The benchmarks.
+
+  class runner
+  {
+  public:
+    runner(options const & opts) : opts_(opts) { }
+
+    template <class F>
+    void
+    operator()(std::string const & benchmark, document const & doc, F f,
+               std::size_t ops = 1u, std::size_t bytes = 0u, std::size_t registry_size = 0u)
+    {
+      if (!opts_.filter.empty() &&
+          benchmark.find(opts_.filter) == std::string::npos &&
+          doc.name.find(opts_.filter) == std::string::npos) {
+        return;
+      }
+      result r{benchmark, doc.name, measure(opts_, f), ops, bytes, registry_size};
+      std::fprintf(stderr, "%-22s %-16s %12.1f ns/op\n", benchmark.c_str(),
+                   doc.name.c_str(), r.m.ns_median / ops);
+      results_.push_back(r);
+    }
+
+    std::vector<result> const & results() const { return results_; }
+
+  private:
+    options const & opts_;
+    std::vector<result> results_;
+  };
+
+  std::size_t sink = 0u;
+
+  void
+  run_document(runner & run, document const & doc)
+  {
+    std::string const & text = doc.text;
+    ParameterSet const & pset = doc.pset;
+
+    run("parse_document", doc, [&text] {
+        intermediate_table tbl;
+        parse_document(text, tbl);
+        sink += tbl.empty();
+      }, 1u, text.size());
+
+    intermediate_table parsed;
+    parse_document(text, parsed);
+    run("make_ParameterSet", doc, [&parsed] {
+        ParameterSet ps;
+        make_ParameterSet(parsed, ps);
+        sink += ps.is_empty();
+      });
+
+    run("ParameterSetID", doc, [&pset] {
+        ParameterSetID const id(pset);
+        sink += id.is_valid();
+      });
+
+    std::vector<leaf> const & leaves = doc.leaves;
+    run("get_flat", doc, [&leaves] {
+        for (auto const & l : leaves) { sink += l.parent->get<std::string>(l.local_key).size(); }
+      }, leaves.size());
+    run("get_nested", doc, [&leaves, &pset] {
+        for (auto const & l : leaves) { sink += pset.get<std::string>(l.full_key).size(); }
+      }, leaves.size());
+
+    std::size_t const string_size = pset.to_string().size();
+    run("to_string", doc, [&pset] {
+        sink += pset.to_string().size();
+      }, 1u, string_size);
+    std::size_t const indented_size = pset.to_indented_string().size();
+    run("to_indented_string", doc, [&pset] {
+        sink += pset.to_indented_string().size();
+      }, 1u, indented_size);
+
+    // Registry: the exported DB is imported back and staged in.
+    ParameterSetRegistry::put(pset);
+    std::size_t const registry_size = ParameterSetRegistry::size();
+    sqlite3 * db = nullptr;
+    sqlite3_open(":memory:", &db);
+    run("registry_exportTo", doc, [db] {
+        ParameterSetRegistry::exportTo(db);
+      }, 1u, 0u, registry_size);
+    ParameterSetRegistry::exportTo(db);
+    run("registry_importFrom", doc, [db] {
+        ParameterSetRegistry::importFrom(db);
+      }, 1u, 0u, registry_size);
+    run("registry_stageIn", doc, [] {
+        ParameterSetRegistry::stageIn();
+      }, 1u, 0u, registry_size);
+    sqlite3_close(db);
+  }
+
+}
+
+int
+main(int argc, char * argv[])
+{
+  options const opts = parse_options(argc, argv);
+
+  // Synthetic and checked-in documents, measured in order of size; the
+  // registry grows accordingly.
+  std::vector<std::pair<std::string, std::string>> sources;
+  for (unsigned n : { 10u, 100u, 1000u }) {
+    sources.emplace_back("synthetic-" + std::to_string(n), synthetic(n));
+  }
+  for (char const * name : { "small", "medium", "large" }) {
+    std::string const filename = opts.configs + "/" + name + ".fcl";
+    std::string text;
+    if (!read_file(filename, text)) {
+      std::cerr << "Cannot read " << filename << "; use --configs.\n";
+      return 1;
+    }
+    sources.emplace_back(name, text);
+  }
+  std::stable_sort(sources.begin(), sources.end(),
+                   [](std::pair<std::string, std::string> const & a,
+                      std::pair<std::string, std::string> const & b) {
+                     return a.second.size() < b.second.size();
+                   });
+
+#ifndef __OPTIMIZE__
+  std::cerr << "Warning: fhiclcpp_benchmarks was built without optimization.\n";
+#endif
+  runner run(opts);
+  std::vector<config> configs;
+  for (auto const & source : sources) {
+    document doc;
+    doc.name = source.first;
+    doc.text = source.second;
+    try {
+      make_ParameterSet(doc.text, doc.pset);
+    }
+    catch (fhicl::exception const & e) {
+      std::cerr << doc.name << ": " << e.what() << '\n';
+      return 1;
+    }
+    collect_leaves(doc.pset, "", doc);
+    run_document(run, doc);
+    configs.push_back(config{doc.name, doc.text.size(), doc.tables.size() + 1u, doc.leaves.size()});
+  }
+
+  if (opts.output.empty()) {
+    write_json(std::cout, opts, configs, run.results());
+  }
+  else {
+    std::ofstream out(opts.output.c_str());
+    write_json(out, opts, configs, run.results());
+    if (!out) {
+      std::cerr << "Cannot write " << opts.output << '\n';
+      return 1;
+    }
+  }
+  return sink == 1u ? 3 : 0;
+}
@@ -48,12 +48,55 @@ void fhicl::decompose_parameterset(fhicl::ParameterSet const& top,
 }
 
 void fhicl::parse_file_and_fill_db(std::string const& filename,
-                                   sqlite3* out)
+                                   sqlite3* out,
+                                   bool writeIndex)
 {
   fhicl::ParameterSet top;
   cet::filepath_maker fpm;
   make_ParameterSet(filename, fpm, top);
   fhicl::ParameterSetRegistry::put(top);
-  fhicl::ParameterSetRegistry::exportTo(out);
+  fhicl::ParameterSetRegistry::exportTo(out, writeIndex);
+}
+
+std::vector<fhicl::ParameterSetID>
+fhicl::find_parameterset_ids(sqlite3* db,
+                             std::vector<std::pair<std::string, std::string>> const& constraints)
+{
+  using fhicl::detail::throwOnSQLiteFailure;
+
+  // One indexed lookup per constraint, intersected.
+  std::string query;
+  if (constraints.empty())
+    query = "SELECT DISTINCT ID FROM ParameterSetIndex";
+  for (std::size_t i = 0; i != constraints.size(); ++i)
+    {
+      if (i != 0) query += " INTERSECT ";
+      query += "SELECT ID FROM ParameterSetIndex WHERE Key = ? AND Value = ?";
+    }
+  query += " ORDER BY ID;";
+
+  sqlite3_stmt* stmt = nullptr;
+  sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+  throwOnSQLiteFailure(db);
+  // Text is stored with its terminating null (see exportTo), so bind
+  // it the same way.
+  int col = 0;
+  for (auto const& c : constraints)
+    {
+      sqlite3_bind_text(stmt, ++col, c.first.c_str(), c.first.size() + 1, SQLITE_STATIC);
+      throwOnSQLiteFailure(db);
+      sqlite3_bind_text(stmt, ++col, c.second.c_str(), c.second.size() + 1, SQLITE_STATIC);
+      throwOnSQLiteFailure(db);
+    }
+
+  std::vector<ParameterSetID> result;
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    result.emplace_back(reinterpret_cast<char const*>(sqlite3_column_text(stmt, 0)));
+  if (rc != SQLITE_DONE)
+    throwOnSQLiteFailure(db);
+  sqlite3_finalize(stmt);
+  throwOnSQLiteFailure(db);
+  return result;
 }
 
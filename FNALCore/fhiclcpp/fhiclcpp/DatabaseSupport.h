@@ -2,6 +2,7 @@
 #define FHICLCPP_DATABASE_SUPPORT
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cetlib/filepath_maker.h"
@@ -32,8 +33,22 @@ namespace fhicl
   // Read the file 'filename', creating a ParameterSet, and then fill
   // the given empty sqlite3 database with all the ParameterSets created
   // by the parsing.
+  //
+  // If 'writeIndex' is true, the database also receives the index of
+  // top-level atoms searched by find_parameterset_ids.
   void parse_file_and_fill_db(std::string const& filename,
-                              sqlite3* db);
+                              sqlite3* db,
+                              bool writeIndex = false);
+
+  // Return, in ID order, the IDs of all ParameterSets in 'db' whose
+  // top-level atoms match every (key, value) pair in 'constraints'.
+  // Values are compared with the canonical form returned by
+  // ParameterSet::get<std::string>() (strings without quotes). The
+  // database must have been written with an index; an empty list of
+  // constraints matches every indexed ParameterSet.
+  std::vector<fhicl::ParameterSetID>
+  find_parameterset_ids(sqlite3* db,
+                        std::vector<std::pair<std::string, std::string>> const& constraints);
 }
 
 
@@ -8,6 +8,7 @@
 
 #include "cpp0x/cstddef"
 #include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/atom_pool.h"
 #include <cassert>
 
 using namespace fhicl;
@@ -50,7 +51,7 @@ ParameterSet::stringify_(any const & a, bool compact) const
     result.append(1, ']');
   }
   else { // is_atom(a)
-    ps_atom_t str = any_cast<ps_atom_t>(a);
+    ps_atom_t const & str = atom_text(a);
     result = str == string(9, '\0') ? "@nil" : str;
   }
   return result;
@@ -111,6 +112,31 @@ ParameterSet::get_pset_keys() const
   return keys;
 }
 
+vector<string>
+ParameterSet::get_differing_keys(ParameterSet const & other) const
+{
+  vector<string> keys;
+  map_iter_t it = mapping_.begin(), e = mapping_.end();
+  map_iter_t oit = other.mapping_.begin(), oe = other.mapping_.end();
+  while (it != e || oit != oe) {
+    if (oit == oe || (it != e && it->first < oit->first))
+    { keys.push_back((it++)->first); }
+    else if (it == e || oit->first < it->first)
+    { keys.push_back((oit++)->first); }
+    else {
+      bool const same = is_table(it->second) && is_table(oit->second)
+                        ? any_cast<ParameterSetID>(it->second) ==
+                          any_cast<ParameterSetID>(oit->second)
+                        : stringify_(it->second, true) ==
+                          other.stringify_(oit->second, true);
+      if (! same)
+      { keys.push_back(it->first); }
+      ++it, ++oit;
+    }
+  }
+  return keys;
+}
+
 // ----------------------------------------------------------------------
 
 void
@@ -143,29 +169,49 @@ namespace {
 
 void
 ParameterSet::insert_(string const & key, any const & value)
+{
+  insert_(key, any(value));
+}
+
+void
+ParameterSet::insert_(string const & key, any && value)
 {
   check_put_local_key(key);
-  if (!mapping_.emplace(key, value).second) {
+  auto const result = mapping_.emplace(key, std::move(value));
+  if (!result.second) {
     throw exception(cant_insert) << "key " << key << " already exists.";
   }
+  atom_pool::intern_atoms(result.first->second);
   id_.invalidate();
 }
 
 void
 ParameterSet::insert_or_replace_(string const & key, any const & value)
+{
+  insert_or_replace_(key, any(value));
+}
+
+void
+ParameterSet::insert_or_replace_(string const & key, any && value)
 {
   check_put_local_key(key);
-  mapping_[key] = value;
+  atom_pool::intern_atoms(mapping_[key] = std::move(value));
   id_.invalidate();
 }
 
 void
 ParameterSet::insert_or_replace_compatible_(string const & key, any const & value)
+{
+  insert_or_replace_compatible_(key, any(value));
+}
+
+void
+ParameterSet::insert_or_replace_compatible_(string const & key, any && value)
 {
   check_put_local_key(key);
   auto item = mapping_.find(key);
   if (item == mapping_.end()) {
-    insert_(key, value);
+    insert_(key, std::move(value));
     return;
   } else {
     if (!detail::is_nil(value)) {
@@ -182,7 +228,7 @@ ParameterSet::insert_or_replace_compatible_(string const & key, any const & valu
         throw exception(cant_insert) << "can't use non-atom to replace non-nil atom.";
       }
     }
-    item->second = value;
+    atom_pool::intern_atoms(item->second = std::move(value));
   }
   id_.invalidate();
 }
@@ -308,7 +354,7 @@ private:
       result_.append("]");
     }
     else // is_atom(a)
-    { result_.append(any_cast<ps_atom_t>(a)); }
+    { result_.append(atom_text(a)); }
   } // stringify()
 
 }; // Prettifier
@@ -18,11 +18,25 @@
 #include "fhiclcpp/fwd.h"
 #include <cctype>
 #include <map>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+namespace fhicl {
+  namespace detail {
+    class binder;     // see bind.h
+    class overlayer;  // see overlay.cc
+  }
+}
+
 // ----------------------------------------------------------------------
 
 class fhicl::ParameterSet {
+  // Selects the rvalue overloads of the inserters.
+  template< class T >
+  using enable_if_rvalue_ =
+    typename std::enable_if< ! std::is_reference<T>::value >::type;
+
 public:
   typedef fhicl::detail::ps_atom_t ps_atom_t;
   typedef fhicl::detail::ps_sequence_t ps_sequence_t;
@@ -60,15 +74,32 @@ public:
   T get(std::string const & key, T const & default_value
         , T convert(Via const &)) const;
 
-  // inserters (key must be local: no nesting):
+  // inserters (key must be local: no nesting). The rvalue forms move
+  // value's contents into the encoded value instead of copying them,
+  // where the type allows: nested ParameterSets, the elements of
+  // sequences, and strings already in canonical form (double-quoted,
+  // needing no escapes).
   void put(std::string const & key); // Implicit nil value.
   template< class T > // Fail on preexisting key.
   void put(std::string const & key, T const & value);
+  template< class T, class = enable_if_rvalue_<T> >
+  void put(std::string const & key, T && value);
   void put_or_replace(std::string const & key); // Implicit nil value.
   template< class T > // Succeed.
   void put_or_replace(std::string const & key, T const & value);
+  template< class T, class = enable_if_rvalue_<T> >
+  void put_or_replace(std::string const & key, T && value);
   template< class T > // Fail if preexisting key of incompatible type.
   void put_or_replace_compatible(std::string const & key, T const & value);
+  template< class T, class = enable_if_rvalue_<T> >
+  void put_or_replace_compatible(std::string const & key, T && value);
+
+  // extractors (key must be local: no nesting): remove key, moving its
+  // value out rather than copying it.
+  template< class T >
+  bool extract_if_present(std::string const & key, T & value);
+  template< class T >
+  T extract(std::string const & key);
 
   // deleters:
   bool erase(std::string const & key);
@@ -76,6 +107,9 @@ public:
   // comparators:
   bool operator == (ParameterSet const & other) const;
   bool operator != (ParameterSet const & other) const;
+  // Local keys whose values differ from those in other, including keys
+  // present in only one of the two; sorted.
+  std::vector<std::string> get_differing_keys(ParameterSet const & other) const;
 
 private:
   typedef std::map<std::string, boost::any> map_t;
@@ -86,9 +120,13 @@ private:
 
   // Private inserters.
   void insert_(std::string const & key, boost::any const & value);
+  void insert_(std::string const & key, boost::any && value);
   void insert_or_replace_(std::string const & key, boost::any const & value);
+  void insert_or_replace_(std::string const & key, boost::any && value);
   void insert_or_replace_compatible_(std::string const & key,
                                      boost::any const & value);
+  void insert_or_replace_compatible_(std::string const & key,
+                                     boost::any && value);
 
   std::string to_string_(bool compact = false) const;
   std::string stringify_(boost::any const & a,
@@ -103,6 +141,8 @@ private:
                std::function<bool (boost::any const &)> func) const;
 
   class Prettifier;
+  friend class detail::binder;
+  friend class detail::overlayer;
 
 }; // ParameterSet
 
@@ -187,6 +227,31 @@ catch (std::exception const & e)
   throw fhicl::exception(cant_insert, key) << e.what();
 }
 
+template< class T, class >
+void
+fhicl::ParameterSet::put(std::string const & key, T && value)
+try
+{
+  using detail::encode;
+  insert_(key, boost::any(encode(std::move(value))));
+}
+catch (boost::bad_lexical_cast const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+catch (boost::bad_numeric_cast const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+catch (fhicl::exception const & e)
+{
+  throw fhicl::exception(cant_insert, key, e);
+}
+catch (std::exception const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+
 template< class T >
 void
 fhicl::ParameterSet::put_or_replace(std::string const & key, T const & value)
@@ -212,6 +277,31 @@ catch (std::exception const & e)
   throw fhicl::exception(cant_insert, key) << e.what();
 }
 
+template< class T, class >
+void
+fhicl::ParameterSet::put_or_replace(std::string const & key, T && value)
+try
+{
+  using detail::encode;
+  insert_or_replace_(key, boost::any(encode(std::move(value))));
+}
+catch (boost::bad_lexical_cast const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+catch (boost::bad_numeric_cast const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+catch (fhicl::exception const & e)
+{
+  throw fhicl::exception(cant_insert, key, e);
+}
+catch (std::exception const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+
 template< class T >
 void
 fhicl::ParameterSet::put_or_replace_compatible(std::string const & key,
@@ -238,6 +328,72 @@ catch (std::exception const & e)
   throw fhicl::exception(cant_insert, key) << e.what();
 }
 
+template< class T, class >
+void
+fhicl::ParameterSet::put_or_replace_compatible(std::string const & key, T && value)
+try
+{
+  using detail::encode;
+  insert_or_replace_compatible_(key, boost::any(encode(std::move(value))));
+}
+catch (boost::bad_lexical_cast const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+catch (boost::bad_numeric_cast const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+catch (fhicl::exception const & e)
+{
+  throw fhicl::exception(cant_insert, key, e);
+}
+catch (std::exception const & e)
+{
+  throw fhicl::exception(cant_insert, key) << e.what();
+}
+
+// ----------------------------------------------------------------------
+
+template< class T >
+bool
+fhicl::ParameterSet::extract_if_present(std::string const & key, T & value)
+try
+{
+  if (key.find('.') != std::string::npos) {
+    throw fhicl::exception(unimplemented, "extract() for nested key.");
+  }
+  auto it = mapping_.find(key);
+  if (it == mapping_.end())
+  { return false; }
+  // Decode first: on a mismatch, the parameter is left as it was.
+  T result;
+  detail::decode_moved(std::move(it->second), result);
+  mapping_.erase(it);
+  id_.invalidate();
+  value = std::move(result);
+  return true;
+}
+catch (fhicl::exception const & e)
+{
+  if (e.categoryCode() == unimplemented) { throw; }
+  throw fhicl::exception(type_mismatch, key, e);
+}
+catch (std::exception const & e)
+{
+  throw fhicl::exception(type_mismatch, key + "\n" + e.what());
+}
+
+template< class T >
+T
+fhicl::ParameterSet::extract(std::string const & key)
+{
+  T result;
+  if (!extract_if_present(key, result))
+  { throw fhicl::exception(cant_find, key); }
+  return result;
+}
+
 // ----------------------------------------------------------------------
 
 template< class T >
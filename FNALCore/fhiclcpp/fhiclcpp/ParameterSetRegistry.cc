@@ -2,8 +2,11 @@
 
 #include "fhiclcpp/ParameterSetID.h"
 #include "fhiclcpp/exception.h"
+#include "fhiclcpp/frozen_registry.h"
 #include "fhiclcpp/make_ParameterSet.h"
 
+#include <unistd.h>
+
 using fhicl::detail::throwOnSQLiteFailure;
 
 namespace {
@@ -15,11 +18,61 @@ namespace {
     char * errMsg = nullptr;
     sqlite3_exec(result,
                  "BEGIN TRANSACTION;"
-                 "CREATE TABLE ParameterSets(ID PRIMARY KEY, PSetBlob); COMMIT;",
+                 "CREATE TABLE ParameterSets(ID PRIMARY KEY, PSetBlob);"
+                 "CREATE TABLE ParameterSetIndex(ID, Key, Value, PRIMARY KEY(ID, Key));"
+                 "COMMIT;",
                  0, 0, &errMsg);
     throwOnSQLiteFailure(result, errMsg);
     return result;
   }
+
+  bool hasTable(sqlite3 * db, char const * name)
+  {
+    sqlite3_stmt * stmt;
+    sqlite3_prepare_v2(db,
+                       "SELECT 1 FROM sqlite_master WHERE type='table' AND name=?;",
+                       -1, &stmt, NULL);
+    throwOnSQLiteFailure(db);
+    sqlite3_bind_text(stmt, 1, name, -1, SQLITE_STATIC);
+    throwOnSQLiteFailure(db);
+    bool const result = (sqlite3_step(stmt) == SQLITE_ROW);
+    sqlite3_finalize(stmt);
+    throwOnSQLiteFailure(db);
+    return result;
+  }
+
+  // Bind and step the (ID, Key, Value) insertion statement oStmt once
+  // for each non-nil top-level atom of ps.
+  void indexAtoms(sqlite3 * db,
+                  sqlite3_stmt * oStmt,
+                  std::string const & id,
+                  fhicl::ParameterSet const & ps)
+  {
+    for (auto const & key : ps.get_keys()) {
+      if (!ps.is_key_to_atom(key)) { continue; }
+      std::string value;
+      try {
+        value = ps.get<std::string>(key);
+      }
+      catch (fhicl::exception const &) {
+        continue; // nil: nothing to index.
+      }
+      sqlite3_bind_text(oStmt, 1, id.c_str(), id.size() + 1, SQLITE_STATIC);
+      throwOnSQLiteFailure(db);
+      sqlite3_bind_text(oStmt, 2, key.c_str(), key.size() + 1, SQLITE_STATIC);
+      throwOnSQLiteFailure(db);
+      sqlite3_bind_text(oStmt, 3, value.c_str(), value.size() + 1, SQLITE_STATIC);
+      throwOnSQLiteFailure(db);
+      switch (sqlite3_step(oStmt)) {
+      case SQLITE_DONE:
+        sqlite3_reset(oStmt);
+        throwOnSQLiteFailure(db);
+        break; // OK
+      default:
+        throwOnSQLiteFailure(db);
+      }
+    }
+  }
 }
 
 void
@@ -63,6 +116,7 @@ importFrom(sqlite3 * db)
 {
   // This does *not* cause anything new to be imported into the registry
   // itself, just its backing DB.
+  lock_guard lock(instance_().mutex_);
   sqlite3_stmt * iStmt, * oStmt;
   sqlite3 * primaryDB = instance_().primaryDB_;
   sqlite3_prepare_v2(db,
@@ -100,23 +154,71 @@ importFrom(sqlite3 * db)
   throwOnSQLiteFailure(primaryDB);
   sqlite3_finalize(iStmt);
   throwOnSQLiteFailure(db);
+
+  // Carry over any index of top-level atoms.
+  if (!hasTable(db, "ParameterSetIndex")) { return; }
+  sqlite3_prepare_v2(db,
+                     "SELECT ID, Key, Value FROM ParameterSetIndex;",
+                     -1, &iStmt, NULL);
+  throwOnSQLiteFailure(db);
+  sqlite3_prepare_v2(primaryDB,
+                     "INSERT OR IGNORE INTO ParameterSetIndex(ID, Key, Value) VALUES(?, ?, ?);",
+                     -1, &oStmt, NULL);
+  throwOnSQLiteFailure(primaryDB);
+  while (sqlite3_step(iStmt) == SQLITE_ROW) {
+    for (int col = 0; col != 3; ++col) {
+      std::string const text = reinterpret_cast<char const *>
+                               (sqlite3_column_text(iStmt, col));
+      sqlite3_bind_text(oStmt, col + 1, text.c_str(), text.size() + 1, SQLITE_TRANSIENT);
+      throwOnSQLiteFailure(primaryDB);
+    }
+    switch (sqlite3_step(oStmt)) {
+    case SQLITE_DONE:
+      break; // OK
+    default:
+      throwOnSQLiteFailure(primaryDB);
+    }
+    sqlite3_reset(oStmt);
+    throwOnSQLiteFailure(primaryDB);
+  }
+  sqlite3_finalize(oStmt);
+  throwOnSQLiteFailure(primaryDB);
+  sqlite3_finalize(iStmt);
+  throwOnSQLiteFailure(db);
 }
 
 void
 fhicl::ParameterSetRegistry::
-exportTo(sqlite3 * db)
+exportTo(sqlite3 * db, bool writeIndex)
 {
+  lock_guard lock(instance_().mutex_);
   char * errMsg = nullptr;
   sqlite3_exec(db,
                "BEGIN TRANSACTION; DROP TABLE IF EXISTS ParameterSets;"
+               "DROP TABLE IF EXISTS ParameterSetIndex;"
                "CREATE TABLE ParameterSets(ID PRIMARY KEY, PSetBlob); COMMIT;",
                0, 0, &errMsg);
   throwOnSQLiteFailure(db, errMsg);
+  sqlite3_stmt * xStmt = nullptr;
+  if (writeIndex) {
+    sqlite3_exec(db,
+                 "BEGIN TRANSACTION;"
+                 "CREATE TABLE ParameterSetIndex(ID, Key, Value, PRIMARY KEY(ID, Key));"
+                 "CREATE INDEX ParameterSetIndexByKeyValue ON ParameterSetIndex(Key, Value);"
+                 "COMMIT;",
+                 0, 0, &errMsg);
+    throwOnSQLiteFailure(db, errMsg);
+    sqlite3_prepare_v2(db, "INSERT OR IGNORE INTO ParameterSetIndex(ID, Key, Value) VALUES(?, ?, ?);", -1, &xStmt, NULL);
+    throwOnSQLiteFailure(db);
+  }
   sqlite3_stmt * oStmt;
   sqlite3_prepare_v2(db, "INSERT OR IGNORE INTO ParameterSets(ID, PSetBlob) VALUES(?, ?);", -1, &oStmt, NULL);
   throwOnSQLiteFailure(db);
   for (auto const & p : instance_().registry_) {
     std::string id(p.first.to_string());
+    if (writeIndex) {
+      indexAtoms(db, xStmt, id, p.second);
+    }
     std::string psBlob(p.second.to_compact_string());
     sqlite3_bind_text(oStmt, 1, id.c_str(), id.size() + 1, SQLITE_STATIC);
     throwOnSQLiteFailure(db);
@@ -157,14 +259,92 @@ exportTo(sqlite3 * db)
   }
   sqlite3_finalize(iStmt);
   throwOnSQLiteFailure(primaryDB);
+  // ParameterSets of an adopted segment need not be anywhere else.
+  if (auto const & frozen = instance_().frozen_) {
+    for (std::size_t i = 0; i != frozen->size(); ++i) {
+      std::string const idString = frozen->id(i);
+      std::string const psBlob = frozen->blob(i);
+      if (writeIndex) {
+        ParameterSet pset;
+        fhicl::make_ParameterSet(psBlob, pset);
+        indexAtoms(db, xStmt, idString, pset);
+      }
+      sqlite3_bind_text(oStmt, 1, idString.c_str(), idString.size() + 1, SQLITE_STATIC);
+      throwOnSQLiteFailure(db);
+      sqlite3_bind_text(oStmt, 2, psBlob.c_str(), psBlob.size() + 1, SQLITE_STATIC);
+      throwOnSQLiteFailure(db);
+      switch (sqlite3_step(oStmt)) {
+      case SQLITE_DONE:
+        sqlite3_reset(oStmt);
+        throwOnSQLiteFailure(db);
+        break; // OK
+      default:
+        throwOnSQLiteFailure(db);
+      }
+    }
+  }
   sqlite3_finalize(oStmt);
   throwOnSQLiteFailure(db);
+  if (writeIndex) {
+    exportIndexFromPrimaryDB_(db, xStmt);
+    sqlite3_finalize(xStmt);
+    throwOnSQLiteFailure(db);
+  }
+}
+
+void
+fhicl::ParameterSetRegistry::
+exportIndexFromPrimaryDB_(sqlite3 * db, sqlite3_stmt * xStmt)
+{
+  // Index rows already present in the primary DB (carried over by
+  // importFrom()) are copied; ParameterSets that arrived without an
+  // index are decoded once to produce theirs.
+  sqlite3 * primaryDB = instance_().primaryDB_;
+  sqlite3_stmt * iStmt;
+  sqlite3_prepare_v2(primaryDB,
+                     "SELECT ID, Key, Value FROM ParameterSetIndex;",
+                     -1, &iStmt, NULL);
+  throwOnSQLiteFailure(primaryDB);
+  while (sqlite3_step(iStmt) == SQLITE_ROW) {
+    for (int col = 0; col != 3; ++col) {
+      std::string const text = reinterpret_cast<char const *>
+                               (sqlite3_column_text(iStmt, col));
+      sqlite3_bind_text(xStmt, col + 1, text.c_str(), text.size() + 1, SQLITE_TRANSIENT);
+      throwOnSQLiteFailure(db);
+    }
+    switch (sqlite3_step(xStmt)) {
+    case SQLITE_DONE:
+      sqlite3_reset(xStmt);
+      throwOnSQLiteFailure(db);
+      break; // OK
+    default:
+      throwOnSQLiteFailure(db);
+    }
+  }
+  sqlite3_finalize(iStmt);
+  throwOnSQLiteFailure(primaryDB);
+  sqlite3_prepare_v2(primaryDB,
+                     "SELECT ID, PSetBlob FROM ParameterSets WHERE ID NOT IN "
+                     "(SELECT ID FROM ParameterSetIndex);",
+                     -1, &iStmt, NULL);
+  throwOnSQLiteFailure(primaryDB);
+  while (sqlite3_step(iStmt) == SQLITE_ROW) {
+    std::string idString = reinterpret_cast<char const *>
+                           (sqlite3_column_text(iStmt, 0));
+    ParameterSet pset;
+    fhicl::make_ParameterSet(reinterpret_cast<char const *>(sqlite3_column_text(iStmt, 1)),
+                             pset);
+    indexAtoms(db, xStmt, idString, pset);
+  }
+  sqlite3_finalize(iStmt);
+  throwOnSQLiteFailure(primaryDB);
 }
 
 void
 fhicl::ParameterSetRegistry::
 stageIn()
 {
+  lock_guard lock(instance_().mutex_);
   sqlite3_stmt * stmt;
   sqlite3 * primaryDB = instance_().primaryDB_;
   auto & registry = instance_().registry_;
@@ -187,21 +367,80 @@ stageIn()
   throwOnSQLiteFailure(primaryDB);
 }
 
+int
+fhicl::ParameterSetRegistry::
+freeze()
+{
+  auto & inst = instance_();
+  lock_guard lock(inst.mutex_);
+  detail::frozen_registry::entries_t entries;
+  if (inst.frozen_) {
+    for (std::size_t i = 0; i != inst.frozen_->size(); ++i) {
+      entries[inst.frozen_->id(i)] = inst.frozen_->blob(i);
+    }
+  }
+  sqlite3_stmt * iStmt;
+  sqlite3 * primaryDB = inst.primaryDB_;
+  sqlite3_prepare_v2(primaryDB,
+                     "SELECT ID, PSetBlob FROM ParameterSets;",
+                     -1, &iStmt, NULL);
+  throwOnSQLiteFailure(primaryDB);
+  while (sqlite3_step(iStmt) == SQLITE_ROW) {
+    entries[reinterpret_cast<char const *>(sqlite3_column_text(iStmt, 0))] =
+      reinterpret_cast<char const *>(sqlite3_column_text(iStmt, 1));
+  }
+  sqlite3_finalize(iStmt);
+  throwOnSQLiteFailure(primaryDB);
+  for (auto const & p : inst.registry_) {
+    entries[p.first.to_string()] = p.second.to_compact_string();
+  }
+  int const fd = detail::frozen_registry::create(entries);
+  try {
+    inst.frozen_.reset(new detail::frozen_registry(fd));
+  }
+  catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd); // frozen_registry holds its own descriptor.
+  return inst.frozen_->fd();
+}
+
+void
+fhicl::ParameterSetRegistry::
+adoptFrozen(int fd)
+{
+  auto & inst = instance_();
+  std::unique_ptr<detail::frozen_registry> frozen(new detail::frozen_registry(fd));
+  lock_guard lock(inst.mutex_);
+  inst.frozen_ = std::move(frozen);
+}
+
 fhicl::ParameterSetRegistry::
 ParameterSetRegistry()
 :
   primaryDB_(openPrimaryDB()),
   stmt_(nullptr),
-  registry_()
+  registry_(),
+  frozen_(),
+  mutex_()
 {
 }
 
 auto
 fhicl::ParameterSetRegistry::
 find_(ParameterSetID const & id)
--> const_iterator
+-> ParameterSet const *
 {
+  lock_guard lock(mutex_);
   const_iterator it = registry_.find(id);
+  std::string psBlob;
+  if (it == registry_.cend() && frozen_ && frozen_->find(id.to_string(), psBlob)) {
+    ParameterSet pset;
+    fhicl::make_ParameterSet(psBlob, pset);
+    // Put into the registry without triggering ParameterSet::id().
+    it = registry_.emplace(id, pset).first;
+  }
   if (it == registry_.cend()) {
     // Look in primary DB for this ID and its contained IDs.
     if (stmt_ == nullptr) {
@@ -232,5 +471,7 @@ find_(ParameterSetID const & id)
     }
     sqlite3_reset(stmt_);
   }
-  return it;
+  // Elements are never erased, so the address remains valid after
+  // the lock is released.
+  return it == registry_.cend() ? nullptr : &it->second;
 }
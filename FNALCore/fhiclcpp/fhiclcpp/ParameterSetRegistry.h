@@ -14,6 +14,8 @@
 
 #include "sqlite3.h"
 
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace fhicl {
@@ -22,6 +24,7 @@ namespace fhicl {
 
   namespace detail {
     class HashParameterSetID;
+    class frozen_registry;
     void throwOnSQLiteFailure(sqlite3 * db, char *msg = nullptr);
   }
 }
@@ -34,6 +37,10 @@ private:
 };
 
 
+// put(), get() and the DB interaction functions may be called
+// concurrently from several threads (e.g. by make_ParameterSets()); the
+// observers, iterators and get() of the whole collection may not be
+// used while another thread is inserting.
 class fhicl::ParameterSetRegistry {
 public:
   ParameterSetRegistry(ParameterSet const &) = delete;
@@ -50,11 +57,28 @@ public:
   typedef typename collection_type::size_type size_type;
   typedef typename collection_type::const_iterator const_iterator;
 
-  // DB interaction.
+  // DB interaction. If writeIndex is true, exportTo() also writes the
+  // ParameterSetIndex table (ID, Key, Value) of top-level atoms, which
+  // may be searched without deserializing the ParameterSets (see
+  // fhicl::find_parameterset_ids()); index rows carried in by
+  // importFrom() are copied rather than recomputed. exportTo() replaces
+  // both tables of db, so with writeIndex false, db has no index.
   static void importFrom(sqlite3 * db);
-  static void exportTo(sqlite3 * db);
+  static void exportTo(sqlite3 * db, bool writeIndex = false);
   static void stageIn();
 
+  // Shared, read-only snapshot for worker processes (see
+  // frozen_registry.h). freeze() writes every ParameterSet known to the
+  // registry, including those only in its backing DB, to a shared
+  // memory segment, which is consulted before the DB from then on:
+  // processes forked afterwards share its pages, and decode only the
+  // ParameterSets they use. The returned descriptor, owned by the
+  // registry, may also be handed to an unrelated process, which calls
+  // adoptFrozen(). Either may be called again; the latest segment
+  // replaces the previous one.
+  static int freeze();
+  static void adoptFrozen(int fd);
+
   // Observers.
   static bool empty();
   static size_type size();
@@ -68,6 +92,7 @@ public:
   // Put:
   // 1. A single ParameterSet.
   static ParameterSetID const & put(ParameterSet const & ps);
+  static ParameterSetID const & put(ParameterSet && ps);
   // 2. A range of iterator to ParameterSet.
   template <class FwdIt>
   static
@@ -93,11 +118,18 @@ public:
 private:
   ParameterSetRegistry();
   static ParameterSetRegistry & instance_();
-  const_iterator find_(ParameterSetID const & id);
+  static void exportIndexFromPrimaryDB_(sqlite3 * db, sqlite3_stmt * xStmt);
+  ParameterSet const * find_(ParameterSetID const & id);
+
+  typedef std::lock_guard<std::recursive_mutex> lock_guard;
 
   sqlite3 * primaryDB_;
   sqlite3_stmt * stmt_;
   collection_type registry_;
+  std::unique_ptr<detail::frozen_registry> frozen_;
+  // Recursive: find_() may decode a ParameterSet, which puts its
+  // nested tables.
+  std::recursive_mutex mutex_;
 };
 
 inline
@@ -160,7 +192,24 @@ fhicl::ParameterSetRegistry::
 put(ParameterSet const & ps)
 -> ParameterSetID const &
 {
-  return instance_().registry_.emplace(ps.id(), ps).first->first;
+  // Calculate the ID (which may itself consult the registry) before
+  // taking the lock.
+  auto const id = ps.id();
+  auto & inst = instance_();
+  lock_guard lock(inst.mutex_);
+  return inst.registry_.emplace(id, ps).first->first;
+}
+
+inline
+auto
+fhicl::ParameterSetRegistry::
+put(ParameterSet && ps)
+-> ParameterSetID const &
+{
+  auto const id = ps.id();
+  auto & inst = instance_();
+  lock_guard lock(inst.mutex_);
+  return inst.registry_.emplace(id, std::move(ps)).first->first;
 }
 
 // 2.
@@ -186,7 +235,9 @@ put(FwdIt b, FwdIt e)
 -> typename std::enable_if<std::is_same<typename std::iterator_traits<FwdIt>::value_type,
                                         value_type>::value, void>::type
 {
-  instance_().registry_.insert(b, e);
+  auto & inst = instance_();
+  lock_guard lock(inst.mutex_);
+  inst.registry_.insert(b, e);
 }
 
 // 4.
@@ -213,12 +264,12 @@ fhicl::ParameterSetRegistry::
 get(ParameterSetID const & id)
 -> ParameterSet const &
 {
-  const_iterator it = instance_().find_(id);
-  if (it == cend() ) {
+  ParameterSet const * result = instance_().find_(id);
+  if (result == nullptr) {
     throw exception(error::cant_find, "Can't find ParameterSet")
       << "with ID " << id.to_string() << " in the registry.";
   }
-  return it->second;
+  return *result;
 }
 
 inline
@@ -227,11 +278,11 @@ fhicl::ParameterSetRegistry::
 get(ParameterSetID const & id, ParameterSet & ps)
 {
   bool result;
-  const_iterator it = instance_().find_(id);
-  if (it == cend()) {
+  ParameterSet const * found = instance_().find_(id);
+  if (found == nullptr) {
     result = false;
   } else {
-    ps =  it->second;
+    ps = *found;
     result = true;
   }
   return result;
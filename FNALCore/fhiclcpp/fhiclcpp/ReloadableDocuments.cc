@@ -0,0 +1,175 @@
+// ======================================================================
+//
+// ReloadableDocuments - a set of FHiCL documents whose ParameterSets
+//                       are kept up to date with their files
+//
+// ======================================================================
+
+#include "fhiclcpp/ReloadableDocuments.h"
+
+#include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/exception.h"
+#include "fhiclcpp/intermediate_table.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "fhiclcpp/parse.h"
+#include <algorithm>
+#include <exception>
+#include <map>
+
+using fhicl::ReloadableDocuments;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  typedef  cet::include_graph::digest_t  digest_t;
+
+  // Current digests of files, each read at most once per reload().
+  class digests {
+  public:
+    bool matches(std::string const & filepath, digest_t const & recorded)
+    {
+      auto it = current_.find(filepath);
+      if (it == current_.end()) {
+        digest_t d;
+        bool const ok = cet::include_graph::current_digest(filepath, d);
+        it = current_.insert(std::make_pair(filepath, std::make_pair(ok, d))).first;
+      }
+      return it->second.first && it->second.second == recorded;
+    }
+  private:
+    std::map<std::string, std::pair<bool, digest_t>> current_;
+  };
+
+  // Whether any file of graph (of those in only, if given) has changed.
+  bool
+  is_stale(cet::include_graph const & graph,
+           digests & current,
+           std::vector<std::string> const * only = nullptr)
+  {
+    for (auto const & n : graph.nodes()) {
+      if (n.filepath == "-") { continue; }
+      if (only && std::find(only->begin(), only->end(), n.filepath) == only->end())
+      { continue; }
+      if (! current.matches(n.filepath, n.digest)) { return true; }
+    }
+    return false;
+  }
+
+}
+
+// ----------------------------------------------------------------------
+
+ReloadableDocuments::ReloadableDocuments(cet::filepath_maker & maker)
+  : maker_(maker)
+  , docs_()
+{ }
+
+fhicl::ParameterSet const &
+ReloadableDocuments::add(std::string const & filename)
+{
+  document doc;
+  doc.filename = filename;
+  intermediate_table tbl;
+  parse_document(filename, maker_, tbl, doc.graph);
+  make_ParameterSet(std::move(tbl), doc.pset);
+  ParameterSetRegistry::put(doc.pset);
+  docs_.push_back(std::move(doc));
+  return docs_.back().pset;
+}
+
+// ----------------------------------------------------------------------
+
+auto
+ReloadableDocuments::find_(std::string const & filename) const
+-> document const &
+{
+  auto it = std::find_if(docs_.begin(), docs_.end(),
+                         [&filename](document const & d)
+                         { return d.filename == filename; });
+  if (it == docs_.end()) {
+    throw fhicl::exception(cant_find, "ReloadableDocuments: ")
+        << "document "
+        << filename
+        << " has not been added.\n";
+  }
+  return *it;
+}
+
+fhicl::ParameterSet const &
+ReloadableDocuments::get(std::string const & filename) const
+{
+  return find_(filename).pset;
+}
+
+cet::include_graph const &
+ReloadableDocuments::graph(std::string const & filename) const
+{
+  return find_(filename).graph;
+}
+
+std::vector<std::string>
+ReloadableDocuments::files() const
+{
+  std::vector<std::string> result;
+  for (auto const & doc : docs_) {
+    for (auto const & f : doc.graph.files()) {
+      if (f != "-" && std::find(result.begin(), result.end(), f) == result.end())
+      { result.push_back(f); }
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------
+
+bool
+ReloadableDocuments::reparse_(document & doc, change & result)
+{
+  result.filename = doc.filename;
+  result.old_id = result.new_id = doc.pset.id();
+  try {
+    intermediate_table tbl;
+    cet::include_graph graph;
+    ParameterSet pset;
+    parse_document(doc.filename, maker_, tbl, graph);
+    make_ParameterSet(std::move(tbl), pset);
+    ParameterSetRegistry::put(pset);
+    result.new_id = pset.id();
+    result.changed_keys = pset.get_differing_keys(doc.pset);
+    doc.pset = std::move(pset);
+    doc.graph = std::move(graph);
+  }
+  catch (std::exception const & e) {
+    result.error = e.what();
+  }
+  return ! result.ok() || result.new_id != result.old_id;
+}
+
+std::vector<ReloadableDocuments::change>
+ReloadableDocuments::reload()
+{
+  std::vector<change> result;
+  digests current;
+  for (auto & doc : docs_) {
+    change c;
+    if (is_stale(doc.graph, current) && reparse_(doc, c))
+    { result.push_back(std::move(c)); }
+  }
+  return result;
+}
+
+std::vector<ReloadableDocuments::change>
+ReloadableDocuments::reload(std::vector<std::string> const & changed_files)
+{
+  std::vector<change> result;
+  digests current;
+  for (auto & doc : docs_) {
+    change c;
+    if (is_stale(doc.graph, current, &changed_files) && reparse_(doc, c))
+    { result.push_back(std::move(c)); }
+  }
+  return result;
+}
+
+// ======================================================================
@@ -0,0 +1,95 @@
+#ifndef fhiclcpp_ReloadableDocuments_h
+#define fhiclcpp_ReloadableDocuments_h
+
+// ======================================================================
+//
+// ReloadableDocuments - a set of FHiCL documents whose ParameterSets
+//                       are kept up to date with their files
+//
+// Each document records the files it #included, with a digest of their
+// contents. reload() re-parses only the documents for which one of
+// those files has since changed, and reports, per document whose
+// ParameterSet changed, the new ParameterSetID and the top-level keys
+// whose values differ. Typical use with a cet::file_watcher:
+//
+//   cet::file_watcher w;
+//   w.watch(docs.files());
+//   for (;;) {
+//     auto changes = docs.reload(w.wait(-1));
+//     w.watch(docs.files());  // follow any new #includes
+//     ...
+//   }
+//
+// The ParameterSet of each document is put into the
+// ParameterSetRegistry. Not thread-safe.
+//
+// ======================================================================
+
+#include "cetlib/filepath_maker.h"
+#include "cetlib/include_graph.h"
+#include "cpp0x/string"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/ParameterSetID.h"
+#include <vector>
+
+namespace fhicl {
+  class ReloadableDocuments;
+}
+
+// ----------------------------------------------------------------------
+
+class fhicl::ReloadableDocuments {
+public:
+  // Outcome of re-parsing one document. If error is not empty, the
+  // document keeps its previous ParameterSet (old_id == new_id) and is
+  // retried by the next reload().
+  struct change {
+    std::string               filename;
+    ParameterSetID            old_id;
+    ParameterSetID            new_id;
+    std::vector<std::string>  changed_keys;  // top-level; sorted
+    std::string               error;
+    bool ok() const { return error.empty(); }
+  };
+
+  // maker is used for every (re-)parse, so it must outlive this object
+  // and should not carry per-document state (filepath_lookup_after1).
+  explicit ReloadableDocuments(cet::filepath_maker & maker);
+
+  // Parse filename (throwing on failure) and start tracking it.
+  ParameterSet const & add(std::string const & filename);
+
+  ParameterSet const & get(std::string const & filename) const;
+  cet::include_graph const & graph(std::string const & filename) const;
+
+  // Every file read by any of the documents, as spelled by maker.
+  std::vector<std::string> files() const;
+
+  // Re-parse the documents whose files' contents have changed.
+  std::vector<change> reload();
+  // As above, considering only the named files (e.g. as reported by a
+  // cet::file_watcher), so that unaffected files are not read at all.
+  std::vector<change> reload(std::vector<std::string> const & changed_files);
+
+private:
+  struct document {
+    std::string         filename;
+    ParameterSet        pset;
+    cet::include_graph  graph;
+  };
+
+  cet::filepath_maker &  maker_;
+  std::vector<document>  docs_;
+
+  document const & find_(std::string const & filename) const;
+  bool reparse_(document & doc, change & result);
+
+}; // ReloadableDocuments
+
+// ======================================================================
+
+#endif /* fhiclcpp_ReloadableDocuments_h */
+
+// Local Variables:
+// mode: c++
+// End:
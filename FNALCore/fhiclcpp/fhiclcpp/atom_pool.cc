@@ -0,0 +1,108 @@
+// ======================================================================
+//
+// atom_pool: Opt-in, process-wide, thread-safe pool of the atoms held
+//            by ParameterSets
+//
+// ======================================================================
+
+#include "fhiclcpp/atom_pool.h"
+
+#include "fhiclcpp/coding.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+using fhicl::atom_pool;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  // Independently locked shards, so that threads building ParameterSets
+  // concurrently (e.g. make_ParameterSets()) seldom contend.
+  std::size_t const n_shards = 16u;
+
+  struct shard
+  {
+    std::mutex                       mutex;
+    std::unordered_set<std::string>  strings;
+  };
+
+  struct pool_state
+  {
+    std::atomic<bool>         enabled  { false };
+    shard                     shards[n_shards];
+    std::atomic<std::size_t>  strings  { 0u };
+    std::atomic<std::size_t>  bytes    { 0u };
+    std::atomic<std::size_t>  requests { 0u };
+    std::atomic<std::size_t>  hits     { 0u };
+  };
+
+  pool_state &
+    state( )
+  {
+    static pool_state s;
+    return s;
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+void
+  atom_pool::enable( bool on )
+{
+  state().enabled = on;
+}
+
+bool
+  atom_pool::enabled( )
+{
+  return state().enabled;
+}
+
+auto
+  atom_pool::stats( )
+  -> statistics
+{
+  pool_state const & s = state();
+  return { s.strings, s.bytes, s.requests, s.hits };
+}
+
+// ----------------------------------------------------------------------
+
+std::string const &
+  atom_pool::intern( std::string const & text )
+{
+  pool_state & s = state();
+  shard & sh = s.shards[std::hash<std::string>()(text) % n_shards];
+  ++s.requests;
+  std::lock_guard<std::mutex> lock(sh.mutex);
+  // Elements of an unordered_set keep their addresses on rehashing.
+  auto const result = sh.strings.insert(text);
+  if( result.second ) {
+    ++s.strings;
+    s.bytes += text.size();
+  }
+  else
+    ++s.hits;
+  return *result.first;
+}
+
+void
+  atom_pool::intern_atoms( boost::any & value )
+{
+  using namespace fhicl::detail;
+  if( ! enabled() || is_table(value) || is_interned(value) )
+    return;
+  if( is_sequence(value) ) {
+    for( auto & elt : boost::any_cast<ps_sequence_t &>(value) )
+      intern_atoms(elt);
+    return;
+  }
+  interned_atom const atom = { &intern(boost::any_cast<ps_atom_t const &>(value)) };
+  value = atom;
+}
+
+// ======================================================================
@@ -0,0 +1,65 @@
+#ifndef fhiclcpp_atom_pool_h
+#define fhiclcpp_atom_pool_h
+
+// ======================================================================
+//
+// atom_pool: Opt-in, process-wide, thread-safe pool of the atoms held
+//            by ParameterSets
+//
+// While the pool is enabled, each atom put into a ParameterSet (directly
+// or within a sequence) is replaced by a reference to the pool's single
+// copy of its text, so that the many repetitions of module types,
+// labels, true/false, small numbers and so on in a large registry are
+// held once. Decoding and printing are unaffected, as is ParameterSetID.
+//
+// Pooled strings are never released: the pool should be enabled before
+// a large registry is populated, and left enabled.
+//
+// ======================================================================
+
+#include "boost/any.hpp"
+#include <cstddef>
+#include <string>
+
+namespace fhicl {
+  class atom_pool;
+}
+
+// ----------------------------------------------------------------------
+
+class fhicl::atom_pool
+{
+public:
+  struct statistics
+  {
+    std::size_t strings;    // Distinct strings held.
+    std::size_t bytes;      // Their total length.
+    std::size_t requests;   // Atoms interned.
+    std::size_t hits;       // Of those, atoms already held.
+  };
+
+  atom_pool( ) = delete;
+
+  // control:
+  static void        enable ( bool on = true );
+  static bool        enabled( );
+  static statistics  stats  ( );
+
+  // The pool's copy of text, added if necessary.
+  static std::string const &
+    intern( std::string const & text );
+
+  // Replace each atom of value (within sequences, too) by its pooled
+  // form; does nothing unless the pool is enabled.
+  static void
+    intern_atoms( boost::any & value );
+
+};  // atom_pool
+
+// ======================================================================
+
+#endif /* fhiclcpp_atom_pool_h */
+
+// Local Variables:
+// mode: c++
+// End:
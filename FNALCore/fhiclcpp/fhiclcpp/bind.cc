@@ -0,0 +1,65 @@
+// ======================================================================
+//
+// bind - decode a ParameterSet into a plain C++ struct in one pass
+//
+// ======================================================================
+
+#include "fhiclcpp/bind.h"
+
+#include "cetlib/exception.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
+
+using namespace fhicl;
+using fhicl::detail::bound_key;
+
+// ----------------------------------------------------------------------
+
+std::string
+  bound_key::to_string( ) const
+{
+  std::string result = parent ? parent->to_string() : std::string();
+  if( name == nullptr )
+    result += '[' + std::to_string(index) + ']';
+  else {
+    if( parent )
+      result += '.';
+    result += name;
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------
+
+ParameterSet const &
+  detail::bound_table( boost::any const & a, bound_key const & key )
+{
+  if( ! is_table(a) )
+    throw fhicl::exception(type_mismatch, key.to_string())
+      << "-- not a table\n";
+  return ParameterSetRegistry::get(boost::any_cast<ParameterSetID const &>(a));
+}
+
+detail::ps_sequence_t const &
+  detail::bound_sequence( boost::any const & a, bound_key const & key )
+{
+  if( ! is_sequence(a) )
+    throw fhicl::exception(type_mismatch, key.to_string())
+      << "-- not a sequence\n";
+  return boost::any_cast<ps_sequence_t const &>(a);
+}
+
+void
+  detail::throw_missing( bound_key const & key )
+{
+  throw fhicl::exception(cant_find, key.to_string());
+}
+
+void
+  detail::throw_mismatch( bound_key const & key, std::exception const & e )
+{
+  if( auto const ce = dynamic_cast<cet::exception const *>(&e) )
+    throw fhicl::exception(type_mismatch, key.to_string(), *ce);
+  throw fhicl::exception(type_mismatch, key.to_string() + "\n" + e.what());
+}
+
+// ======================================================================
@@ -0,0 +1,272 @@
+#ifndef fhiclcpp_bind_h
+#define fhiclcpp_bind_h
+
+// ======================================================================
+//
+// bind - decode a ParameterSet into a plain C++ struct in one pass
+//
+// A struct is made bindable by listing its fields, at global scope:
+//
+//   struct Gen {
+//     int                 seed;
+//     std::string         tag = "x";   // default for an optional field
+//     std::vector<double> weights;
+//   };
+//   FHICL_BINDING( Gen
+//                , FHICL_REQUIRED(seed)
+//                , FHICL_OPTIONAL(tag)
+//                , FHICL_OPTIONAL(weights)
+//                )
+//
+//   Gen const gen = fhicl::bind<Gen>(pset);
+//
+// Each field is looked up under its own name. A field may be of any
+// type that ParameterSet::get<>() supports, of another bindable struct
+// (decoded from a nested table), or a std::vector of either. Unknown
+// keys are ignored; a missing required key or a value of the wrong
+// type throws a fhicl::exception naming the full key, e.g.
+// "physics.gen.weights[2]".
+//
+// bind() walks the ParameterSet's keys and the (sorted) field list
+// together, so each key is visited once and no key is split, searched
+// for or built into a string (unless an error is reported); after
+// that, fields are ordinary data members.
+//
+// ======================================================================
+
+#include "boost/any.hpp"
+#include "cpp0x/string"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/coding.h"
+#include "fhiclcpp/exception.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+namespace fhicl {
+
+  // Specialized, via FHICL_BINDING, for each bindable struct.
+  template< class Config >
+    struct binding { };
+
+  template< class Config >
+    void
+    bind( ParameterSet const & pset, Config & result );
+
+  template< class Config >
+    Config
+    bind( ParameterSet const & pset );
+
+  namespace detail {
+
+    // The key of the value being bound, built into a string only when
+    // an error is reported: a field name, or a sequence index if name
+    // is null, below parent.
+    struct bound_key
+    {
+      bound_key const * parent;
+      char const *      name;
+      std::size_t       index;
+
+      std::string
+        to_string( ) const;
+    };
+
+    template< class Config >
+      struct field
+    {
+      char const * name;
+      bool         required;
+      void      (* decode)( boost::any const &, Config &, bound_key const & );
+    };
+
+    template< class T >
+      class is_bound
+    {
+      template< class U >
+        static std::true_type   test( decltype(binding<U>::fields(), 0) );
+      template< class U >
+        static std::false_type  test( ... );
+    public:
+      static constexpr bool value = decltype(test<T>(0))::value;
+    };
+
+    // Out-of-line helpers; see bind.cc.
+    ParameterSet const &
+      bound_table( boost::any const & a, bound_key const & key );
+    ps_sequence_t const &
+      bound_sequence( boost::any const & a, bound_key const & key );
+    [[noreturn]] void
+      throw_missing( bound_key const & key );
+    [[noreturn]] void
+      throw_mismatch( bound_key const & key, std::exception const & e );
+
+    template< class Config >
+      void
+      bind_table( ParameterSet const & pset, Config & result
+                , bound_key const * parent );
+
+    template< class T >
+      void
+      decode_value( boost::any const & a, T & result, bound_key const & key )
+    try
+    {
+      decode(a, result);
+    }
+    catch( std::exception const & e )
+    {
+      throw_mismatch(key, e);
+    }
+
+    template< class T >
+      typename std::enable_if< is_bound<T>::value >::type
+      bind_value( boost::any const & a, T & result, bound_key const & key )
+    {
+      bind_table(bound_table(a, key), result, &key);
+    }
+
+    template< class T >
+      typename std::enable_if< ! is_bound<T>::value >::type
+      bind_value( boost::any const & a, T & result, bound_key const & key )
+    {
+      decode_value(a, result, key);
+    }
+
+    template< class T >
+      void
+      bind_value( boost::any const & a, std::vector<T> & result
+                , bound_key const & key )
+    {
+      if( ! is_bound<T>::value && ! is_sequence(a) ) {
+        // Possibly a sequence in string form; let decode() judge.
+        decode_value(a, result, key);
+        return;
+      }
+      ps_sequence_t const & seq = bound_sequence(a, key);
+      result.resize(seq.size());
+      for( std::size_t i = 0u; i != seq.size(); ++i ) {
+        bound_key const elt = { &key, nullptr, i };
+        bind_value(seq[i], result[i], elt);
+      }
+    }
+
+    template< class Config, class T, T Config::* Member >
+      void
+      decode_field( boost::any const & a, Config & result
+                  , bound_key const & key )
+    {
+      bind_value(a, result.*Member, key);
+    }
+
+    template< class Config, class T, T Config::* Member >
+      field<Config>
+      make_field( char const * name, bool required )
+    {
+      field<Config> const f = { name, required
+                              , &decode_field<Config, T, Member> };
+      return f;
+    }
+
+    template< class Config >
+      std::vector< field<Config> >
+      sorted_fields( std::initializer_list< field<Config> > fields )
+    {
+      std::vector< field<Config> > result(fields);
+      std::sort( result.begin(), result.end()
+               , []( field<Config> const & a, field<Config> const & b )
+                 { return std::strcmp(a.name, b.name) < 0; }
+               );
+      return result;
+    }
+
+    // Walks pset's keys and the fields of Config, both sorted by name.
+    class binder
+    {
+    public:
+      template< class Config >
+        static void
+        bind( ParameterSet const & pset, Config & result
+            , bound_key const * parent )
+      {
+        auto it = pset.mapping_.begin();
+        auto const e = pset.mapping_.end();
+        for( auto const & f : binding<Config>::fields() ) {
+          while( it != e && it->first.compare(f.name) < 0 )
+            ++it;
+          bound_key const key = { parent, f.name, 0u };
+          if( it != e && it->first == f.name )
+            f.decode(it->second, result, key);
+          else if( f.required )
+            throw_missing(key);
+        }
+      }
+    };  // binder
+
+    template< class Config >
+      void
+      bind_table( ParameterSet const & pset, Config & result
+                , bound_key const * parent )
+    {
+      binder::bind(pset, result, parent);
+    }
+
+  }  // detail
+
+}  // fhicl
+
+// ----------------------------------------------------------------------
+
+template< class Config >
+  void
+  fhicl::bind( ParameterSet const & pset, Config & result )
+{
+  static_assert( detail::is_bound<Config>::value
+               , "fhicl::bind(): Config has no FHICL_BINDING" );
+  detail::bind_table(pset, result, nullptr);
+}
+
+template< class Config >
+  Config
+  fhicl::bind( ParameterSet const & pset )
+{
+  Config result;
+  bind(pset, result);
+  return result;
+}
+
+// ----------------------------------------------------------------------
+
+#define FHICL_BINDING(CONFIG, ...)                                      \
+  namespace fhicl {                                                     \
+    template< >                                                         \
+      struct binding< CONFIG >                                          \
+    {                                                                   \
+      typedef  CONFIG  config_type;                                     \
+      static std::vector< detail::field<CONFIG> > const &               \
+        fields( )                                                       \
+      {                                                                 \
+        static std::vector< detail::field<CONFIG> > const result        \
+          = detail::sorted_fields<CONFIG>({ __VA_ARGS__ });             \
+        return result;                                                  \
+      }                                                                 \
+    };                                                                  \
+  }
+
+#define FHICL_FIELD_(NAME, REQUIRED)                                    \
+  ::fhicl::detail::make_field< config_type                              \
+                             , decltype(config_type::NAME)              \
+                             , &config_type::NAME                       \
+                             >(#NAME, REQUIRED)
+
+#define FHICL_REQUIRED(NAME)  FHICL_FIELD_(NAME, true)
+#define FHICL_OPTIONAL(NAME)  FHICL_FIELD_(NAME, false)
+
+// ======================================================================
+
+#endif /* fhiclcpp_bind_h */
+
+// Local Variables:
+// mode: c++
+// End:
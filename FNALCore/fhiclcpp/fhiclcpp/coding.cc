@@ -7,10 +7,11 @@
 #include "fhiclcpp/coding.h"
 
 #include "cetlib/canonical_string.h"
-#include "cetlib/canonical_number.h"
 #include "cpp0x/cstddef"
 #include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/number.h"
+#include <cctype>
 #include <cstdlib>
 #include <limits>
 #include <stdexcept>
@@ -68,7 +69,7 @@ static  void
   if( is_sequence(a) )
     throw fhicl::exception(type_mismatch, "can't obtain atom from sequence");
 
-  result = any_cast<std::string>(a);
+  result = atom_text(a);
   #if 0
   if( result.size() >= 2 && result[0] == '\"' && result.end()[-1] == '\"' )
     result = cet::unescape( result.substr(1, result.size()-2) );
@@ -82,9 +83,7 @@ fhicl::detail::is_nil(boost::any const & val )
 {
   bool result = false;
   if (!(is_table(val) || is_sequence(val))) {
-    std::string str;
-    atom_rep(val, str);
-    result = (str == canon_nil());
+    result = (atom_text(val) == canon_nil());
   }
   return result;
 }
@@ -108,6 +107,22 @@ ps_atom_t  // string (with quotes)
   return extended_value::atom_t(xval);
 }
 
+ps_atom_t  // string (with quotes), moved
+  fhicl::detail::encode( std::string && value )
+{
+  // A double-quoted string needing no escapes is already canonical.
+  bool canonical =  value.size() >= 2
+                 && value[0] == '\"' && value.end()[-1] == '\"';
+  for( std::size_t i = 1; canonical && i + 1 < value.size(); ++i ) {
+    char const c = value[i];
+    canonical = std::isprint(static_cast<unsigned char>(c))
+             && c != '\"' && c != '\'' && c != '\\';
+  }
+  if( ! canonical )
+    return encode(static_cast<std::string const &>(value));
+  return std::move(value);
+}
+
 ps_atom_t  // string (with quotes)
   fhicl::detail::encode( char const * value )
 {
@@ -132,15 +147,17 @@ ParameterSetID  // table
   return ParameterSetRegistry::put(value);
 }
 
+ParameterSetID  // table
+  fhicl::detail::encode( ParameterSet && value )
+{
+  return ParameterSetRegistry::put(std::move(value));
+}
+
 ps_atom_t  // unsigned
   fhicl::detail::encode( std::uintmax_t value )
 {
-  std::string result = lexical_cast<std::string>(value);
-  if( result.size() > 6 ) {
-    std::size_t sz = result.size() - 1;
-    result.insert(1, ".");
-    result += "e+" + lexical_cast<std::string>(sz);
-  }
+  std::string result;
+  format_number(value, result);
   return result;
 }
 
@@ -166,7 +183,7 @@ ps_atom_t  // floating-point
     return encode(chopped);
 
   std::string result;
-  cet::canonical_number( lexical_cast<std::string>(value), result );
+  format_number(value, result);
   return result;
 }
 
@@ -183,6 +200,42 @@ void  // string without delimiting quotes
     result = cet::unescape( result.substr(1, result.size()-2) );
 }
 
+void  // string without delimiting quotes, moved
+  fhicl::detail::decode_moved( any && a, std::string & result )
+{
+  if( a.type() != typeid(std::string) ) {
+    decode(a, result);
+    return;
+  }
+  std::string & str = any_cast<std::string &>(a);
+  if( str == canon_nil() )
+    throw fhicl::exception(type_mismatch, "can't obtain string from nil");
+
+  // Only quoted strings without escapes are moved, leaving the atom
+  // empty so that restore_moved() can recognize and rebuild it.
+  if( str.size() < 2 || str[0] != '\"' || str.end()[-1] != '\"'
+      || str.find('\\') != std::string::npos ) {
+    decode(a, result);
+    return;
+  }
+  str.erase(str.size() - 1, 1).erase(0, 1);
+  result.swap(str);
+  str.clear();
+}
+
+void  // string
+  fhicl::detail::restore_moved( any & a, std::string & value )
+{
+  if( a.type() != typeid(std::string) )
+    return;
+  std::string & str = any_cast<std::string &>(a);
+  if( ! str.empty() )
+    return;
+  str.swap(value);
+  str.insert(str.begin(), '\"');
+  str.push_back('\"');
+}
+
 void  // nil
   fhicl::detail::decode( any const & a, void * & result )
 {
@@ -226,6 +279,8 @@ void  // unsigned
 {
   std::string str;
   decode(a, str);
+  if( parse_number(str, result) )
+    return;
 
   extended_value xval;
   std::string unparsed;
@@ -247,6 +302,8 @@ void  // signed
 {
   std::string str;
   decode(a, str);
+  if( parse_number(str, result) )
+    return;
 
   extended_value xval;
   std::string unparsed;
@@ -268,6 +325,8 @@ void  // floating-point
 {
   std::string str;
   decode(a, str);
+  if( parse_number(str, result) )
+    return;
 
   extended_value xval;
   std::string unparsed;
@@ -34,16 +34,37 @@ namespace fhicl {  namespace detail {
     is_table( boost::any const & val )
   { return val.type() == typeid(ParameterSetID); }
 
+  // An atom whose text is held by the atom_pool (see atom_pool.h); it
+  // is stored in place of a ps_atom_t when interning is enabled.
+  struct interned_atom
+  {
+    ps_atom_t const * text;
+  };
+
+  inline  bool
+    is_interned( boost::any const & val )
+  { return val.type() == typeid(interned_atom); }
+
+  // The text of an atom, however it is held.
+  inline  ps_atom_t const &
+    atom_text( boost::any const & val )
+  {
+    return is_interned(val) ? *boost::any_cast<interned_atom const &>(val).text
+                            : boost::any_cast<ps_atom_t const &>(val);
+  }
+
   bool
   is_nil( boost::any const & val );
 
 // ----------------------------------------------------------------------
 
   ps_atom_t      encode( std::string     const & );  // string (w/ quotes)
+  ps_atom_t      encode( std::string          && );  // string (moved)
   ps_atom_t      encode( char            const * );  // string (w/ quotes)
   ps_atom_t      encode( void *                  );  // nil
   ps_atom_t      encode( bool                    );  // bool
   ParameterSetID encode( ParameterSet    const & );  // table
+  ParameterSetID encode( ParameterSet         && );  // table (moved)
   ps_atom_t      encode( std::uintmax_t          );  // unsigned
   template< class T >
   typename tt::enable_if< tt::is_uint<T>::value, ps_atom_t >::type
@@ -61,6 +82,8 @@ namespace fhicl {  namespace detail {
   template< class T >
   ps_sequence_t  encode( std::vector<T>  const & );  // sequence
   template< class T >
+  ps_sequence_t  encode( std::vector<T>       && );  // sequence (moved)
+  template< class T >
   typename tt::disable_if< tt::is_numeric<T>::value, std::string >::type
                  encode( T               const & );  // none of the above
 
@@ -91,6 +114,22 @@ namespace fhicl {  namespace detail {
   typename tt::disable_if< tt::is_numeric<T>::value, void >::type
         decode( boost::any const &, T                  & );  // none of the above
 
+  // Decoding of a value that is no longer needed, whose string atoms
+  // may be moved into the result. If decoding fails, the value is left
+  // as it was.
+  void  decode_moved( boost::any &&, std::string         & );  // string
+  template< class T >
+  void  decode_moved( boost::any &&, std::vector<T>      & );  // sequence
+  template< class T >
+  void  decode_moved( boost::any &&, T                   & );  // any other
+
+  // Undoing of a successful decode_moved(), moving a result back.
+  void  restore_moved( boost::any &, std::string         & );  // string
+  template< class T >
+  void  restore_moved( boost::any &, std::vector<T>      & );  // sequence
+  template< class T >
+  void  restore_moved( boost::any &, T                   & );  // any other
+
 } }  // fhicl::detail, fhicl
 
 // ======================================================================
@@ -144,6 +183,18 @@ fhicl::detail::ps_sequence_t
   return result;
 }
 
+template< class T >  // sequence (moved)
+fhicl::detail::ps_sequence_t
+  fhicl::detail::encode( std::vector<T> && value )
+{
+  ps_sequence_t  result;
+  result.reserve(value.size());
+  for( auto & elt : value )
+    result.push_back( boost::any(encode(std::move(elt))) );
+  value.clear();
+  return result;
+}
+
 template< class T >  // none of the above
 typename tt::disable_if< tt::is_numeric<T>::value, std::string >::type
   fhicl::detail::encode( T const & value )
@@ -195,7 +246,7 @@ template< class T >  // sequence
 void
   fhicl::detail::decode( boost::any const & a, std::vector<T> & result )
 {
-  if( a.type() == typeid(std::string) ) {
+  if( a.type() == typeid(std::string) || is_interned(a) ) {
     typedef  fhicl::extended_value       extended_value;
     typedef  extended_value::sequence_t  sequence_t;
 
@@ -242,6 +293,60 @@ typename tt::disable_if< tt::is_numeric<T>::value, void >::type
   result = boost::any_cast<T>(a);
 }
 
+// ----------------------------------------------------------------------
+
+template< class T >  // sequence
+void
+  fhicl::detail::decode_moved( boost::any && a, std::vector<T> & result )
+{
+  if( ! is_sequence(a) ) {
+    decode(a, result);
+    return;
+  }
+  ps_sequence_t & seq = boost::any_cast<ps_sequence_t &>(a);
+  std::vector<T> values;
+  values.reserve(seq.size());
+  T via;
+  try {
+    for( auto & elt : seq ) {
+      decode_moved(std::move(elt), via);
+      values.push_back(std::move(via));
+    }
+  }
+  catch( ... ) {
+    // Put back the atoms moved from the elements already decoded.
+    for( std::size_t i = 0; i != values.size(); ++i )
+      restore_moved(seq[i], values[i]);
+    throw;
+  }
+  result.swap(values);
+}
+
+template< class T >  // any other
+void
+  fhicl::detail::decode_moved( boost::any && a, T & result )
+{
+  decode(a, result);
+}
+
+// ----------------------------------------------------------------------
+
+template< class T >  // sequence
+void
+  fhicl::detail::restore_moved( boost::any & a, std::vector<T> & value )
+{
+  if( ! is_sequence(a) )
+    return;
+  ps_sequence_t & seq = boost::any_cast<ps_sequence_t &>(a);
+  for( std::size_t i = 0; i != seq.size() && i != value.size(); ++i )
+    restore_moved(seq[i], value[i]);
+}
+
+template< class T >  // any other: decoded by copying
+void
+  fhicl::detail::restore_moved( boost::any &, T & )
+{ }
+
 // ======================================================================
 
 #endif /* fhiclcpp_coding_h */
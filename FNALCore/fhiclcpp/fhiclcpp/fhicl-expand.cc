@@ -13,10 +13,14 @@
 //  output, and any errors during processing are written to standard
 //  error. The -o (or --output) and -e (or --error) options can be
 //  used to send output to the named files.
+//
+//  With -c (or --cache), files #included by several inputs are read
+//  and looked up only once (see cet::file_cache).
 //  ======================================================================
 
 #include "boost/program_options.hpp"
 #include "cetlib/exception.h"
+#include "cetlib/file_cache.h"
 #include "cetlib/filepath_maker.h"
 #include "cetlib/includer.h"
 #include "cpp0x/memory"
@@ -104,6 +108,8 @@ int
                   ->default_value(fhicl_env_var())
                 , "path or environment variable to be used by lookup-policy"
                 )
+    ( "cache,c" , "cache #included files and lookups across inputs"
+                )
     ;
 
   bpo::positional_options_description pd;
@@ -158,6 +164,9 @@ cerr << "Policy is " << lookup_policy
               return 1;
   }
 
+  if( varmap.count("cache") )
+    cet::file_cache::enable();
+
   // Do the real work:
 
   int nfailures = 0;
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fhiclcpp/DatabaseSupport.h"
+#include "fhiclcpp/exception.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    cerr << argv[0] << ": at least one argument required\n"
+         << "Usage: " << argv[0] << " database-file [key=value ...]\n\n"
+         << "Print the IDs of the ParameterSets in database-file whose\n"
+         << "top-level atoms match every key=value pair. The database\n"
+         << "must have been written with an index (fhicl-write-db --index).\n\n";
+    return 1;
+  }
+
+  char const* dbname = argv[1];
+
+  vector<pair<string, string>> constraints;
+  for (int i = 2; i != argc; ++i) {
+    string const arg(argv[i]);
+    auto const eq = arg.find('=');
+    if (eq == string::npos || eq == 0) {
+      cerr << argv[0] << ": expected key=value, got "
+           << arg
+           << '\n';
+      return 1;
+    }
+    constraints.emplace_back(arg.substr(0, eq), arg.substr(eq + 1));
+  }
+
+  sqlite3* db = nullptr;
+
+  int rc = sqlite3_open_v2(dbname,
+                           &db,
+                           SQLITE_OPEN_READONLY,
+                           nullptr);
+  if (rc != SQLITE_OK) {
+    cerr << argv[0] << ": unable to open SQLite3 file "
+         << dbname
+         << '\n';
+    sqlite3_close(db);
+    return 2;
+  }
+
+  try {
+    for (auto const& id : fhicl::find_parameterset_ids(db, constraints))
+      cout << id.to_string() << '\n';
+  }
+  catch (fhicl::exception const& e) {
+    cerr << argv[0] << ": query failed for "
+         << dbname
+         << '\n' << e.what() << '\n';
+    sqlite3_close(db);
+    return 3;
+  }
+
+  sqlite3_close(db);
+  return 0;
+}
@@ -1,18 +1,22 @@
 #include <iostream>
+#include <string>
 
 #include "fhiclcpp/DatabaseSupport.h"
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
-  if (argc != 3) {
+  bool const writeIndex = (argc == 4 && string(argv[1]) == "--index");
+  if (argc != 3 && !writeIndex) {
     cerr << argv[0] << ": two arguments required\n"
-         << "Usage: " << argv[0] << " fhicl-file database-file\n\n";
+         << "Usage: " << argv[0] << " [--index] fhicl-file database-file\n\n"
+         << "  --index  also write the index of top-level atoms used by\n"
+         << "           fhicl-query-db\n\n";
     return 1;
   }
 
-  char const* fhiclfile = argv[1];
-  char const* dbname   = argv[2];
+  char const* fhiclfile = argv[argc - 2];
+  char const* dbname   = argv[argc - 1];
 
   sqlite3* db = nullptr;
 
@@ -27,7 +31,7 @@ int main(int argc, char* argv[]) {
     return 2;
   }
 
-  fhicl::parse_file_and_fill_db(fhiclfile, db);
+  fhicl::parse_file_and_fill_db(fhiclfile, db, writeIndex);
   rc = sqlite3_close(db);
   if (rc != SQLITE_OK) {
     cerr << argv[0] << ": failure closing SQLite file "
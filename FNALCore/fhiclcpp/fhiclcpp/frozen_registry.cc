@@ -0,0 +1,220 @@
+// ======================================================================
+//
+// frozen_registry - a read-only, position-independent snapshot of
+//                   ParameterSets in a shared memory segment
+//
+// ======================================================================
+
+#include "fhiclcpp/frozen_registry.h"
+
+#include "fhiclcpp/ParameterSetID.h"
+#include "fhiclcpp/exception.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+using fhicl::detail::frozen_registry;
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  std::size_t const id_sz = 2 * cet::sha1::digest_sz;
+  char const magic[8] = { 'F', 'H', 'i', 'C', 'L', 'P', 'S', '1' };
+
+  struct header_t {
+    char           magic[8];
+    std::uint64_t  count;
+    std::uint64_t  bytes;
+  };
+
+  // Offsets are from the start of the segment.
+  struct entry_t {
+    char           id[id_sz];
+    std::uint64_t  offset;
+    std::uint64_t  length;
+  };
+
+  // Whether the header and every entry lie within the len bytes at
+  // addr, so that no lookup reads outside them.
+  bool
+    well_formed( char const * addr, std::size_t len )
+  {
+    header_t h;
+    std::memcpy(&h, addr, sizeof h);
+    if( std::memcmp(h.magic, magic, sizeof magic) != 0 || h.bytes != len
+     || h.count > (len - sizeof h) / sizeof(entry_t) )
+      return false;
+    std::uint64_t const table_end = sizeof h + h.count * sizeof(entry_t);
+    entry_t const * const entries = reinterpret_cast<entry_t const *>(addr + sizeof h);
+    for( std::uint64_t i = 0u; i != h.count; ++i ) {
+      entry_t const & e = entries[i];
+      if( e.offset < table_end || e.offset > len || e.length > len - e.offset )
+        return false;
+    }
+    return true;
+  }
+
+  bool
+    id_less( entry_t const & e, std::string const & id )
+  { return std::strncmp(e.id, id.c_str(), id_sz) < 0; }
+
+  fhicl::exception
+    segment_error( char const * what )
+  {
+    return fhicl::exception(fhicl::cant_open_db, "Frozen ParameterSet registry: ")
+      << what << ": " << std::strerror(errno) << '\n';
+  }
+
+  // An anonymous memory file where available, otherwise an unlinked
+  // temporary file.
+  int
+    new_segment( )
+  {
+    int fd = -1;
+#if defined(__linux__) && defined(SYS_memfd_create)
+    unsigned const allow_sealing = 2u;  // MFD_ALLOW_SEALING
+    fd = ::syscall(SYS_memfd_create, "fhicl-registry", allow_sealing);
+#endif
+    if( fd < 0 ) {
+      char const * const tmpdir = std::getenv("TMPDIR");
+      std::string name = std::string(tmpdir ? tmpdir : "/tmp")
+                       + "/fhicl-registry-XXXXXX";
+      fd = ::mkstemp(&name[0]);
+      if( fd >= 0 )
+        ::unlink(name.c_str());
+    }
+    if( fd < 0 )
+      throw segment_error("can't create segment");
+    return fd;
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+int
+  frozen_registry::create( entries_t const & entries )
+{
+  header_t h;
+  std::memcpy(h.magic, magic, sizeof magic);
+  h.count = entries.size();
+  std::uint64_t offset = sizeof h + entries.size() * sizeof(entry_t);
+
+  std::string buf(offset, '\0');
+  entry_t * e = reinterpret_cast<entry_t *>(&buf[sizeof h]);
+  for( auto const & pr : entries ) {   // sorted by ID
+    std::memset(e->id, 0, id_sz);
+    std::memcpy(e->id, pr.first.data(), std::min(pr.first.size(), id_sz));
+    e->offset = offset;
+    e->length = pr.second.size();
+    offset += pr.second.size();
+    ++e;
+  }
+  h.bytes = offset;
+  std::memcpy(&buf[0], &h, sizeof h);
+  buf.reserve(offset);
+  for( auto const & pr : entries )
+    buf += pr.second;
+
+  int const fd = new_segment();
+  for( std::size_t done = 0u; done != buf.size(); ) {
+    ssize_t const n = ::write(fd, buf.data() + done, buf.size() - done);
+    if( n < 0 && errno == EINTR )
+      continue;
+    if( n <= 0 ) {
+      ::close(fd);
+      throw segment_error("can't write segment");
+    }
+    done += n;
+  }
+#ifdef F_ADD_SEALS
+  // Best effort: temporary files can't be sealed.
+  (void) ::fcntl( fd, F_ADD_SEALS
+                , F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL );
+#endif
+  return fd;
+}  // create()
+
+// ----------------------------------------------------------------------
+
+frozen_registry::frozen_registry( int fd )
+  : fd_  ( ::dup(fd) )
+  , addr_( nullptr )
+  , len_ ( 0u )
+{
+  if( fd_ < 0 )
+    throw segment_error("bad descriptor");
+  struct stat st;
+  if( ::fstat(fd_, &st) != 0 ) {
+    ::close(fd_);
+    throw segment_error("can't stat segment");
+  }
+  len_ = st.st_size;
+  if( len_ >= sizeof(header_t) ) {
+    void * const a = ::mmap(nullptr, len_, PROT_READ, MAP_SHARED, fd_, 0);
+    if( a != MAP_FAILED )
+      addr_ = static_cast<char const *>(a);
+  }
+  if( addr_ == nullptr ) {
+    ::close(fd_);
+    throw segment_error("can't map segment");
+  }
+  if( ! well_formed(addr_, len_) ) {
+    ::munmap(const_cast<char *>(addr_), len_);
+    ::close(fd_);
+    throw fhicl::exception(cant_open_db, "Frozen ParameterSet registry: ")
+      << "not a ParameterSet segment\n";
+  }
+}
+
+frozen_registry::~frozen_registry( )
+{
+  ::munmap(const_cast<char *>(addr_), len_);
+  ::close(fd_);
+}
+
+// ----------------------------------------------------------------------
+
+std::size_t
+  frozen_registry::size( ) const
+{
+  return reinterpret_cast<header_t const *>(addr_)->count;
+}
+
+std::string
+  frozen_registry::id( std::size_t i ) const
+{
+  entry_t const & e = reinterpret_cast<entry_t const *>(addr_ + sizeof(header_t))[i];
+  return std::string(e.id, ::strnlen(e.id, id_sz));
+}
+
+std::string
+  frozen_registry::blob( std::size_t i ) const
+{
+  entry_t const & e = reinterpret_cast<entry_t const *>(addr_ + sizeof(header_t))[i];
+  return std::string(addr_ + e.offset, e.length);
+}
+
+bool
+  frozen_registry::find( std::string const & id, std::string & blob ) const
+{
+  entry_t const * const b = reinterpret_cast<entry_t const *>(addr_ + sizeof(header_t));
+  entry_t const * const e = b + size();
+  entry_t const * const it = std::lower_bound(b, e, id, id_less);
+  if( it == e || std::strncmp(it->id, id.c_str(), id_sz) != 0 )
+    return false;
+  blob.assign(addr_ + it->offset, it->length);
+  return true;
+}
+
+// ======================================================================
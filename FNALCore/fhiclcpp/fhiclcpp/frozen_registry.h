@@ -0,0 +1,72 @@
+#ifndef fhiclcpp_frozen_registry_h
+#define fhiclcpp_frozen_registry_h
+
+// ======================================================================
+//
+// frozen_registry - a read-only, position-independent snapshot of
+//                   ParameterSets in a shared memory segment
+//
+// The segment holds a table of (ID, offset, length) entries sorted by
+// ID, followed by the ParameterSets' compact strings; it contains no
+// pointers, so it may be mapped at any address, by any process that
+// inherits or is handed its file descriptor. ParameterSets are decoded
+// from it on access (see ParameterSetRegistry::freeze()).
+//
+// ======================================================================
+
+#include "cpp0x/string"
+#include <cstddef>
+#include <map>
+
+namespace fhicl {
+  namespace detail {
+    class frozen_registry;
+  }
+}
+
+// ----------------------------------------------------------------------
+
+class fhicl::detail::frozen_registry
+{
+public:
+  // ID string -> compact string.
+  typedef  std::map<std::string, std::string>  entries_t;
+
+  // Write entries to a new, sealed segment; return its descriptor.
+  static int
+    create( entries_t const & entries );
+
+  // Map the segment of fd (which is duplicated) read-only; throws
+  // cant_open_db unless it is a well-formed segment.
+  explicit
+    frozen_registry( int fd );
+  ~frozen_registry( );
+
+  frozen_registry( frozen_registry const & ) = delete;
+  frozen_registry & operator = ( frozen_registry const & ) = delete;
+
+  // observers:
+  int          fd     ( ) const { return fd_; }
+  std::size_t  size   ( ) const;
+  std::size_t  bytes  ( ) const { return len_; }
+  std::string  id     ( std::size_t i ) const;
+  std::string  blob   ( std::size_t i ) const;
+
+  // The compact string of the ParameterSet with ID id, if present.
+  bool
+    find( std::string const & id, std::string & blob ) const;
+
+private:
+  int           fd_;
+  char const *  addr_;
+  std::size_t   len_;
+
+};  // frozen_registry
+
+// ======================================================================
+
+#endif /* fhiclcpp_frozen_registry_h */
+
+// Local Variables:
+// mode: c++
+// End:
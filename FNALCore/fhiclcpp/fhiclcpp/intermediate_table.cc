@@ -65,6 +65,16 @@ intermediate_table::
 end() const
 { return boost::any_cast<table_t const &>(ex_val.value).end(); }
 
+intermediate_table::iterator
+intermediate_table::
+begin()
+{ return boost::any_cast<table_t &>(ex_val.value).begin(); }
+
+intermediate_table::iterator
+intermediate_table::
+end()
+{ return boost::any_cast<table_t &>(ex_val.value).end(); }
+
 // ----------------------------------------------------------------------
 
 bool
@@ -118,6 +118,8 @@ public:
 
   const_iterator  begin() const;
   const_iterator  end() const;
+  iterator        begin();
+  iterator        end();
 
   // Flexible insert interface.
   void  insert(std::string const & name
@@ -14,6 +14,11 @@
 #include "fhiclcpp/extended_value.h"
 #include "fhiclcpp/intermediate_table.h"
 #include "fhiclcpp/parse.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
 
 using namespace fhicl;
 
@@ -42,7 +47,8 @@ namespace fhicl { // Enable ADL
 
     case SEQUENCE: {
       ps_sequence_t result;
-      sequence_t const & seq = sequence_t(xval);
+      sequence_t const & seq = boost::any_cast<sequence_t const &>(xval.value);
+      result.reserve(seq.size());
       for( sequence_t::const_iterator it = seq.begin()
                                     , e  = seq.end(); it != e; ++it )
         result.push_back(boost::any(encode(*it)));
@@ -51,14 +57,14 @@ namespace fhicl { // Enable ADL
 
     case TABLE: {
       typedef  table_t::const_iterator  const_iterator;
-      table_t const & tbl = table_t(xval);
+      table_t const & tbl = boost::any_cast<table_t const &>(xval.value);
       ParameterSet result;
       for( const_iterator it = tbl.begin()
                         , e  = tbl.end(); it != e; ++it ) {
         if( ! it->second.in_prolog )
           result.put(it->first, it->second);
       }
-      return ParameterSetRegistry::put(result);
+      return ParameterSetRegistry::put(std::move(result));
     }
 
     case TABLEID: {
@@ -71,6 +77,37 @@ namespace fhicl { // Enable ADL
     }
     }
   }  // encode()
+
+  // As above, moving atoms, sequences and tables out of xval.
+  boost::any
+  encode( extended_value && xval )
+  {
+    switch( xval.tag ) {
+    case NIL: case BOOL: case NUMBER: case STRING:
+      return std::move(boost::any_cast<atom_t &>(xval.value));
+
+    case SEQUENCE: {
+      ps_sequence_t result;
+      sequence_t & seq = boost::any_cast<sequence_t &>(xval.value);
+      result.reserve(seq.size());
+      for( auto & elt : seq )
+        result.push_back(encode(std::move(elt)));
+      return result;
+    }
+
+    case TABLE: {
+      ParameterSet result;
+      for( auto & entry : boost::any_cast<table_t &>(xval.value) ) {
+        if( ! entry.second.in_prolog )
+          result.put(entry.first, std::move(entry.second));
+      }
+      return ParameterSetRegistry::put(std::move(result));
+    }
+
+    default:
+      return encode(static_cast<extended_value const &>(xval));
+    }
+  }  // encode()
 }
 // ----------------------------------------------------------------------
 
@@ -106,13 +143,42 @@ void
 
 // ----------------------------------------------------------------------
 
+void
+  fhicl::make_ParameterSet( intermediate_table && tbl
+                          , ParameterSet        & ps
+                          )
+{
+  for( auto & entry : tbl ) {
+    if( ! entry.second.in_prolog )
+      ps.put(entry.first, std::move(entry.second));
+  }
+}  // make_ParameterSet()
+
+// ----------------------------------------------------------------------
+
+void
+  fhicl::make_ParameterSet( extended_value && xval
+                          , ParameterSet    & ps
+                          )
+{
+  if( ! xval.is_a(TABLE) )
+    throw fhicl::exception(type_mismatch, "extended value not a table");
+
+  for( auto & entry : boost::any_cast<table_t &>(xval.value) ) {
+    if( ! entry.second.in_prolog )
+      ps.put(entry.first, std::move(entry.second));
+  }
+}  // make_ParameterSet()
+
+// ----------------------------------------------------------------------
+
 void
   fhicl::make_ParameterSet( std::string const & str
                           , ParameterSet      & ps
                           )
 {
   intermediate_table tbl;
-  parse_document(str, tbl), make_ParameterSet(tbl, ps);
+  parse_document(str, tbl), make_ParameterSet(std::move(tbl), ps);
 }  // make_ParameterSet()
 
 // ----------------------------------------------------------------------
@@ -124,7 +190,88 @@ void
                           )
 {
   intermediate_table tbl;
-  parse_document(filename, maker, tbl), make_ParameterSet(tbl, ps);
+  parse_document(filename, maker, tbl), make_ParameterSet(std::move(tbl), ps);
 }  // make_ParameterSet()
 
+// ----------------------------------------------------------------------
+
+namespace {
+
+  // Serializes, and remembers, the lookups of the wrapped policy on
+  // behalf of the workers of one make_ParameterSets() batch.
+  class shared_lookup
+    : public cet::filepath_maker
+  {
+  public:
+    explicit shared_lookup( cet::filepath_maker & maker )
+      : maker_  ( maker )
+      , mutex_  ( )
+      , resolved_( )
+    { }
+
+    virtual std::string
+      operator () ( std::string const & filename )
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = resolved_.find(filename);
+      if( it == resolved_.end() )
+        it = resolved_.emplace(filename, maker_(filename)).first;
+      return it->second;
+    }
+
+    virtual ~shared_lookup( ) noexcept
+    { }
+
+  private:
+    cet::filepath_maker &              maker_;
+    std::mutex                         mutex_;
+    std::map<std::string, std::string> resolved_;
+  };  // shared_lookup
+
+}
+
+std::vector<fhicl::make_ParameterSet_result>
+  fhicl::make_ParameterSets( std::vector<std::string> const & filenames
+                           , cet::filepath_maker            & maker
+                           , unsigned                         threads
+                           )
+{
+  std::vector<make_ParameterSet_result> results(filenames.size());
+  if( threads == 0u )
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  threads = static_cast<unsigned>(std::min<std::size_t>(threads, filenames.size()));
+
+  shared_lookup lookup(maker);
+  std::atomic<std::size_t> next(0u);
+  auto work = [&]( ) {
+    for( std::size_t i; (i = next++) < filenames.size(); ) {
+      make_ParameterSet_result & r = results[i];
+      r.filename = filenames[i];
+      try {
+        intermediate_table tbl;
+        parse_document(r.filename, lookup, tbl);
+        make_ParameterSet(std::move(tbl), r.pset);
+      }
+      catch( std::exception const & e ) {
+        r.pset = ParameterSet();
+        r.error = e.what();
+        if( r.error.empty() )
+          r.error = "exception without message";
+      }
+      catch( ... ) {
+        r.pset = ParameterSet();
+        r.error = "unknown exception";
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for( unsigned t = 1u; t < threads; ++t )
+    workers.emplace_back(work);
+  work();  // This thread takes a share too.
+  for( auto & w : workers )
+    w.join();
+  return results;
+}  // make_ParameterSets()
+
 // ======================================================================
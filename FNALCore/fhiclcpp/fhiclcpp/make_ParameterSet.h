@@ -9,7 +9,9 @@
 
 #include "cetlib/filepath_maker.h"
 #include "cpp0x/string"
+#include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/fwd.h"
+#include <vector>
 
 // ----------------------------------------------------------------------
 
@@ -25,6 +27,18 @@ namespace fhicl {
                      , ParameterSet         & ps
                      );
 
+  // As above, but moving the values out of tbl (or xval), which is left
+  // in a valid but unspecified state.
+  void
+    make_ParameterSet( intermediate_table && tbl
+                     , ParameterSet        & ps
+                     );
+
+  void
+    make_ParameterSet( extended_value && xval
+                     , ParameterSet    & ps
+                     );
+
   void
     make_ParameterSet( std::string const & str
                      , ParameterSet      & ps
@@ -36,6 +50,34 @@ namespace fhicl {
                      , ParameterSet        & ps
                      );
 
+  // Outcome of one document of a make_ParameterSets() batch: error is
+  // empty on success, and otherwise holds the text of the exception
+  // that prevented the conversion.
+  struct make_ParameterSet_result
+  {
+    std::string  filename;
+    ParameterSet pset;
+    std::string  error;
+
+    bool ok( ) const { return error.empty(); }
+  };
+
+  // Parse and convert each of filenames on up to threads worker
+  // threads (0 means one per hardware thread). Results are returned in
+  // the order of filenames; a failing document is reported in its own
+  // result and never aborts the batch. Nested tables are put into the
+  // ParameterSetRegistry as they are by make_ParameterSet(). maker is
+  // shared by the workers under a lock and each distinct filename is
+  // looked up only once per batch, so a policy with per-document state
+  // (filepath_lookup_after1) should not be used here. Enable
+  // cet::file_cache to share the contents of common #included files
+  // between the documents.
+  std::vector<make_ParameterSet_result>
+    make_ParameterSets( std::vector<std::string> const & filenames
+                      , cet::filepath_maker            & maker
+                      , unsigned                         threads = 0u
+                      );
+
 }  // fhicl
 
 // ======================================================================
@@ -0,0 +1,360 @@
+// ======================================================================
+//
+// number - canonical forms of FHiCL numbers, and their values
+//
+// ======================================================================
+
+#include "fhiclcpp/number.h"
+
+#include "cetlib/canonical_number.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <locale.h>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+// ----------------------------------------------------------------------
+
+namespace {
+
+  inline bool
+    is_digit( char c )
+  { return c >= '0' && c <= '9'; }
+
+  // Write value's decimal digits to the end of buf; return the first.
+  template< std::size_t N >
+  char *
+    decimal( std::uintmax_t value, char (&buf)[N] )
+  {
+    char * p = buf + N;
+    do {
+      *--p = char('0' + value % 10u);
+      value /= 10u;
+    } while( value != 0u );
+    return p;
+  }
+
+  void
+    append_decimal( long value, std::string & result )
+  {
+    if( value < 0 )
+      result += '-';
+    char buf[24];
+    char * const p = decimal(value < 0 ? 0ul - (unsigned long)value
+                                       : (unsigned long)value, buf);
+    result.append(p, buf + sizeof buf);
+  }
+
+  // The canonical form of the number with the digits
+  // [wb, we) . [fb, fe) x 10^exp10, as cet::canonical_number() makes it.
+  bool
+    canonical_digits( bool negative
+                    , char const * wb, char const * we
+                    , char const * fb, char const * fe
+                    , long exp10
+                    , std::string & result )
+  {
+    std::size_t const wn = we - wb;
+    std::size_t const n  = wn + (fe - fb);
+    if( n == 0u )
+      return false;
+    auto digit = [=]( std::size_t i ) { return i < wn ? wb[i] : fb[i - wn]; };
+
+    std::size_t first = 0u;
+    while( first != n && digit(first) == '0' )
+      ++first;
+    if( first == n ) {  // zero has no sign
+      result += '0';
+      return true;
+    }
+    std::size_t last = n - 1u;
+    while( digit(last) == '0' )
+      --last;
+    long const ndig = last - first + 1u;
+    long exp = exp10 + long(wn) - long(first);  // decimal point at left
+
+    if( negative )
+      result += '-';
+    if( ndig <= exp && exp <= 6L ) {
+      for( std::size_t i = first; i <= last; ++i )
+        result += digit(i);
+      result.append(exp - ndig, '0');
+    }
+    else {
+      result += digit(first);
+      if( ndig > 1 ) {
+        result += '.';
+        for( std::size_t i = first + 1u; i <= last; ++i )
+          result += digit(i);
+      }
+      if( --exp != 0 ) {
+        result += 'e';
+        append_decimal(exp, result);
+      }
+    }
+    return true;
+  }
+
+  // Value of a hexadecimal (bits == 4) or binary (bits == 1) digit, or -1.
+  inline int
+    radix_digit( char c, unsigned bits )
+  {
+    if( bits == 1u )
+      return c == '0' || c == '1' ? c - '0' : -1;
+    if( is_digit(c) )         return c - '0';
+    if( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+    if( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+    return -1;
+  }
+
+  // Digits [b, e) of a hexadecimal or binary literal [literal, e).
+  bool
+    canonical_radix( char const * literal
+                   , char const * b, char const * e
+                   , unsigned bits
+                   , std::string & result )
+  {
+    for( char const * p = b; p != e; ++p )
+      if( radix_digit(*p, bits) < 0 )
+        return false;
+    while( b != e && *b == '0' )
+      ++b;
+    if( std::size_t(e - b) * bits > 64u )
+      return cet::canonical_number(std::string(literal, e), result);
+
+    std::uintmax_t value = 0u;
+    for( ; b != e; ++b )
+      value = (value << bits) | unsigned(radix_digit(*b, bits));
+    char buf[24];
+    char const * const p = decimal(value, buf);
+    return canonical_digits(false, p, buf + sizeof buf, nullptr, nullptr, 0L, result);
+  }
+
+  // The parts of a plain decimal number:
+  // -?[0-9]+(\.[0-9]+)?([eE][-+]?[0-9]{1,4})?
+  struct decimal_parts
+  {
+    bool          negative;
+    char const *  wb;  char const * we;  // whole
+    char const *  fb;  char const * fe;  // fraction
+    long          exp10;
+  };
+
+  bool
+    split( std::string const & atom, decimal_parts & parts )
+  {
+    char const *       it  = atom.data();
+    char const * const end = it + atom.size();
+    parts.negative = it != end && *it == '-';
+    if( parts.negative )
+      ++it;
+    parts.wb = it;
+    while( it != end && is_digit(*it) )
+      ++it;
+    parts.we = it;
+    if( parts.wb == parts.we )
+      return false;
+    parts.fb = parts.fe = it;
+    if( it != end && *it == '.' ) {
+      parts.fb = ++it;
+      while( it != end && is_digit(*it) )
+        ++it;
+      parts.fe = it;
+      if( parts.fb == parts.fe )
+        return false;
+    }
+    parts.exp10 = 0L;
+    if( it != end && (*it == 'e' || *it == 'E') ) {
+      bool const negexp = ++it != end && *it == '-';
+      if( it != end && (*it == '-' || *it == '+') )
+        ++it;
+      char const * const eb = it;
+      while( it != end && is_digit(*it) )
+        parts.exp10 = 10 * parts.exp10 + (*it++ - '0');
+      if( it == eb || it - eb > 4 )
+        return false;
+      if( negexp )
+        parts.exp10 = -parts.exp10;
+    }
+    return it == end;
+  }
+
+  // The exact integral magnitude of parts, if it fits.
+  bool
+    magnitude( decimal_parts const & parts, std::uintmax_t & result )
+  {
+    std::size_t const wn = parts.we - parts.wb;
+    std::size_t       n  = wn + (parts.fe - parts.fb);
+    auto digit = [&]( std::size_t i ) { return i < wn ? parts.wb[i] : parts.fb[i - wn]; };
+
+    long scale = parts.exp10 - (parts.fe - parts.fb);
+    for( ; scale < 0 && n != 0u && digit(n - 1u) == '0'; --n )
+      ++scale;
+    if( scale < 0 && n != 0u )  // not integral
+      return false;
+
+    std::uintmax_t const max = std::numeric_limits<std::uintmax_t>::max();
+    std::uintmax_t value = 0u;
+    for( std::size_t i = 0u; i != n; ++i ) {
+      unsigned const d = digit(i) - '0';
+      if( value > (max - d) / 10u )
+        return false;
+      value = 10u * value + d;
+    }
+    for( ; scale > 0 && value != 0u; --scale ) {
+      if( value > max / 10u )
+        return false;
+      value *= 10u;
+    }
+    result = value;
+    return true;
+  }
+
+  // Floating-point conversion in the "C" locale, as std::num_get does it.
+  long double
+    strtold_c( char const * str, char ** end )
+  {
+#if defined(__GLIBC__) || defined(__APPLE__)
+    static locale_t const c_locale = ::newlocale(LC_ALL_MASK, "C", locale_t(0));
+    return ::strtold_l(str, end, c_locale);
+#else
+    return std::strtold(str, end);
+#endif
+  }
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+
+bool
+  fhicl::detail::canonical_number( char const * begin, char const * end
+                                 , std::string & result )
+{
+  std::size_t const n = end - begin;
+  if( n > 2u && begin[0] == '0' && (begin[1] == 'x' || begin[1] == 'X') )
+    return canonical_radix(begin, begin + 2, end, 4u, result);
+  if( n > 2u && begin[0] == '0' && (begin[1] == 'b' || begin[1] == 'B') )
+    return canonical_radix(begin, begin + 2, end, 1u, result);
+
+  char const * it = begin;
+  if( it == end )
+    return false;
+  bool const negative = *it == '-';
+  if( *it == '+' || *it == '-' )
+    ++it;
+
+  char const * const wb = it;
+  while( it != end && is_digit(*it) )
+    ++it;
+  char const * const we = it;
+
+  char const * fb = it;
+  char const * fe = it;
+  if( it != end && *it == '.' ) {
+    fb = ++it;
+    while( it != end && is_digit(*it) )
+      ++it;
+    fe = it;
+  }
+
+  long exp10 = 0L;
+  if( it != end && (*it == 'E' || *it == 'e') ) {
+    if( ++it == end )
+      return false;
+    bool negexp = false;
+    if( *it == '+' || *it == '-' ) {
+      negexp = *it == '-';
+      if( ++it == end )
+        return false;
+    }
+    char const * const eb = it;
+    while( it != end && is_digit(*it) )
+      ++it;
+    if( it - eb > 9 )  // beyond an int; keep atoi()'s behavior
+      return cet::canonical_number(std::string(begin, end), result);
+    for( char const * p = eb; p != it; ++p )
+      exp10 = 10 * exp10 + (*p - '0');
+    if( negexp )
+      exp10 = -exp10;
+  }
+
+  if( it != end )
+    return false;
+  return canonical_digits(negative, wb, we, fb, fe, exp10, result);
+}  // canonical_number()
+
+// ----------------------------------------------------------------------
+
+void
+  fhicl::detail::format_number( std::uintmax_t value, std::string & result )
+{
+  char buf[24];
+  char const * const p = decimal(value, buf);
+  std::size_t const ndig = buf + sizeof buf - p;
+  if( ndig <= 6u ) {
+    result.append(p, ndig);
+    return;
+  }
+  result += *p;
+  result += '.';
+  result.append(p + 1, ndig - 1u);
+  result += "e+";
+  append_decimal(long(ndig - 1u), result);
+}
+
+void
+  fhicl::detail::format_number( long double value, std::string & result )
+{
+  char buf[64];
+  int const n = std::snprintf( buf, sizeof buf, "%.*Lg"
+                             , std::numeric_limits<long double>::max_digits10
+                             , value );
+  canonical_number(buf, buf + n, result);
+}
+
+// ----------------------------------------------------------------------
+
+bool
+  fhicl::detail::parse_number( std::string const & atom, std::uintmax_t & result )
+{
+  decimal_parts parts;
+  if( ! split(atom, parts) || parts.negative )
+    return false;
+  return magnitude(parts, result);
+}
+
+bool
+  fhicl::detail::parse_number( std::string const & atom, std::intmax_t & result )
+{
+  decimal_parts parts;
+  std::uintmax_t value;
+  if( ! split(atom, parts) || ! magnitude(parts, value) )
+    return false;
+  std::uintmax_t const max = std::numeric_limits<std::intmax_t>::max();
+  if( value > max + (parts.negative ? 1u : 0u) )
+    return false;
+  result = parts.negative ? std::intmax_t(0u - value) : std::intmax_t(value);
+  return true;
+}
+
+bool
+  fhicl::detail::parse_number( std::string const & atom, long double & result )
+{
+  decimal_parts parts;
+  if( ! split(atom, parts) )
+    return false;
+  int const saved = errno;
+  errno = 0;
+  char * end = nullptr;
+  long double const value = strtold_c(atom.c_str(), &end);
+  bool const ok = errno == 0 && end == atom.c_str() + atom.size();
+  errno = saved;
+  if( ok )
+    result = value;
+  return ok;
+}
+
+// ======================================================================
@@ -0,0 +1,63 @@
+#ifndef fhiclcpp_number_h
+#define fhiclcpp_number_h
+
+// ======================================================================
+//
+// number - canonical forms of FHiCL numbers, and their values
+//
+// The canonical strings are byte-for-byte those produced before by
+// cet::canonical_number() and boost::lexical_cast, so ParameterSetIDs
+// are unaffected; they are built in place, without intermediate strings
+// or streams. Hexadecimal and binary literals that fit in 64 bits are
+// converted directly; longer ones, and exponents too long for a long,
+// are left to cet::canonical_number().
+//
+// ======================================================================
+
+#include "cpp0x/cstdint"
+#include "cpp0x/string"
+
+namespace fhicl {  namespace detail {
+
+  // As cet::canonical_number(): append the canonical form of the number
+  // literal [begin, end) to result; false if it isn't one.
+  bool
+    canonical_number( char const * begin, char const * end
+                    , std::string & result );
+
+  inline  bool
+    canonical_number( std::string const & value, std::string & result )
+  { return canonical_number(value.data(), value.data() + value.size(), result); }
+
+  // Append the atom of value, as encode() has always produced it:
+  // integers of more than six digits as d.ddd...e+N, floating-point
+  // numbers rounded to std::numeric_limits<long double>::max_digits10
+  // significant digits and then canonicalized.
+  void
+    format_number( std::uintmax_t value, std::string & result );
+  void
+    format_number( long double value, std::string & result );
+
+  // The value of atom if it is a plain decimal number
+  // (-?[0-9]+(\.[0-9]+)?([eE][-+]?[0-9]{1,4})?, as canonical numbers
+  // are), converted as boost::lexical_cast converts it. The integer
+  // forms require the value to be exactly representable, the floating
+  // form that it neither overflow nor underflow; otherwise they return
+  // false, leaving result untouched, and the caller takes the general
+  // path.
+  bool
+    parse_number( std::string const & atom, std::uintmax_t & result );
+  bool
+    parse_number( std::string const & atom, std::intmax_t & result );
+  bool
+    parse_number( std::string const & atom, long double & result );
+
+} }  // fhicl::detail, fhicl
+
+// ======================================================================
+
+#endif /* fhiclcpp_number_h */
+
+// Local Variables:
+// mode: c++
+// End:
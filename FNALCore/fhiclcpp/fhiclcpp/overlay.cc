@@ -0,0 +1,220 @@
+// ======================================================================
+//
+// overlay - apply a small override document to an already-parsed
+//           configuration, without re-parsing the configuration
+//
+// ======================================================================
+
+#include "fhiclcpp/overlay.h"
+
+#include "boost/algorithm/string.hpp"
+#include "boost/any.hpp"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/exception.h"
+#include "fhiclcpp/extended_value.h"
+#include "fhiclcpp/intermediate_table.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "fhiclcpp/parse.h"
+#include <cctype>
+#include <cstdlib>
+#include <vector>
+
+using namespace fhicl;
+
+typedef  ParameterSet::ps_atom_t      ps_atom_t;
+typedef  ParameterSet::ps_sequence_t  ps_sequence_t;
+
+namespace fhicl {
+  // extended_value -> ParameterSet value; see make_ParameterSet.cc.
+  boost::any encode( extended_value const & xval );
+}
+
+// ----------------------------------------------------------------------
+
+// Applies one document_assignment to a ParameterSet, copying (and
+// re-registering) only the nested ParameterSets on its path. The
+// behavior mirrors that of intermediate_table::insert() and erase().
+class fhicl::detail::overlayer
+{
+public:
+  explicit
+    overlayer( document_assignment const & a )
+    : a_( a ), key_( )
+  {
+    std::vector<std::string> parts;
+    boost::algorithm::split(parts, a.name, boost::algorithm::is_any_of(".[]"));
+    for( auto const & part : parts )
+      if( ! part.empty() )
+        key_.push_back(part);
+  }
+
+  // The values of ps, in the form that references in the overrides
+  // resolve against.
+  static void
+    seed( ParameterSet const & ps, intermediate_table & tbl )
+  {
+    for( auto const & pr : ps.mapping_ )
+      tbl.insert(pr.first, decode(pr.second));
+  }
+
+  void
+    apply( ParameterSet & ps, unsigned k = 0u ) const
+  {
+    std::string const & this_key = key_[k];
+    if( k + 1u == key_.size() ) {
+      if( a_.erase )
+        ps.erase(this_key);
+      else
+        ps.insert_or_replace_(this_key, encode(a_.value));
+      return;
+    }
+    auto const it = ps.mapping_.find(this_key);
+    if( it == ps.mapping_.end() && a_.erase )
+      return;
+    boost::any value = it == ps.mapping_.end() ? nil() : it->second;
+    if( apply(value, k + 1u) )
+      ps.insert_or_replace_(this_key, value);
+  }
+
+private:
+  document_assignment const &  a_;
+  std::vector<std::string>     key_;
+
+  static boost::any
+    nil( )
+  { return ps_atom_t(9, '\0'); }
+
+  // ParameterSet value -> extended_value; the inverse of encode().
+  static extended_value
+    decode( boost::any const & value )
+  {
+    if( is_table(value) ) {
+      ParameterSet const & nested
+        = ParameterSetRegistry::get(boost::any_cast<ParameterSetID>(value));
+      extended_value::table_t t;
+      for( auto const & pr : nested.mapping_ )
+        t[pr.first] = decode(pr.second);
+      return extended_value(false, TABLE, t);
+    }
+    if( is_sequence(value) ) {
+      extended_value::sequence_t s;
+      for( auto const & elt : boost::any_cast<ps_sequence_t>(value) )
+        s.push_back(decode(elt));
+      return extended_value(false, SEQUENCE, s);
+    }
+    ps_atom_t const & atom = atom_text(value);
+    if( is_nil(value) )
+      return extended_value(false, NIL, atom);
+    if( atom == "true" || atom == "false" )
+      return extended_value(false, BOOL, atom);
+    if( ! atom.empty() && atom[0] == '"' )
+      return extended_value(false, STRING, atom);
+    if( ! atom.empty() && atom[0] == '(' ) {
+      std::string::size_type const comma = atom.find(',');
+      return extended_value( false, COMPLEX
+                           , extended_value::complex_t( atom.substr(1, comma - 1)
+                                                      , atom.substr(comma + 1, atom.size() - comma - 2)
+                                                      ) );
+    }
+    return extended_value(false, NUMBER, atom);
+  }
+
+  // Apply the assignment to value, which is reached by key_[0..k);
+  // false if nothing was changed.
+  bool
+    apply( boost::any & value, unsigned k ) const
+  {
+    std::string const & this_key = key_[k];
+    bool const last = k + 1u == key_.size();
+    if( std::isdigit(this_key[0]) ) {
+      if( ! a_.erase && is_nil(value) )
+        value = ps_sequence_t();
+      if( ! is_sequence(value) )
+        throw exception(cant_find, a_.name)
+            << "-- not a sequence (at part \"" << this_key << "\")";
+      ps_sequence_t & s = boost::any_cast<ps_sequence_t &>(value);
+      unsigned const i = std::atoi(this_key.c_str());
+      if( a_.erase ) {
+        if( s.size() <= i )
+          return false;
+        if( last )
+          throw fhicl::exception(unimplemented, "erase sequence member");
+        return apply(s[i], k + 1u);
+      }
+      while( s.size() <= i )
+        s.push_back(nil());
+      if( last ) {
+        s[i] = encode(a_.value);
+        return true;
+      }
+      return apply(s[i], k + 1u);
+    }
+    else {  /* this_key[0] is alpha or '_' */
+      if( ! a_.erase && is_nil(value) )
+        value = ParameterSetRegistry::put(ParameterSet());
+      if( ! is_table(value) )
+        throw exception(cant_find, a_.name)
+            << "-- not a table (at part \"" << this_key << "\")";
+      ParameterSet nested
+        = ParameterSetRegistry::get(boost::any_cast<ParameterSetID>(value));
+      apply(nested, k);
+      value = ParameterSetRegistry::put(nested);
+      return true;
+    }
+  }
+
+};  // overlayer
+
+// ----------------------------------------------------------------------
+
+void
+  fhicl::overlay( ParameterSet const & base
+                , std::string const  & overrides
+                , ParameterSet       & result
+                )
+{
+  // References are resolved against base's values, which are only
+  // decoded when the overrides contain any.
+  intermediate_table tbl;
+  if( overrides.find("@local::")    != std::string::npos ||
+      overrides.find("@table::")    != std::string::npos ||
+      overrides.find("@sequence::") != std::string::npos )
+    detail::overlayer::seed(base, tbl);
+  std::vector<document_assignment> assignments;
+  parse_document(overrides, tbl, assignments);
+
+  ParameterSet ps(base);
+  for( auto const & a : assignments )
+    detail::overlayer(a).apply(ps);
+  result = ps;
+}  // overlay()
+
+// ----------------------------------------------------------------------
+
+void
+  fhicl::overlay( intermediate_table const & base
+                , std::string const        & overrides
+                , intermediate_table       & result
+                )
+{
+  intermediate_table tbl(base);
+  std::vector<document_assignment> assignments;
+  parse_document(overrides, tbl, assignments);
+  result = std::move(tbl);
+}  // overlay()
+
+void
+  fhicl::overlay( intermediate_table const & base
+                , std::string const        & overrides
+                , ParameterSet             & result
+                )
+{
+  intermediate_table tbl;
+  overlay(base, overrides, tbl);
+  ParameterSet ps;
+  make_ParameterSet(std::move(tbl), ps);
+  result = ps;
+}  // overlay()
+
+// ======================================================================
@@ -0,0 +1,57 @@
+#ifndef fhiclcpp_overlay_h
+#define fhiclcpp_overlay_h
+
+// ======================================================================
+//
+// overlay - apply a small override document to an already-parsed
+//           configuration, without re-parsing the configuration
+//
+// The overrides are an ordinary FHiCL document (prologs, assignments
+// to qualified names such as "a.b[3].c: value", "a.b: @erase" and
+// @table:: splices), applied as if its prologs and its body followed
+// those of the base document.
+//
+// The ParameterSet form re-encodes only the tables on the paths that
+// the overrides touch: every other nested ParameterSet is shared with
+// base, keeping its ParameterSetID and registry entry. References in
+// the overrides (@local::, @table::, @sequence::) resolve against
+// base's values as well, which are then decoded once; base's prolog,
+// however, is not retained in a ParameterSet.
+//
+// The intermediate_table form resolves references against base as
+// well, and so gives exactly the result of the combined text.
+//
+// ======================================================================
+
+#include "cpp0x/string"
+#include "fhiclcpp/fwd.h"
+
+namespace fhicl {
+
+  void
+    overlay( ParameterSet const & base
+           , std::string const  & overrides
+           , ParameterSet       & result
+           );
+
+  void
+    overlay( intermediate_table const & base
+           , std::string const        & overrides
+           , intermediate_table       & result
+           );
+
+  void
+    overlay( intermediate_table const & base
+           , std::string const        & overrides
+           , ParameterSet             & result
+           );
+
+}  // fhicl
+
+// ======================================================================
+
+#endif /* fhiclcpp_overlay_h */
+
+// Local Variables:
+// mode: c++
+// End:
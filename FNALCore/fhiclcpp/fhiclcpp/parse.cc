@@ -28,14 +28,15 @@
 #pragma warning(pop)
 #endif
 
-#include "cetlib/canonical_number.h"
 #include "cetlib/canonical_string.h"
 #include "cetlib/include.h"
 #include "cetlib/includer.h"
+#include "cetlib/mapped_includer.h"
 #include "cpp0x/string"
 #include "fhiclcpp/exception.h"
 #include "fhiclcpp/extended_value.h"
 #include "fhiclcpp/intermediate_table.h"
+#include "fhiclcpp/number.h"
 #include "fhiclcpp/tokens.h"
 #include <vector>
 
@@ -87,7 +88,7 @@ namespace {
   canon_num(std::string const & num)
   {
     std::string result;
-    if (! cet::canonical_number(num, result))
+    if (! fhicl::detail::canonical_number(num, result))
     { result = "####"; }
     return result;
   }
@@ -119,13 +120,13 @@ namespace {
     return std::make_pair(c1, c2);
   }
 
-  template <typename FwdIter>
+  template <typename FwdIter, typename Source>
   fhicl::extended_value
   local_lookup(std::string const & name,
                fhicl::intermediate_table const & tbl,
                bool in_prolog,
                FwdIter pos,
-               cet::includer const & s)
+               Source const & s)
   try
   {
     fhicl::extended_value result = tbl.find(name);
@@ -140,13 +141,13 @@ namespace {
       << "\n";
   }
 
-  template <typename FwdIter>
+  template <typename FwdIter, typename Source>
   fhicl::extended_value
   database_lookup(std::string const &,
                   fhicl::intermediate_table const &,
                   bool,
                   FwdIter pos,
-                  cet::includer const & s)
+                  Source const & s)
   {
     throw fhicl::exception(fhicl::error::unimplemented, "Database lookup error")
       << "at "
@@ -154,19 +155,35 @@ namespace {
       << "\nFHiCL-cpp database lookup not yet available.\n";
   }
 
+  typedef  std::vector<fhicl::document_assignment>  assignments_t;
+
+  void
+  note(assignments_t * log,
+       std::string const & name,
+       bool erase,
+       extended_value const & value)
+  {
+    if (log != nullptr && ! value.in_prolog)
+    { log->push_back(fhicl::document_assignment{name, erase, value}); }
+  }
+
   void
   tbl_insert(std::string const & name,
              extended_value const & value,
-             fhicl::intermediate_table & t)
+             fhicl::intermediate_table & t,
+             assignments_t * log)
   {
     t.insert(name, value);
+    note(log, name, false, value);
   }
 
   void
   tbl_erase(std::string const & name,
-            fhicl::intermediate_table & t)
+            fhicl::intermediate_table & t,
+            assignments_t * log)
   {
     t.erase(name);
+    note(log, name, true, extended_value());
   }
 
   void
@@ -178,14 +195,14 @@ namespace {
     t[name] = value;
   }
 
-  template <typename TABLEISH, typename FwdIter>
+  template <typename TABLEISH, typename FwdIter, typename Source>
   void
   insert_table(std::string const & name,
                fhicl::intermediate_table & tbl,
                bool in_prolog,
                TABLEISH & t,
                FwdIter pos,
-               cet::includer const & s)
+               Source const & s)
   {
     fhicl::extended_value const & xval =
       local_lookup(name, tbl, false, pos, s);
@@ -205,14 +222,14 @@ namespace {
     }
   }
 
-  template <typename FwdIter>
+  template <typename FwdIter, typename Source>
   void
   seq_insert_sequence(std::string const & name,
                       fhicl::intermediate_table & tbl,
                       bool in_prolog,
                       sequence_t & v,
                       FwdIter pos,
-                      cet::includer const & s)
+                      Source const & s)
   {
     fhicl::extended_value const & xval =
       local_lookup(name, tbl, false, pos, s);
@@ -236,6 +253,26 @@ namespace {
     }
   }
 
+  template <typename FwdIter, typename Source>
+  void
+  tbl_insert_table(std::string const & name,
+                   fhicl::intermediate_table & tbl,
+                   bool in_prolog,
+                   FwdIter pos,
+                   Source const & s,
+                   assignments_t * log)
+  {
+    if (log == nullptr || in_prolog) {
+      insert_table(name, tbl, in_prolog, tbl, pos, s);
+      return;
+    }
+    // Keep the incoming keys: inserting may replace the source table.
+    fhicl::extended_value const xval = local_lookup(name, tbl, false, pos, s);
+    insert_table(name, tbl, in_prolog, tbl, pos, s);
+    for (auto const & entry : boost::any_cast<table_t const &>(xval.value))
+    { note(log, entry.first, false, tbl.find(entry.first)); }
+  }
+
   void
   seq_insert_value(fhicl::extended_value const & xval,
                    sequence_t & v)
@@ -256,7 +293,7 @@ namespace fhicl {
   template< class FwdIter, class Skip >
   struct value_parser;
 
-  template< class FwdIter, class Skip >
+  template< class FwdIter, class Skip, class Source >
   struct document_parser;
 
 }  // namespace fhicl
@@ -293,7 +330,7 @@ struct fhicl::value_parser
 
 // ----------------------------------------------------------------------
 
-template< class FwdIter, class Skip >
+template< class FwdIter, class Skip, class Source >
 struct fhicl::document_parser
 : qi::grammar<FwdIter, void(), Skip> {
   typedef  fhicl::value_parser<FwdIter, Skip>   value_parser;
@@ -304,11 +341,12 @@ struct fhicl::document_parser
   typedef  typename value_parser::value_token     value_token;
   typedef  qi::rule<FwdIter, void(), Skip>        nothing_token;
 
-  document_parser(cet::includer const & s);
+  document_parser(Source const & s);
 
   // data members:
   bool                in_prolog;
   intermediate_table  tbl;
+  std::vector<document_assignment> * assignments;  // If recording.
   value_parser        vp;
 
   // parser rules:
@@ -396,14 +434,14 @@ fhicl::value_parser<FwdIter, Skip>::value_parser()
 
 // ----------------------------------------------------------------------
 
-template< class FwdIter, class Skip >
-fhicl::document_parser<FwdIter, Skip>::document_parser(cet::includer const & s)
+template< class FwdIter, class Skip, class Source >
+fhicl::document_parser<FwdIter, Skip, Source>::document_parser(Source const & s)
   : document_parser::base_type(document)
   , in_prolog(false)
   , tbl()
+  , assignments(nullptr)
   , vp()
 {
-  typedef cet::includer::const_iterator iter_t;
   name     = fhicl::ass [ _val = qi::_1 ];
   qualname = fhicl::ass                                  [ _val = qi::_1 ]
              >> *((char_('.') > fhicl::ass)               [ _val += qi::_1 + qi::_2 ]
@@ -419,8 +457,8 @@ fhicl::document_parser<FwdIter, Skip>::document_parser(cet::includer const & s)
   // the list elements actually returning multiple elements.
   sequence =
     lit('[')
-    > -(((value [ phx::bind(seq_insert_value, qi::_1, _val) ]) | (iter_pos >> lit("@sequence::") > noskip_qualname) [ phx::bind(&seq_insert_sequence<iter_t>, qi::_2, ref(tbl), ref(in_prolog), _val, qi::_1, s) ]))
-    > *(lit(',') > ((value [ phx::bind(seq_insert_value, qi::_1, _val) ]) | (iter_pos >> lit("@sequence::") > noskip_qualname) [ phx::bind(&seq_insert_sequence<iter_t>, qi::_2, ref(tbl), ref(in_prolog), _val, qi::_1, s) ]))
+    > -(((value [ phx::bind(seq_insert_value, qi::_1, _val) ]) | (iter_pos >> lit("@sequence::") > noskip_qualname) [ phx::bind(&seq_insert_sequence<FwdIter, Source>, qi::_2, ref(tbl), ref(in_prolog), _val, qi::_1, phx::cref(s)) ]))
+    > *(lit(',') > ((value [ phx::bind(seq_insert_value, qi::_1, _val) ]) | (iter_pos >> lit("@sequence::") > noskip_qualname) [ phx::bind(&seq_insert_sequence<FwdIter, Source>, qi::_2, ref(tbl), ref(in_prolog), _val, qi::_1, phx::cref(s)) ]))
     > lit(']');
   table =
     lit('{')
@@ -429,9 +467,9 @@ fhicl::document_parser<FwdIter, Skip>::document_parser(cet::includer const & s)
         | (name >> (lit(':') > lit("@erase"))
           ) [ phx::bind(map_erase, qi::_1, _val) ]
         | (iter_pos >> lit("@table::") > noskip_qualname
-          ) [ phx::bind(&insert_table<table_t, iter_t>,
+          ) [ phx::bind(&insert_table<table_t, FwdIter, Source>,
                         qi::_2, ref(tbl), ref(in_prolog), _val,
-                        qi::_1, s) ]
+                        qi::_1, phx::cref(s)) ]
        )
     > lit('}');
   value =
@@ -441,13 +479,13 @@ fhicl::document_parser<FwdIter, Skip>::document_parser(cet::includer const & s)
      vp.complex [ _val = phx::bind(xvalue, ref(in_prolog), COMPLEX , qi::_1) ] |
      vp.string  [ _val = phx::bind(xvalue, ref(in_prolog), STRING  , qi::_1) ] |
      (iter_pos >> localref)
-     [ _val = phx::bind(&local_lookup<iter_t>,
+     [ _val = phx::bind(&local_lookup<FwdIter, Source>,
                         qi::_2, ref(tbl), ref(in_prolog),
-                        qi::_1, s) ] |
+                        qi::_1, phx::cref(s)) ] |
      (iter_pos >> dbref)
-     [ _val = phx::bind(&database_lookup<iter_t>,
+     [ _val = phx::bind(&database_lookup<FwdIter, Source>,
                         qi::_2, ref(tbl), ref(in_prolog),
-                        qi::_1, s) ] |
+                        qi::_1, phx::cref(s)) ] |
      vp.id      [ _val = phx::bind(xvalue, ref(in_prolog), TABLEID , qi::_1) ] |
      sequence   [ _val = phx::bind(xvalue, ref(in_prolog), SEQUENCE, qi::_1) ] |
      table      [ _val = phx::bind(xvalue, ref(in_prolog), TABLE   , qi::_1) ]
@@ -456,22 +494,22 @@ fhicl::document_parser<FwdIter, Skip>::document_parser(cet::includer const & s)
     lit("BEGIN_PROLOG") [ phx::bind(rebool, ref(in_prolog), true) ]
     >> *((qualname
           >> (lit(':') > value)
-         ) [ phx::bind(tbl_insert, qi::_1, qi::_2, ref(tbl)) ]
+         ) [ phx::bind(tbl_insert, qi::_1, qi::_2, ref(tbl), phx::ref(assignments)) ]
          | (iter_pos >> lit("@table::") > noskip_qualname
-           ) [ phx::bind(&insert_table<fhicl::intermediate_table, iter_t>,
+           ) [ phx::bind(&insert_table<fhicl::intermediate_table, FwdIter, Source>,
                          qi::_2, ref(tbl), ref(in_prolog), ref(tbl),
-                         qi::_1, s) ]
+                         qi::_1, phx::cref(s)) ]
         )
     >> lit("END_PROLOG")  [ phx::bind(rebool, ref(in_prolog), false) ];
   document = (*prolog)
              >> *((qualname >> (lit(':') >> value)
-                  ) [ phx::bind(tbl_insert, qi::_1, qi::_2, ref(tbl)) ]
+                  ) [ phx::bind(tbl_insert, qi::_1, qi::_2, ref(tbl), phx::ref(assignments)) ]
                   | (qualname >> (lit(':') > lit("@erase"))
-                    ) [ phx::bind(tbl_erase, qi::_1, ref(tbl)) ]
+                    ) [ phx::bind(tbl_erase, qi::_1, ref(tbl), phx::ref(assignments)) ]
                   | (iter_pos >> lit("@table::") > noskip_qualname
-                    ) [ phx::bind(&insert_table<fhicl::intermediate_table, iter_t>,
-                                  qi::_2, ref(tbl), ref(in_prolog), ref(tbl),
-                                  qi::_1, s) ]
+                    ) [ phx::bind(&tbl_insert_table<FwdIter, Source>,
+                                  qi::_2, ref(tbl), ref(in_prolog),
+                                  qi::_1, phx::cref(s), phx::ref(assignments)) ]
                  );
   name    .name("name atom");
   localref.name("localref atom");
@@ -513,35 +551,87 @@ fhicl::parse_value_string(std::string const & s
 
 // ----------------------------------------------------------------------
 
+namespace {
+
+  // When recording assignments, the document is parsed on top of the
+  // initial contents of result.
+  template <typename FwdIter, typename Source>
+  void
+  parse_source(Source const & s
+               , FwdIter begin
+               , FwdIter const end
+               , fhicl::intermediate_table & result
+               , assignments_t * assignments = nullptr
+              )
+  {
+    typedef  qi::rule<FwdIter>  ws_t;
+    ws_t  whitespace = space
+                       | lit('#')  >> *(char_ - eol) >> eol
+                       | lit("//") >> *(char_ - eol) >> eol;
+    fhicl::document_parser<FwdIter, ws_t, Source> p(s);
+    if (assignments != nullptr) {
+      p.tbl = std::move(result);
+      p.assignments = assignments;
+    }
+    bool b = false;
+    try {
+      b =  qi::phrase_parse(begin, end, p, whitespace);
+    }
+    catch (qi::expectation_failure<FwdIter> const & e) {
+      begin = e.first;
+    }
+    if (b && begin == end)
+    { result = std::move(p.tbl); }
+    else
+      throw fhicl::exception(fhicl::parse_error, "detected at or near")
+          << s.highlighted_whereis(begin)
+          << "\n";
+  }  // parse_source()
+
+  // Files are mapped rather than copied; only a very large
+  // fully-included text is parsed piecewise. The files are digested
+  // only if the include graph is wanted.
+  void
+  parse_file(std::string const & filename
+             , cet::filepath_maker & maker
+             , fhicl::intermediate_table & result
+             , cet::include_graph * graph
+            )
+  {
+    cet::mapped_includer s(filename, maker,
+                           cet::mapped_includer::default_contiguous_limit,
+                           graph != nullptr);
+    if (s.is_contiguous())
+      parse_source(s, s.data(), s.data() + s.size(), result);
+    else
+      parse_source(s, s.begin(), s.end(), result);
+    if (graph != nullptr)
+    { *graph = s.graph(); }
+  }  // parse_file()
+
+}
+
+// ----------------------------------------------------------------------
+
 void
 fhicl::parse_document(std::string const  &  filename
                       , cet::filepath_maker & maker
                       , intermediate_table  & result
                      )
 {
-  cet::includer s(filename, maker);
-  typedef  cet::includer::const_iterator  iter_t;
-  typedef  qi::rule<iter_t>  ws_t;
-  ws_t  whitespace = space
-                     | lit('#')  >> *(char_ - eol) >> eol
-                     | lit("//") >> *(char_ - eol) >> eol;
-  document_parser<iter_t, ws_t> p(s);
-  iter_t                        begin = s.begin();
-  iter_t const                  end  =  s.end();
-  bool b = false;
-  try {
-    b =  qi::phrase_parse(begin, end, p, whitespace);
-  }
-  catch (qi::expectation_failure<iter_t> const & e) {
-    begin = e.first;
-  }
-  std::string unparsed(begin, end);
-  if (b && unparsed.empty())
-  { result = p.tbl; }
-  else
-    throw fhicl::exception(fhicl::parse_error, "detected at or near")
-        << s.highlighted_whereis(begin)
-        << "\n";
+  parse_file(filename, maker, result, nullptr);
+}  // parse_document()
+
+// ----------------------------------------------------------------------
+
+void
+fhicl::parse_document(std::string const  &  filename
+                      , cet::filepath_maker & maker
+                      , intermediate_table  & result
+                      , cet::include_graph  & graph
+                     )
+{
+  parse_file(filename, maker, result, &graph);
 }  // parse_document()
 
 // ----------------------------------------------------------------------
@@ -553,28 +643,21 @@ fhicl::parse_document(std::istream     &    is
                      )
 {
   cet::includer s(is, maker);
-  typedef  cet::includer::const_iterator  iter_t;
-  typedef  qi::rule<iter_t>  ws_t;
-  ws_t  whitespace = space
-                     | lit('#')  >> *(char_ - eol) >> eol
-                     | lit("//") >> *(char_ - eol) >> eol;
-  document_parser<iter_t, ws_t> p(s);
-  iter_t                        begin = s.begin();
-  iter_t const                  end  =  s.end();
-  bool b = false;
-  try {
-    b =  qi::phrase_parse(begin, end, p, whitespace);
-  }
-  catch (qi::expectation_failure<iter_t> const & e) {
-    begin = e.first;
-  }
-  std::string unparsed(begin, end);
-  if (b && unparsed.empty())
-  { result = p.tbl; }
-  else
-    throw fhicl::exception(fhicl::parse_error, "detected at or near")
-        << s.highlighted_whereis(begin)
-        << "\n";
+  parse_source(s, s.begin(), s.end(), result);
+}  // parse_document()
+
+// ----------------------------------------------------------------------
+
+void
+fhicl::parse_document(std::string const  &  s
+                      , intermediate_table  & result
+                      , std::vector<document_assignment> & assignments
+                     )
+{
+  std::istringstream is(s);
+  cet::filepath_maker maker;
+  cet::includer inc(is, maker);
+  parse_source(inc, inc.begin(), inc.end(), result, &assignments);
 }  // parse_document()
 
 // ======================================================================
@@ -8,10 +8,13 @@
 // ======================================================================
 
 #include "cetlib/filepath_maker.h"
+#include "cetlib/include_graph.h"
 #include "cpp0x/string"
+#include "fhiclcpp/extended_value.h"
 #include "fhiclcpp/fwd.h"
 #include <istream>
 #include <sstream>
+#include <vector>
 
 namespace fhicl {
 
@@ -27,6 +30,14 @@ namespace fhicl {
                   , intermediate_table  & result
                   );
 
+  // As above, also recording the files read in graph.
+  void
+    parse_document( std::string const   & filename
+                  , cet::filepath_maker & maker
+                  , intermediate_table  & result
+                  , cet::include_graph  & graph
+                  );
+
   void
     parse_document( std::istream        & is
                   , cet::filepath_maker & maker
@@ -43,6 +54,23 @@ namespace fhicl {
     parse_document(is, m, result);
   }
 
+  // A top-level (non-prolog) assignment, or @erase, of a document.
+  struct document_assignment
+  {
+    std::string     name;   // qualified, e.g. "a.b[2].c"
+    bool            erase;
+    extended_value  value;  // of the assignment; unused for an @erase
+  };
+
+  // Parse the document s on top of the existing contents of result, so
+  // that its references may also resolve against them, and record its
+  // top-level assignments in order. result is unspecified on failure.
+  void
+    parse_document( std::string const                & s
+                  , intermediate_table               & result
+                  , std::vector<document_assignment> & assignments
+                  );
+
   // backwards compatibility only; function name is deprecated
   inline bool
     parse_value( std::string const & s
@@ -9,10 +9,10 @@
 
 #include "boost/spirit/home/support/terminal.hpp"
 #include "boost/spirit/include/qi.hpp"
-#include "cetlib/canonical_number.h"
 #include "cpp0x/cstddef"
 #include "cpp0x/string"
 #include "fhiclcpp/ParameterSetID.h"
+#include "fhiclcpp/number.h"
 #include <cctype>
 
 namespace qi = boost::spirit::qi;
@@ -301,7 +301,7 @@ namespace fhicl {
         return false;
 
       Attribute result;
-      if( ! cet::canonical_number(raw, result) )
+      if( ! detail::canonical_number(raw, result) )
         return false;
 
       first = it;
@@ -425,7 +425,7 @@ namespace fhicl {
         return false;
 
       Attribute result;
-      if( ! cet::canonical_number(raw, result) )
+      if( ! detail::canonical_number(raw, result) )
         return false;
 
       first = it;
@@ -551,7 +551,7 @@ namespace fhicl {
         return false;
 
       Attribute result;
-      if( ! cet::canonical_number(raw, result) )
+      if( ! detail::canonical_number(raw, result) )
         return false;
 
       first = it;
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "fhiclcpp/DatabaseSupport.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
 
 BOOST_AUTO_TEST_SUITE( database_support_test )
 
@@ -58,4 +59,55 @@ BOOST_AUTO_TEST_CASE( nested_vector)
   BOOST_CHECK_EQUAL(records.size(), 3ul);
 }
 
+BOOST_AUTO_TEST_CASE( indexed_query )
+{
+  using constraints_t = std::vector<std::pair<std::string, std::string>>;
+
+  fhicl::ParameterSet p;
+  make_ParameterSet("out: { module_type: RootOutput module_label: o1 compress: 7 }"
+                    " ana: { module_type: Analyzer module_label: a1 flag: @nil }"
+                    " ana2: { module_type: Analyzer module_label: a2 }",
+                    p);
+  fhicl::ParameterSetRegistry::put(p);
+  auto const out_id = p.get<fhicl::ParameterSet>("out").id();
+  auto const ana_id = p.get<fhicl::ParameterSet>("ana").id();
+
+  sqlite3* db = nullptr;
+  BOOST_REQUIRE_EQUAL(sqlite3_open(":memory:", &db), SQLITE_OK);
+  fhicl::ParameterSetRegistry::exportTo(db, true);
+
+  auto ids = fhicl::find_parameterset_ids(db, constraints_t{ { "module_type", "RootOutput" } });
+  BOOST_REQUIRE_EQUAL(ids.size(), 1ul);
+  BOOST_CHECK_EQUAL(ids.front(), out_id);
+
+  ids = fhicl::find_parameterset_ids(db, constraints_t{ { "module_type", "Analyzer" } });
+  BOOST_CHECK_EQUAL(ids.size(), 2ul);
+
+  ids = fhicl::find_parameterset_ids(db, constraints_t{ { "module_type", "Analyzer" },
+                                                        { "module_label", "a1" } });
+  BOOST_REQUIRE_EQUAL(ids.size(), 1ul);
+  BOOST_CHECK_EQUAL(ids.front(), ana_id);
+
+  ids = fhicl::find_parameterset_ids(db, constraints_t{ { "compress", "7" } });
+  BOOST_CHECK_EQUAL(ids.size(), 1ul);
+  ids = fhicl::find_parameterset_ids(db, constraints_t{ { "flag", "" } });
+  BOOST_CHECK(ids.empty());
+
+  // An index is carried through importFrom to a later export.
+  fhicl::ParameterSetRegistry::importFrom(db);
+  sqlite3* db2 = nullptr;
+  BOOST_REQUIRE_EQUAL(sqlite3_open(":memory:", &db2), SQLITE_OK);
+  fhicl::ParameterSetRegistry::exportTo(db2, true);
+  ids = fhicl::find_parameterset_ids(db2, constraints_t{ { "module_label", "a2" } });
+  BOOST_CHECK_EQUAL(ids.size(), 1ul);
+
+  // Without an index there is nothing to query.
+  fhicl::ParameterSetRegistry::exportTo(db2);
+  BOOST_CHECK_THROW(fhicl::find_parameterset_ids(db2, constraints_t{ }),
+                    fhicl::exception);
+
+  BOOST_CHECK_EQUAL(sqlite3_close(db2), SQLITE_OK);
+  BOOST_CHECK_EQUAL(sqlite3_close(db), SQLITE_OK);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
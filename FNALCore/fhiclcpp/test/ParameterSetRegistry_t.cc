@@ -4,8 +4,15 @@
 #include "fhiclcpp/ParameterSetRegistry.h"
 #include "fhiclcpp/make_ParameterSet.h"
 
+#include "fhiclcpp/frozen_registry.h"
+
 #include "sqlite3.h"
 
+#include <cstdint>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
 using namespace fhicl;
 
 using fhicl::detail::throwOnSQLiteFailure;
@@ -177,4 +184,147 @@ BOOST_AUTO_TEST_CASE(TestExport)
   sqlite3_close(db);
 }
 
+BOOST_AUTO_TEST_CASE(TestExportIndex)
+{
+  // An imported index row, which indexing the ParameterSet itself would
+  // not produce.
+  ParameterSet pset;
+  pset.put("indexed", 1);
+  ParameterSetRegistry::put(pset);
+  std::string const id(pset.id().to_string());
+  std::string const psBlob(pset.to_compact_string());
+  sqlite3 * db = nullptr;
+  BOOST_REQUIRE(!sqlite3_open(":memory:", &db));
+  char * errMsg;
+  sqlite3_exec(db,
+               "CREATE TABLE ParameterSets(ID PRIMARY KEY, PSetBlob);"
+               "CREATE TABLE ParameterSetIndex(ID, Key, Value, PRIMARY KEY(ID, Key));",
+               0, 0, &errMsg);
+  throwOnSQLiteFailure(db, errMsg);
+  sqlite3_stmt * stmt;
+  sqlite3_prepare_v2(db, "INSERT INTO ParameterSets(ID, PSetBlob) VALUES(?, ?);", -1, &stmt, NULL);
+  sqlite3_bind_text(stmt, 1, id.c_str(), id.size() + 1, SQLITE_STATIC);
+  sqlite3_bind_text(stmt, 2, psBlob.c_str(), psBlob.size() + 1, SQLITE_STATIC);
+  BOOST_REQUIRE_EQUAL(sqlite3_step(stmt), SQLITE_DONE);
+  sqlite3_finalize(stmt);
+  sqlite3_prepare_v2(db, "INSERT INTO ParameterSetIndex(ID, Key, Value) VALUES(?, 'marker', '1');", -1, &stmt, NULL);
+  sqlite3_bind_text(stmt, 1, id.c_str(), id.size() + 1, SQLITE_STATIC);
+  BOOST_REQUIRE_EQUAL(sqlite3_step(stmt), SQLITE_DONE);
+  sqlite3_finalize(stmt);
+  ParameterSetRegistry::importFrom(db);
+
+  // Exported with an index: the imported row is carried over, beside
+  // the row for "indexed".
+  ParameterSetRegistry::exportTo(db, true);
+  sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM ParameterSetIndex WHERE ID = ?;", -1, &stmt, NULL);
+  sqlite3_bind_text(stmt, 1, id.c_str(), id.size() + 1, SQLITE_STATIC);
+  BOOST_REQUIRE_EQUAL(sqlite3_step(stmt), SQLITE_ROW);
+  BOOST_CHECK_EQUAL(sqlite3_column_int64(stmt, 0), 2l);
+  sqlite3_finalize(stmt);
+
+  // Exported without: no index is left in db.
+  ParameterSetRegistry::exportTo(db);
+  sqlite3_prepare_v2(db, "SELECT 1 from sqlite_master where type='table' and name='ParameterSetIndex';",
+                     -1, &stmt, NULL);
+  BOOST_CHECK_EQUAL(sqlite3_step(stmt), SQLITE_DONE); // No such table.
+  sqlite3_finalize(stmt);
+  BOOST_REQUIRE_EQUAL(sqlite3_close(db), SQLITE_OK);
+}
+
+BOOST_AUTO_TEST_CASE(TestFreeze)
+{
+  // A ParameterSet known only to the backing DB.
+  ParameterSet pset;
+  pset.put("frozen_only", 42);
+  std::string const id(pset.id().to_string());
+  std::string const psBlob(pset.to_compact_string());
+  sqlite3 * db = nullptr;
+  BOOST_REQUIRE(!sqlite3_open(":memory:", &db));
+  char * errMsg;
+  sqlite3_exec(db,
+               "CREATE TABLE ParameterSets(ID PRIMARY KEY, PSetBlob);",
+               0, 0, &errMsg);
+  throwOnSQLiteFailure(db, errMsg);
+  sqlite3_stmt * oStmt;
+  sqlite3_prepare_v2(db, "INSERT INTO ParameterSets(ID, PSetBlob) VALUES(?, ?);", -1, &oStmt, NULL);
+  sqlite3_bind_text(oStmt, 1, id.c_str(), id.size() + 1, SQLITE_STATIC);
+  sqlite3_bind_text(oStmt, 2, psBlob.c_str(), psBlob.size() + 1, SQLITE_STATIC);
+  BOOST_REQUIRE_EQUAL(sqlite3_step(oStmt), SQLITE_DONE);
+  sqlite3_finalize(oStmt);
+  ParameterSetRegistry::importFrom(db);
+  BOOST_REQUIRE_EQUAL(sqlite3_close(db), SQLITE_OK);
+  BOOST_REQUIRE(ParameterSetRegistry::get().find(pset.id()) ==
+                ParameterSetRegistry::get().cend());
+
+  int const fd = ParameterSetRegistry::freeze();
+  {
+    detail::frozen_registry const frozen(fd);
+    BOOST_CHECK_EQUAL(frozen.size(), ParameterSetRegistry::size() + 1);
+    std::string blob;
+    BOOST_REQUIRE(frozen.find(id, blob));
+    BOOST_CHECK_EQUAL(blob, psBlob);
+    BOOST_CHECK(!frozen.find(std::string(40, '0'), blob));
+    for (auto const & p : ParameterSetRegistry::get()) {
+      BOOST_CHECK(frozen.find(p.first.to_string(), blob));
+    }
+  }
+
+  // A forked worker decodes it from the shared segment on access.
+  pid_t const pid = fork();
+  BOOST_REQUIRE(pid >= 0);
+  if (pid == 0) {
+    bool const ok = ParameterSetRegistry::get(pset.id()).get<int>("frozen_only") == 42;
+    _exit(ok ? 0 : 1);
+  }
+  int status = -1;
+  BOOST_REQUIRE_EQUAL(waitpid(pid, &status, 0), pid);
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  // As does a process handed the descriptor; a second freeze() keeps
+  // everything from the first.
+  ParameterSetRegistry::adoptFrozen(fd);
+  BOOST_CHECK(ParameterSetRegistry::get(pset.id()) == pset);
+  detail::frozen_registry const refrozen(ParameterSetRegistry::freeze());
+  std::string blob;
+  BOOST_CHECK(refrozen.find(id, blob));
+  BOOST_CHECK_THROW(detail::frozen_registry(-1), fhicl::exception);
+}
+
+BOOST_AUTO_TEST_CASE(TestFrozenCorrupt)
+{
+  // A copy of a good segment, to be corrupted in a temporary file.
+  int const fd = ParameterSetRegistry::freeze();
+  std::string good(::lseek(fd, 0, SEEK_END), '\0');
+  BOOST_REQUIRE_EQUAL(::pread(fd, &good[0], good.size(), 0), ssize_t(good.size()));
+  BOOST_REQUIRE(detail::frozen_registry(fd).size() > 0u);
+
+  auto const opens = [](std::string const & bytes) {
+    char name[] = "/tmp/frozen_registry_t-XXXXXX";
+    int const tmp = ::mkstemp(name);
+    BOOST_REQUIRE(tmp >= 0);
+    ::unlink(name);
+    BOOST_REQUIRE_EQUAL(::write(tmp, bytes.data(), bytes.size()), ssize_t(bytes.size()));
+    bool ok = true;
+    try { detail::frozen_registry const frozen(tmp); }
+    catch (fhicl::exception const &) { ok = false; }
+    ::close(tmp);
+    return ok;
+  };
+  BOOST_CHECK(opens(good));
+
+  // Header: magic[8], count, bytes. Entry: id[40], offset, length.
+  std::size_t const header_sz = 24u, entry_sz = 56u;
+  auto const with = [&good](std::size_t at, std::uint64_t value) {
+    std::string bytes(good);
+    std::memcpy(&bytes[at], &value, sizeof value);
+    return bytes;
+  };
+  BOOST_CHECK(!opens(with(8u, std::uint64_t(-1) / entry_sz)));  // count
+  BOOST_CHECK(!opens(with(16u, good.size() + 1u)));             // bytes
+  BOOST_CHECK(!opens(with(header_sz + 40u, good.size())));      // offset
+  BOOST_CHECK(!opens(with(header_sz + 48u, good.size())));      // length
+  BOOST_CHECK(!opens(with(header_sz + 40u, 0u)));               // in table
+  BOOST_CHECK(!opens(good.substr(0, 10u)));                     // truncated
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,124 @@
+#define BOOST_TEST_MODULE ( ReloadableDocuments_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/file_watcher.h"
+#include "cetlib/filepath_maker.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/ReloadableDocuments.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+namespace {
+  void write(std::string const & filename, std::string const & contents)
+  {
+    // Replace the file as editors do, so its inode changes.
+    std::string const tmp = filename + ".tmp";
+    { std::ofstream f(tmp); f << contents; }
+    std::rename(tmp.c_str(), filename.c_str());
+  }
+
+  std::vector<std::string> const & v(std::vector<std::string> const & x) { return x; }
+}
+
+BOOST_AUTO_TEST_SUITE(ReloadableDocuments_t)
+
+BOOST_AUTO_TEST_CASE(reload)
+{
+  write("common.fcl", "BEGIN_PROLOG\nlimit: 5\nEND_PROLOG\n");
+  write("a_extra.fcl", "a_extra: 1\n");
+  write("a.fcl", "#include \"common.fcl\"\n#include \"a_extra.fcl\"\nx: @local::limit\ny: { z: 2 }\n");
+  write("b.fcl", "#include \"common.fcl\"\nw: @local::limit\n");
+
+  cet::filepath_maker fpm;
+  ReloadableDocuments docs(fpm);
+  ParameterSetID const a0 = docs.add("a.fcl").id();
+  ParameterSetID const b0 = docs.add("b.fcl").id();
+  BOOST_CHECK_EQUAL(docs.get("a.fcl").get<int>("x"), 5);
+  BOOST_CHECK_NO_THROW(ParameterSetRegistry::get(a0));
+  BOOST_CHECK_EQUAL(docs.graph("a.fcl").nodes().size(), 3u);
+  BOOST_CHECK(docs.graph("a.fcl").up_to_date());
+  BOOST_CHECK(docs.files() ==
+              v({ "a.fcl", "common.fcl", "a_extra.fcl", "b.fcl" }));
+  BOOST_CHECK_THROW(docs.get("c.fcl"), fhicl::exception);
+
+  // Nothing changed.
+  BOOST_CHECK(docs.reload().empty());
+
+  // A file only a.fcl depends on.
+  write("a_extra.fcl", "a_extra: 2\n");
+  auto changes = docs.reload();
+  BOOST_REQUIRE_EQUAL(changes.size(), 1u);
+  BOOST_CHECK_EQUAL(changes[0].filename, "a.fcl");
+  BOOST_CHECK(changes[0].ok());
+  BOOST_CHECK(changes[0].old_id == a0);
+  BOOST_CHECK(changes[0].new_id == docs.get("a.fcl").id());
+  BOOST_CHECK(changes[0].changed_keys == v({ "a_extra" }));
+  BOOST_CHECK(docs.get("b.fcl").id() == b0);
+  BOOST_CHECK_NO_THROW(ParameterSetRegistry::get(changes[0].new_id));
+
+  // A file both depend on.
+  write("common.fcl", "BEGIN_PROLOG\nlimit: 6\nEND_PROLOG\n");
+  changes = docs.reload();
+  BOOST_REQUIRE_EQUAL(changes.size(), 2u);
+  BOOST_CHECK(changes[0].changed_keys == v({ "x" }));
+  BOOST_CHECK(changes[1].changed_keys == v({ "w" }));
+
+  // An edit that leaves the ParameterSets alone is not reported.
+  write("common.fcl", "BEGIN_PROLOG\n# comment\nlimit: 6\nEND_PROLOG\n");
+  BOOST_CHECK(docs.reload().empty());
+  BOOST_CHECK(docs.graph("b.fcl").up_to_date());
+
+  // Only the named files are considered.
+  write("b.fcl", "#include \"common.fcl\"\nw: 0\n");
+  BOOST_CHECK(docs.reload(v({ "a_extra.fcl" })).empty());
+  changes = docs.reload(v({ "b.fcl" }));
+  BOOST_REQUIRE_EQUAL(changes.size(), 1u);
+  BOOST_CHECK_EQUAL(changes[0].filename, "b.fcl");
+
+  // A broken edit keeps the previous ParameterSet and is retried.
+  ParameterSetID const a1 = docs.get("a.fcl").id();
+  write("a_extra.fcl", "a_extra: [\n");
+  changes = docs.reload();
+  BOOST_REQUIRE_EQUAL(changes.size(), 1u);
+  BOOST_CHECK(!changes[0].ok());
+  BOOST_CHECK(changes[0].new_id == a1);
+  BOOST_CHECK(docs.get("a.fcl").id() == a1);
+  write("a_extra.fcl", "a_extra: 3\n");
+  changes = docs.reload();
+  BOOST_REQUIRE_EQUAL(changes.size(), 1u);
+  BOOST_CHECK(changes[0].ok());
+  BOOST_CHECK(changes[0].changed_keys == v({ "a_extra" }));
+}
+
+BOOST_AUTO_TEST_CASE(watched_reload)
+{
+  write("w.fcl", "#include \"w_inc.fcl\"\n");
+  write("w_inc.fcl", "p: 1\n");
+  write("w_other.fcl", "q: 1\n");
+
+  cet::filepath_maker fpm;
+  ReloadableDocuments docs(fpm);
+  docs.add("w.fcl");
+  cet::file_watcher watcher;
+  watcher.watch(docs.files());
+
+  BOOST_CHECK(watcher.wait(0).empty());
+  write("w_other.fcl", "q: 2\n");  // not watched
+  BOOST_CHECK(watcher.wait(50).empty());
+
+  write("w_inc.fcl", "p: 2\n");
+  auto const changed = watcher.wait(5000);
+  BOOST_CHECK(changed == v({ "w_inc.fcl" }));
+  auto const changes = docs.reload(changed);
+  BOOST_REQUIRE_EQUAL(changes.size(), 1u);
+  BOOST_CHECK(changes[0].changed_keys == v({ "p" }));
+  BOOST_CHECK_EQUAL(docs.get("w.fcl").get<int>("p"), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+// ======================================================================
+//
+// atom_pool_benchmark: heap used by a registry of ParameterSets, and
+//                      the cost of get<>() on them, with and without
+//                      the atom_pool
+//
+// Usage: atom_pool_benchmark [db-file]
+//
+// The ParameterSets are those of db-file's ParameterSets table (as
+// written by ParameterSetRegistry::exportTo(), e.g. from an art output
+// file), or a synthetic set of module configurations. Each mode runs in
+// its own child process, so that both start from the same heap.
+//
+// ======================================================================
+
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/atom_pool.h"
+#include "fhiclcpp/make_ParameterSet.h"
+
+#include "sqlite3.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <malloc.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace fhicl;
+
+namespace {
+
+  typedef  std::vector<std::pair<std::string, std::string>>  blobs_t;
+
+  // Bytes currently allocated, or 0 if that can't be told.
+  std::size_t
+  heap_in_use()
+  {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0u;
+#endif
+  }
+
+  blobs_t
+  read_db(char const * filename)
+  {
+    blobs_t result;
+    sqlite3 * db = nullptr;
+    if (sqlite3_open_v2(filename, &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+      std::cerr << "Can't open " << filename << '\n';
+      return result;
+    }
+    sqlite3_stmt * stmt = nullptr;
+    sqlite3_prepare_v2(db, "SELECT ID, PSetBlob FROM ParameterSets;", -1, &stmt, nullptr);
+    while (stmt && sqlite3_step(stmt) == SQLITE_ROW) {
+      result.emplace_back(reinterpret_cast<char const *>(sqlite3_column_text(stmt, 0)),
+                          reinterpret_cast<char const *>(sqlite3_column_text(stmt, 1)));
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    return result;
+  }
+
+  // Many modules, configured alike.
+  blobs_t
+  synthesize(unsigned n)
+  {
+    static char const * const types[] = { "\"HitFinder\"", "\"TrackMaker\"",
+                                          "\"ClusterMaker\"", "\"RootOutput\"" };
+    blobs_t result;
+    for (unsigned i = 0; i != n; ++i) {
+      std::string text =
+        "module_type: " + std::string(types[i % 4]) +
+        " module_label: \"module" + std::to_string(i % 200) + "\""
+        " verbose: " + (i % 3 ? "false" : "true") +
+        " threshold: " + std::to_string(i % 7) +
+        " calibration_tag: \"calibration_v3_2015_production\""
+        " input_tag: \"daq:raw:DetSim\""
+        " channels: [ 0, 1, 2, 3, 4, 5, 6, 7 ]"
+        " window: { lo: -10 hi: 10 units: \"microseconds\" }"
+        " run: " + std::to_string(i);
+      ParameterSet ps;
+      make_ParameterSet(text, ps);
+      result.emplace_back(ps.id().to_string(), ps.to_compact_string());
+    }
+    return result;
+  }
+
+  void
+  run(blobs_t const & blobs, bool pooled)
+  {
+    atom_pool::enable(pooled);
+    std::size_t const heap0 = heap_in_use();
+    for (auto const & b : blobs) {
+      ParameterSet ps;
+      make_ParameterSet(b.second, ps);
+      ParameterSetRegistry::put(ps);
+    }
+    std::size_t const heap1 = heap_in_use();
+
+    // Access: every top-level atom, as a string.
+    auto const start = std::chrono::steady_clock::now();
+    std::size_t gets = 0u, chars = 0u;
+    for (unsigned pass = 0; pass != 5; ++pass) {
+      for (auto const & p : ParameterSetRegistry::get()) {
+        ParameterSet const & ps = p.second;
+        for (auto const & key : ps.get_keys()) {
+          if (!ps.is_key_to_atom(key)) { continue; }
+          std::string value;
+          try { value = ps.get<std::string>(key); }
+          catch (fhicl::exception const &) { continue; }  // nil
+          chars += value.size();
+          ++gets;
+        }
+      }
+    }
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+
+    atom_pool::statistics const s = atom_pool::stats();
+    std::printf("%-9s documents: %zu  registry: %zu  heap: %zu bytes  get: %.3f us"
+                "  pool strings: %zu (%zu bytes, %zu of %zu atoms shared)\n",
+                pooled ? "pooled" : "unpooled",
+                blobs.size(), ParameterSetRegistry::size(),
+                heap1 - heap0, gets ? 1e6 * t.count() / gets : 0.0,
+                s.strings, s.bytes, s.hits, s.requests);
+    if (chars == 0u && gets != 0u) { std::printf("(no data)\n"); }
+  }
+
+}
+
+int
+main(int argc, char * argv[])
+{
+  blobs_t const blobs = argc > 1 ? read_db(argv[1]) : synthesize(20000u);
+  if (heap_in_use() == 0u) {
+    std::printf("(heap usage is not available on this platform)\n");
+  }
+  for (bool pooled : { false, true }) {
+    std::fflush(stdout);
+    pid_t const pid = fork();
+    if (pid == 0) {
+      run(blobs, pooled);
+      std::fflush(stdout);
+      _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+  }
+  return 0;
+}
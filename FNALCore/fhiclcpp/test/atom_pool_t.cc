@@ -0,0 +1,86 @@
+#define BOOST_TEST_MODULE ( atom_pool_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/atom_pool.h"
+#include "fhiclcpp/make_ParameterSet.h"
+
+#include <complex>
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+namespace {
+  std::string const doc =
+    "module_type: \"HitFinder\" verbose: true threshold: 1.5 nothing: @nil"
+    " labels: [ \"a\", \"b\" ] grid: [ [ 1, 2 ], [ 3 ] ] cplx: (1,2)"
+    " nested: { module_type: \"HitFinder\" verbose: true }";
+
+  ParameterSet
+  pset_of(std::string const & text)
+  {
+    ParameterSet ps;
+    make_ParameterSet(text, ps);
+    return ps;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(atom_pool_t)
+
+BOOST_AUTO_TEST_CASE(same_values)
+{
+  BOOST_REQUIRE(!atom_pool::enabled());
+  ParameterSet const plain = pset_of(doc);
+
+  atom_pool::enable();
+  ParameterSet pooled = pset_of(doc);
+  BOOST_CHECK(pooled == plain);
+  BOOST_CHECK_EQUAL(pooled.to_string(), plain.to_string());
+  BOOST_CHECK_EQUAL(pooled.to_indented_string(), plain.to_indented_string());
+  BOOST_CHECK_EQUAL(pooled.get<std::string>("module_type"), "HitFinder");
+  BOOST_CHECK(pooled.get<bool>("verbose"));
+  BOOST_CHECK_EQUAL(pooled.get<double>("threshold"), 1.5);
+  BOOST_CHECK(pooled.get<void *>("nothing") == nullptr);
+  BOOST_CHECK(pooled.get<std::vector<std::string>>("labels") ==
+              std::vector<std::string>({ "a", "b" }));
+  BOOST_CHECK(pooled.get<std::vector<std::vector<int>>>("grid") ==
+              std::vector<std::vector<int>>({ { 1, 2 }, { 3 } }));
+  BOOST_CHECK(pooled.get<std::complex<double>>("cplx") == std::complex<double>(1, 2));
+  BOOST_CHECK(pooled.get<ParameterSet>("nested").get<bool>("verbose"));
+  BOOST_CHECK(pooled.is_key_to_atom("verbose"));
+  BOOST_CHECK(pooled.get_differing_keys(plain).empty());
+
+  pooled.put_or_replace("verbose", false);
+  pooled.put_or_replace_compatible("threshold", 2);
+  pooled.put("more", std::vector<int>({ 1, 2 }));
+  BOOST_CHECK(!pooled.get<bool>("verbose"));
+  BOOST_CHECK_EQUAL(pooled.get<int>("threshold"), 2);
+  BOOST_CHECK(pooled.get<std::vector<int>>("more") == std::vector<int>({ 1, 2 }));
+  BOOST_CHECK(pooled.get_differing_keys(plain) ==
+              std::vector<std::string>({ "more", "threshold", "verbose" }));
+  atom_pool::enable(false);
+}
+
+BOOST_AUTO_TEST_CASE(sharing)
+{
+  atom_pool::enable();
+  std::string const & a = atom_pool::intern("\"HitFinder\"");
+  BOOST_CHECK_EQUAL(&atom_pool::intern(std::string("\"HitFinder\"")), &a);
+
+  atom_pool::statistics const before = atom_pool::stats();
+  std::vector<ParameterSet> psets;
+  for (int i = 0; i != 100; ++i) {
+    psets.push_back(pset_of("module_type: \"HitFinder\" verbose: true"
+                            " index: " + std::to_string(i % 10)));
+  }
+  atom_pool::statistics const after = atom_pool::stats();
+  BOOST_CHECK_EQUAL(after.requests - before.requests, 300u);
+  BOOST_CHECK(after.strings - before.strings <= 10u);
+  BOOST_CHECK(after.hits - before.hits >= 290u);
+  BOOST_CHECK(after.bytes >= after.strings);
+  atom_pool::enable(false);
+  BOOST_CHECK_EQUAL(psets.back().get<int>("index"), 9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
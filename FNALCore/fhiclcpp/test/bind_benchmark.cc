@@ -0,0 +1,102 @@
+// ======================================================================
+//
+// bind_benchmark: fhicl::bind<>() against the equivalent get<>() calls
+//
+// Usage: bind_benchmark [iterations]
+//
+// ======================================================================
+
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/bind.h"
+#include "fhiclcpp/make_ParameterSet.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+namespace {
+  struct Window {
+    double lo;
+    double hi;
+  };
+
+  struct Module {
+    std::string         module_type;
+    int                 verbosity = 0;
+    unsigned            max_hits = 100u;
+    double              threshold = 0.5;
+    bool                use_calib = true;
+    std::string         calib_tag;
+    std::vector<int>    channels;
+    Window              window;
+  };
+}
+
+FHICL_BINDING( Window
+             , FHICL_REQUIRED(lo)
+             , FHICL_REQUIRED(hi)
+             )
+
+FHICL_BINDING( Module
+             , FHICL_REQUIRED(module_type)
+             , FHICL_OPTIONAL(verbosity)
+             , FHICL_OPTIONAL(max_hits)
+             , FHICL_OPTIONAL(threshold)
+             , FHICL_OPTIONAL(use_calib)
+             , FHICL_OPTIONAL(calib_tag)
+             , FHICL_OPTIONAL(channels)
+             , FHICL_REQUIRED(window)
+             )
+
+namespace {
+  Module
+  by_get(ParameterSet const & ps)
+  {
+    Module m;
+    m.module_type = ps.get<std::string>("module_type");
+    m.verbosity   = ps.get<int>("verbosity", 0);
+    m.max_hits    = ps.get<unsigned>("max_hits", 100u);
+    m.threshold   = ps.get<double>("threshold", 0.5);
+    m.use_calib   = ps.get<bool>("use_calib", true);
+    m.calib_tag   = ps.get<std::string>("calib_tag", std::string());
+    m.channels    = ps.get<std::vector<int>>("channels", std::vector<int>());
+    m.window.lo   = ps.get<double>("window.lo");
+    m.window.hi   = ps.get<double>("window.hi");
+    return m;
+  }
+
+  template< class F >
+  double
+  seconds(unsigned n, F f)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != n; ++i) { f(); }
+    std::chrono::duration<double> const d = std::chrono::steady_clock::now() - start;
+    return d.count();
+  }
+}
+
+int
+main(int argc, char * argv[])
+{
+  unsigned const n = argc > 1 ? std::atoi(argv[1]) : 20000u;
+  ParameterSet ps;
+  make_ParameterSet("module_type: \"HitFinder\" verbosity: 2 max_hits: 500"
+                    " threshold: 1.25 use_calib: false calib_tag: \"v3\""
+                    " channels: [ 1, 2, 3, 4, 5, 6, 7, 8 ]"
+                    " window: { lo: -10 hi: 10 } unrelated: { a: 1 }", ps);
+
+  long sink = 0;
+  double const t_get = seconds(n, [&]{ sink += by_get(ps).max_hits; });
+  double const t_bind = seconds(n, [&]{ sink += bind<Module>(ps).max_hits; });
+
+  std::cout << "iterations:      " << n << '\n'
+            << "get<>() (us/op): " << 1e6 * t_get / n << '\n'
+            << "bind<> (us/op):  " << 1e6 * t_bind / n << '\n'
+            << "speedup:         " << t_get / t_bind << '\n';
+  return sink == 0;
+}
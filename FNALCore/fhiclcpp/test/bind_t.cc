@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE ( bind_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/bind.h"
+#include "fhiclcpp/exception.h"
+#include "fhiclcpp/make_ParameterSet.h"
+
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+namespace {
+  struct Point {
+    double x;
+    double y = -1.0;
+  };
+
+  struct Gen {
+    int                               seed;
+    std::string                       tag = "none";
+    bool                              verbose = false;
+    std::vector<unsigned>             runs;
+    std::vector<std::vector<int>>     grid;
+    Point                             origin;
+    std::vector<Point>                path;
+    ParameterSet                      extra;
+  };
+}
+
+FHICL_BINDING( Point
+             , FHICL_REQUIRED(x)
+             , FHICL_OPTIONAL(y)
+             )
+
+FHICL_BINDING( Gen
+             , FHICL_REQUIRED(seed)
+             , FHICL_OPTIONAL(tag)
+             , FHICL_OPTIONAL(verbose)
+             , FHICL_OPTIONAL(runs)
+             , FHICL_OPTIONAL(grid)
+             , FHICL_REQUIRED(origin)
+             , FHICL_OPTIONAL(path)
+             , FHICL_OPTIONAL(extra)
+             )
+
+namespace {
+  ParameterSet
+  pset_of(std::string const & text)
+  {
+    ParameterSet ps;
+    make_ParameterSet(text, ps);
+    return ps;
+  }
+
+  std::string
+  error_of(std::string const & text)
+  {
+    try {
+      bind<Gen>(pset_of(text));
+    }
+    catch (fhicl::exception const & e) {
+      return e.what();
+    }
+    return std::string();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(bind_t)
+
+BOOST_AUTO_TEST_CASE(all_fields)
+{
+  ParameterSet const ps =
+    pset_of("seed: 7 tag: \"abc\" verbose: true runs: [ 1, 2, 3 ]"
+            " grid: [ [ 1 ], [ 2, 3 ] ] origin: { x: 1.5 y: 2 }"
+            " path: [ { x: 0 }, { x: 1 y: 1 } ] extra: { a: 1 }"
+            " unused: 0");
+  Gen const g = bind<Gen>(ps);
+  BOOST_CHECK_EQUAL(g.seed, 7);
+  BOOST_CHECK_EQUAL(g.tag, "abc");
+  BOOST_CHECK(g.verbose);
+  BOOST_CHECK(g.runs == std::vector<unsigned>({ 1, 2, 3 }));
+  BOOST_CHECK(g.grid == std::vector<std::vector<int>>({ { 1 }, { 2, 3 } }));
+  BOOST_CHECK_EQUAL(g.origin.x, 1.5);
+  BOOST_CHECK_EQUAL(g.origin.y, 2.0);
+  BOOST_REQUIRE_EQUAL(g.path.size(), 2u);
+  BOOST_CHECK_EQUAL(g.path[0].y, -1.0);
+  BOOST_CHECK_EQUAL(g.path[1].y, 1.0);
+  BOOST_CHECK_EQUAL(g.extra.get<int>("a"), 1);
+
+  // The same values as get<>().
+  BOOST_CHECK_EQUAL(g.seed, ps.get<int>("seed"));
+  BOOST_CHECK(g.runs == ps.get<std::vector<unsigned>>("runs"));
+  BOOST_CHECK_EQUAL(g.origin.x, ps.get<double>("origin.x"));
+}
+
+BOOST_AUTO_TEST_CASE(defaults)
+{
+  Gen const g = bind<Gen>(pset_of("seed: 1 origin: { x: 0 }"));
+  BOOST_CHECK_EQUAL(g.tag, "none");
+  BOOST_CHECK(!g.verbose);
+  BOOST_CHECK(g.runs.empty());
+  BOOST_CHECK_EQUAL(g.origin.y, -1.0);
+  BOOST_CHECK(g.extra.is_empty());
+}
+
+BOOST_AUTO_TEST_CASE(errors)
+{
+  std::string e;
+
+  e = error_of("origin: { x: 0 }");
+  BOOST_CHECK(e.find("Can't find key") != std::string::npos);
+  BOOST_CHECK(e.find("seed") != std::string::npos);
+
+  e = error_of("seed: 1 origin: { y: 0 }");
+  BOOST_CHECK(e.find("origin.x") != std::string::npos);
+
+  e = error_of("seed: \"seven\" origin: { x: 0 }");
+  BOOST_CHECK(e.find("Type mismatch") != std::string::npos);
+  BOOST_CHECK(e.find("seed") != std::string::npos);
+
+  e = error_of("seed: 1 origin: 3");
+  BOOST_CHECK(e.find("origin") != std::string::npos);
+  BOOST_CHECK(e.find("not a table") != std::string::npos);
+
+  e = error_of("seed: 1 origin: { x: 0 } path: [ { x: 0 }, { x: [] } ]");
+  BOOST_CHECK(e.find("path[1].x") != std::string::npos);
+
+  e = error_of("seed: 1 origin: { x: 0 } path: { x: 0 }");
+  BOOST_CHECK(e.find("not a sequence") != std::string::npos);
+
+  e = error_of("seed: 1 origin: { x: 0 } runs: [ 1, -2 ]");
+  BOOST_CHECK(e.find("runs[1]") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,54 @@
+#define BOOST_TEST_MODULE ( make_ParameterSets_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "cetlib/filepath_maker.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
+#include "fhiclcpp/make_ParameterSet.h"
+
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+BOOST_AUTO_TEST_SUITE(make_ParameterSets_t)
+
+BOOST_AUTO_TEST_CASE(matches_serial)
+{
+  std::vector<std::string> files;
+  for (unsigned i = 0; i != 40; ++i) {
+    files.emplace_back("db_" + std::to_string(i % 3) + ".fcl");
+  }
+  files.emplace_back("test_config_fail.fcl");
+  files.emplace_back("no_such_file.fcl");
+
+  cet::filepath_maker fpm;
+  auto const results = make_ParameterSets(files, fpm, 8);
+  BOOST_REQUIRE_EQUAL(results.size(), files.size());
+
+  for (unsigned i = 0; i != 40; ++i) {
+    auto const & r = results[i];
+    BOOST_CHECK_EQUAL(r.filename, files[i]);
+    BOOST_REQUIRE_MESSAGE(r.ok(), r.error);
+    ParameterSet serial;
+    make_ParameterSet(files[i], fpm, serial);
+    BOOST_CHECK(r.pset == serial);
+    // Nested tables must have reached the registry.
+    for (auto const & key : r.pset.get_pset_keys()) {
+      BOOST_CHECK_NO_THROW(ParameterSetRegistry::get(r.pset.get<ParameterSet>(key).id()));
+    }
+  }
+
+  // Failures are reported per document.
+  BOOST_CHECK(!results[40].ok());
+  BOOST_CHECK(results[40].pset.is_empty());
+  BOOST_CHECK(!results[41].ok());
+}
+
+BOOST_AUTO_TEST_CASE(empty_batch)
+{
+  cet::filepath_maker fpm;
+  BOOST_CHECK(make_ParameterSets(std::vector<std::string>(), fpm).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+#define BOOST_TEST_MODULE ( move_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/exception.h"
+#include "fhiclcpp/intermediate_table.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "fhiclcpp/parse.h"
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+// Count the allocations big enough to hold one of the long strings
+// below, i.e. the copies of their contents.
+namespace {
+  std::size_t const large = 3000u;
+  std::size_t large_allocations = 0u;
+}
+
+void *
+operator new(std::size_t n)
+{
+  if (n >= large) { ++large_allocations; }
+  void * const p = std::malloc(n ? n : 1u);
+  if (p == nullptr) { throw std::bad_alloc(); }
+  return p;
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+  std::string const text(4000u, 'x');
+  std::string const quoted = '"' + text + '"';
+
+  std::string
+  document()
+  {
+    std::string doc = "big: " + quoted + " seq: [ ";
+    for (int i = 0; i != 20; ++i) {
+      doc += (i ? ", " : "") + quoted;
+    }
+    return doc + " ] n: 1";
+  }
+
+  // Large allocations made by f.
+  template< class F >
+  std::size_t
+  copies(F f)
+  {
+    std::size_t const before = large_allocations;
+    f();
+    return large_allocations - before;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(move_t)
+
+BOOST_AUTO_TEST_CASE(from_intermediate_table)
+{
+  intermediate_table tbl;
+  parse_document(document(), tbl);
+  intermediate_table tbl2(tbl);
+
+  ParameterSet copied, moved;
+  BOOST_CHECK_EQUAL(copies([&]{ make_ParameterSet(tbl, copied); }), 21u);
+  BOOST_CHECK_EQUAL(copies([&]{ make_ParameterSet(std::move(tbl2), moved); }), 0u);
+  BOOST_CHECK(moved == copied);
+  BOOST_CHECK_EQUAL(moved.get<std::string>("big"), text);
+}
+
+BOOST_AUTO_TEST_CASE(put)
+{
+  ParameterSet ps;
+  std::vector<std::string> v(3u, quoted);
+  BOOST_CHECK_EQUAL(copies([&]{ ps.put("v", std::move(v)); }), 0u);
+  BOOST_CHECK(ps.get<std::vector<std::string>>("v") ==
+              std::vector<std::string>(3u, text));
+  std::string q(quoted);
+  BOOST_CHECK_EQUAL(copies([&]{ ps.put("q", std::move(q)); }), 0u);
+  BOOST_CHECK_EQUAL(ps.get<std::string>("q"), text);
+  // Strings needing a canonical form are encoded as copies are.
+  std::string t(text);
+  BOOST_CHECK(copies([&]{ ps.put("t", std::move(t)); }) > 0u);
+  BOOST_CHECK_EQUAL(ps.get<std::string>("t"), text);
+  std::string e("\"a\\tb\"");
+  ps.put("e", std::move(e));
+  BOOST_CHECK_EQUAL(ps.get<std::string>("e"), "a\tb");
+  ps.put_or_replace("s", std::string("abc"));
+  ps.put_or_replace_compatible("s", std::string("def"));
+  BOOST_CHECK_EQUAL(ps.get<std::string>("s"), "def");
+  BOOST_CHECK_THROW(ps.put("s", std::string("ghi")), fhicl::exception);
+
+  // Nested ParameterSets go into the registry without being copied.
+  ParameterSet inner1, inner2;
+  make_ParameterSet("big: " + quoted + " i: 1", inner1);
+  make_ParameterSet("big: " + quoted + " i: 2", inner2);
+  ParameterSet const expected(inner2);
+  std::size_t const by_copy = copies([&]{ ps.put("inner1", inner1); });
+  std::size_t const by_move = copies([&]{ ps.put("inner2", std::move(inner2)); });
+  BOOST_CHECK_EQUAL(by_move + 1u, by_copy);
+  BOOST_CHECK(ps.get<ParameterSet>("inner2") == expected);
+}
+
+BOOST_AUTO_TEST_CASE(extract)
+{
+  ParameterSet ps;
+  make_ParameterSet(document(), ps);
+  ParameterSetID const id = ps.id();
+
+  std::string big;
+  BOOST_CHECK_EQUAL(copies([&]{ big = ps.extract<std::string>("big"); }), 0u);
+  BOOST_CHECK_EQUAL(big, text);
+  BOOST_CHECK(!ps.has_key("big"));
+  BOOST_CHECK(ps.id() != id);
+
+  std::vector<std::string> seq;
+  BOOST_CHECK_EQUAL(copies([&]{ seq = ps.extract<std::vector<std::string>>("seq"); }), 0u);
+  BOOST_CHECK(seq == std::vector<std::string>(20u, text));
+
+  int n = 0;
+  BOOST_CHECK(!ps.extract_if_present("missing", n));
+  BOOST_CHECK_THROW(ps.extract<int>("missing"), fhicl::exception);
+  BOOST_CHECK_THROW(ps.extract<int>("a.b"), fhicl::exception);
+  BOOST_CHECK(ps.extract_if_present("n", n));
+  BOOST_CHECK_EQUAL(n, 1);
+  BOOST_CHECK(ps.is_empty());
+
+  // A mismatched extract leaves the parameter, and the ID, as they were.
+  std::string const doc = "s: " + quoted + " mixed: [ " + quoted + ", [ 1 ] ]";
+  ParameterSet kept;
+  make_ParameterSet(doc, kept);
+  ParameterSet const before(kept);
+  BOOST_CHECK_THROW(kept.extract<int>("s"), fhicl::exception);
+  BOOST_CHECK_THROW(kept.extract<std::vector<std::string>>("mixed"), fhicl::exception);
+  BOOST_CHECK(kept.has_key("s"));
+  BOOST_CHECK(kept.has_key("mixed"));
+  BOOST_CHECK_EQUAL(kept.get<std::string>("s"), text);
+  BOOST_CHECK_EQUAL(kept.to_string(), before.to_string());
+  BOOST_CHECK(kept.id() == before.id());
+
+  // Escaped strings are unescaped as by get<>().
+  make_ParameterSet("s: \"a\\tb\"", ps);
+  std::string const expected = ps.get<std::string>("s");
+  BOOST_CHECK_EQUAL(ps.extract<std::string>("s"), expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
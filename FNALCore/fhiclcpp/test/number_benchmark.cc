@@ -0,0 +1,123 @@
+// ======================================================================
+//
+// number_benchmark: throughput of the number canonicalization,
+//                   formatting and parsing of number.h against the
+//                   cetlib and lexical_cast functions they replace
+//
+// Usage: number_benchmark [iterations]
+//
+// ======================================================================
+
+#include "boost/lexical_cast.hpp"
+#include "cetlib/canonical_number.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/number.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+namespace {
+
+  // ns per item of f(item) over items, repeated n times.
+  template< class T, class F >
+  double
+  time(std::vector<T> const & items, unsigned n, F f)
+  {
+    std::size_t sink = 0u;
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != n; ++i) {
+      for (auto const & item : items) { sink += f(item); }
+    }
+    std::chrono::duration<double> const t = std::chrono::steady_clock::now() - start;
+    if (sink == 1u) { std::printf(" "); }
+    return 1e9 * t.count() / (double(n) * items.size());
+  }
+
+  void
+  report(char const * what, double before, double after)
+  {
+    std::printf("%-22s %9.1f ns %9.1f ns  x%.1f\n", what, before, after, before / after);
+  }
+
+}
+
+int
+main(int argc, char * argv[])
+{
+  unsigned const n = argc > 1 ? std::atoi(argv[1]) : 20u;
+  std::mt19937_64 rng(1u);
+
+  std::vector<long double> reals;
+  std::vector<std::uintmax_t> ints;
+  std::vector<std::string> literals, atoms, int_atoms;
+  for (int i = 0; i != 10000; ++i) {
+    long double const x = std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+    std::uintmax_t const u = rng() >> (rng() % 64u);
+    reals.push_back(x);
+    ints.push_back(u);
+    static char const * const forms[] = { "%.6Lg", "%.3Le", "%.0Lf", "%.17Lg" };
+    char buf[64];
+    std::snprintf(buf, sizeof buf, forms[i % 4], x);
+    literals.push_back(buf);
+    std::snprintf(buf, sizeof buf, "0x%llx", (unsigned long long)u);
+    literals.push_back(buf);
+    std::string atom;
+    detail::format_number(x, atom);
+    atoms.push_back(atom);
+    atom.clear();
+    detail::format_number(u, atom);
+    int_atoms.push_back(atom);
+  }
+
+  std::printf("%-22s %12s %12s\n", "", "before", "after");
+  report("canonical_number",
+         time(literals, n, [](std::string const & s) {
+           std::string r; cet::canonical_number(s, r); return r.size(); }),
+         time(literals, n, [](std::string const & s) {
+           std::string r; detail::canonical_number(s, r); return r.size(); }));
+  report("format floating",
+         time(reals, n, [](long double x) {
+           std::string r; cet::canonical_number(boost::lexical_cast<std::string>(x), r);
+           return r.size(); }),
+         time(reals, n, [](long double x) {
+           std::string r; detail::format_number(x, r); return r.size(); }));
+  report("format integer",
+         time(ints, n, [](std::uintmax_t u) {
+           std::string r = boost::lexical_cast<std::string>(u);
+           if (r.size() > 6) {
+             std::size_t const sz = r.size() - 1;
+             r.insert(1, ".");
+             r += "e+" + boost::lexical_cast<std::string>(sz);
+           }
+           return r.size(); }),
+         time(ints, n, [](std::uintmax_t u) {
+           std::string r; detail::format_number(u, r); return r.size(); }));
+  report("parse floating",
+         time(atoms, n, [](std::string const & s) {
+           return std::size_t(boost::lexical_cast<long double>(s) > 0); }),
+         time(atoms, n, [](std::string const & s) {
+           long double x = 0; detail::parse_number(s, x); return std::size_t(x > 0); }));
+  report("parse integer",
+         time(int_atoms, n, [](std::string const & s) {
+           return std::size_t(boost::lexical_cast<long double>(s) > 0); }),
+         time(int_atoms, n, [](std::string const & s) {
+           std::uintmax_t u = 0; detail::parse_number(s, u); return std::size_t(u); }));
+
+  // End to end, through the ParameterSet.
+  ParameterSet ps;
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i != 1000u; ++i) {
+    keys.push_back("k" + std::to_string(i));
+    ps.put(keys.back(), double(reals[i]));
+  }
+  std::printf("%-22s %12s %9.1f ns\n", "ParameterSet::get<>", "",
+              time(keys, n, [&ps](std::string const & k) {
+                return std::size_t(ps.get<double>(k) > 0); }));
+  return 0;
+}
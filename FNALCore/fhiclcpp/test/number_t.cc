@@ -0,0 +1,217 @@
+#define BOOST_TEST_MODULE ( number_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "boost/lexical_cast.hpp"
+#include "cetlib/canonical_number.h"
+#include "fhiclcpp/number.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace fhicl::detail;
+
+// The functions number.h replaces, as coding.cc had them.
+namespace {
+
+  std::string
+  old_format(std::uintmax_t value)
+  {
+    std::string result = boost::lexical_cast<std::string>(value);
+    if (result.size() > 6) {
+      std::size_t sz = result.size() - 1;
+      result.insert(1, ".");
+      result += "e+" + boost::lexical_cast<std::string>(sz);
+    }
+    return result;
+  }
+
+  std::string
+  old_format(long double value)
+  {
+    std::string result;
+    cet::canonical_number(boost::lexical_cast<std::string>(value), result);
+    return result;
+  }
+
+  void
+  check_canonical(std::string const & literal)
+  {
+    std::string expected = "#", result = "#";
+    bool const expected_ok = cet::canonical_number(literal, expected);
+    bool const ok = canonical_number(literal, result);
+    if (ok != expected_ok || result != expected) {
+      BOOST_ERROR("canonical_number(\"" << literal << "\"): \"" << result
+                  << "\" (" << ok << "), expected \"" << expected
+                  << "\" (" << expected_ok << ')');
+    }
+  }
+
+  // Every string of length 1 to max over alphabet.
+  template< class F >
+  void
+  each_string(std::string const & alphabet, std::size_t max, F f)
+  {
+    std::string s;
+    for (std::size_t len = 1u; len <= max; ++len) {
+      std::vector<std::size_t> ix(len, 0u);
+      s.assign(len, alphabet[0]);
+      for (;;) {
+        f(s);
+        std::size_t i = 0u;
+        for (; i != len && ++ix[i] == alphabet.size(); ++i) {
+          ix[i] = 0u;
+          s[i] = alphabet[0];
+        }
+        if (i == len) { break; }
+        s[i] = alphabet[ix[i]];
+      }
+    }
+  }
+
+  std::mt19937_64 rng(20150615u);
+}
+
+BOOST_AUTO_TEST_SUITE(number_t)
+
+BOOST_AUTO_TEST_CASE(canonical_exhaustive)
+{
+  each_string("0123456789.-+eE", 4u, check_canonical);
+  each_string("019.-+eE", 6u, check_canonical);
+  each_string("0aF9gxXbB", 4u, [](std::string const & s) {
+    check_canonical("0x" + s);
+    check_canonical("0X" + s);
+  });
+  each_string("012bB", 7u, [](std::string const & s) { check_canonical("0b" + s); });
+}
+
+BOOST_AUTO_TEST_CASE(canonical_random)
+{
+  static char const hex[] = "0123456789abcdefABCDEF";
+  std::uniform_int_distribution<int> len(1, 24), bin_len(1, 72), digit(0, 21);
+  for (int i = 0; i != 5000; ++i) {
+    std::string h = "0x", b = "0b";
+    for (int n = len(rng); n != 0; --n) { h += hex[digit(rng)]; }
+    for (int n = bin_len(rng); n != 0; --n) { b += char('0' + (rng() & 1u)); }
+    check_canonical(h);
+    check_canonical(b);
+
+    std::string d = (rng() & 1u) ? "-" : "";
+    for (int n = len(rng); n != 0; --n) { d += char('0' + digit(rng) % 10); }
+    if (rng() & 1u) {
+      d += '.';
+      for (int n = len(rng) % 8; n != 0; --n) { d += char('0' + digit(rng) % 10); }
+    }
+    if (rng() & 1u) {
+      d += "e" + std::to_string(std::uniform_int_distribution<int>(-400, 400)(rng));
+    }
+    check_canonical(d);
+  }
+  check_canonical("0x" + std::string(40u, 'F'));
+  check_canonical("0x00000000000000000000000001");
+  check_canonical("1e123456789012");
+}
+
+BOOST_AUTO_TEST_CASE(format_integers)
+{
+  std::uintmax_t const special[] = { 0u, 1u, 9u, 10u, 999999u, 1000000u, 1234567u,
+                                     std::numeric_limits<std::uintmax_t>::max() };
+  for (std::uintmax_t v : special) {
+    std::string s;
+    format_number(v, s);
+    BOOST_CHECK_EQUAL(s, old_format(v));
+  }
+  for (int i = 0; i != 100000; ++i) {
+    std::uintmax_t const v = rng() >> (rng() % 64u);
+    std::string s;
+    format_number(v, s);
+    BOOST_REQUIRE_EQUAL(s, old_format(v));
+
+    std::uintmax_t u = 0u;
+    BOOST_REQUIRE(parse_number(s, u));
+    BOOST_REQUIRE_EQUAL(u, v);
+    std::intmax_t n = 0;
+    if (v <= std::uintmax_t(std::numeric_limits<std::intmax_t>::max())) {
+      BOOST_REQUIRE(parse_number('-' + s, n));
+      BOOST_REQUIRE_EQUAL(n, -std::intmax_t(v));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(format_floating)
+{
+  long double const special[] = { 0.1L, 0.1, 1.5L, -3.25e-7L, 1.0L / 3, 1e30L, 1e-320L,
+                                  std::numeric_limits<long double>::max(),
+                                  std::numeric_limits<long double>::min(),
+                                  std::numeric_limits<long double>::denorm_min(),
+                                  std::numeric_limits<double>::max() };
+  for (long double v : special) {
+    std::string s;
+    format_number(v, s);
+    BOOST_CHECK_EQUAL(s, old_format(v));
+  }
+
+  std::uniform_int_distribution<int> exponent(-16000, 16000);
+  for (int i = 0; i != 40000; ++i) {
+    long double v;
+    if (i % 2) {
+      double d;
+      std::uint64_t bits = rng();
+      std::memcpy(&d, &bits, sizeof d);
+      if (!std::isfinite(d)) { continue; }
+      v = d;
+    } else {
+      v = std::ldexp((long double)rng() / 18446744073709551616.0L, exponent(rng));
+      if (rng() & 1u) { v = -v; }
+    }
+    std::string s;
+    format_number(v, s);
+    BOOST_REQUIRE_EQUAL(s, old_format(v));
+
+    // Atoms convert back as lexical_cast converts them.
+    long double back = 0;
+    if (parse_number(s, back)) {
+      BOOST_REQUIRE(back == boost::lexical_cast<long double>(s));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parse)
+{
+  std::uintmax_t u = 42u;
+  std::intmax_t n = 42;
+  long double x = 0;
+  BOOST_CHECK(parse_number("1.234567e+6", u) && u == 1234567u);
+  BOOST_CHECK(parse_number("1.5e1", u) && u == 15u);
+  BOOST_CHECK(parse_number("120.000", u) && u == 120u);
+  BOOST_CHECK(parse_number("0.0e-8", u) && u == 0u);
+  BOOST_CHECK(parse_number("18446744073709551615", u) && u == 18446744073709551615u);
+  BOOST_CHECK(parse_number("-9223372036854775808", n) &&
+              n == std::numeric_limits<std::intmax_t>::min());
+
+  // Left to the general path.
+  u = 42u;
+  n = 42;
+  BOOST_CHECK(!parse_number("18446744073709551616", u));
+  BOOST_CHECK(!parse_number("9223372036854775808", n));
+  BOOST_CHECK(!parse_number("1.5", u));
+  BOOST_CHECK(!parse_number("-1", u));
+  BOOST_CHECK(!parse_number("+1", u));
+  BOOST_CHECK(!parse_number("0x10", u));
+  BOOST_CHECK(!parse_number("1e", u));
+  BOOST_CHECK(!parse_number("1.", u));
+  BOOST_CHECK(!parse_number("", u));
+  BOOST_CHECK(!parse_number("+infinity", x));
+  BOOST_CHECK(!parse_number("1e99999", x));
+  BOOST_CHECK(!parse_number("1e9999", x));
+  BOOST_CHECK_EQUAL(u, 42u);
+  BOOST_CHECK_EQUAL(n, 42);
+
+  BOOST_CHECK(parse_number("2.5e-3", x) && x == boost::lexical_cast<long double>("2.5e-3"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE ( overlay_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/exception.h"
+#include "fhiclcpp/intermediate_table.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "fhiclcpp/overlay.h"
+#include "fhiclcpp/parse.h"
+
+#include <string>
+
+using namespace fhicl;
+
+namespace {
+  std::string const base_prolog =
+    "BEGIN_PROLOG\n"
+    "defaults: { seed: 1 tag: \"x\" }\n"
+    "END_PROLOG\n";
+  std::string const base_body =
+    "run: 1\n"
+    "files: [ \"a.root\", \"b.root\" ]\n"
+    "physics: {\n"
+    "  producers: { gen: { seed: 7 list: [ { c: 1 }, { c: 2 } ] } }\n"
+    "  analyzers: { ana: @local::defaults big: [ 1, 2, 3, 4, 5 ] }\n"
+    "}\n"
+    "services: { scheduler: { wantSummary: true } }\n";
+
+  std::string const overrides_prolog =
+    "BEGIN_PROLOG\n"
+    "more: { x: 1 y: 2 }\n"
+    "END_PROLOG\n";
+  std::string const overrides_body =
+    "run: 42\n"
+    "files[1]: \"c.root\"\n"
+    "files[3]: \"d.root\"\n"
+    "physics.producers.gen.list[1].c: 5\n"
+    "physics.producers.gen.seed: @erase\n"
+    "physics.producers.new.extra: [ @sequence::physics.producers.gen.list ]\n"
+    "services.scheduler: @erase\n"
+    "@table::more\n"
+    "nothing.here: @erase\n";
+
+  std::string const base_doc = base_prolog + base_body;
+  std::string const overrides = overrides_prolog + overrides_body;
+
+  // The text the overrides stand for: prologs must precede the body.
+  std::string
+  combined(std::string const & extra_body = std::string())
+  {
+    return base_prolog + overrides_prolog + base_body + overrides_body + extra_body;
+  }
+
+  ParameterSet
+  pset_of(std::string const & text)
+  {
+    ParameterSet ps;
+    make_ParameterSet(text, ps);
+    return ps;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(overlay_t)
+
+BOOST_AUTO_TEST_CASE(pset_matches_appended_text)
+{
+  ParameterSet const base = pset_of(base_doc);
+  ParameterSet result;
+  overlay(base, overrides, result);
+  ParameterSet const expected = pset_of(combined());
+  BOOST_CHECK_EQUAL(result.to_string(), expected.to_string());
+  BOOST_CHECK(result.id() == expected.id());
+
+  // Untouched subtrees are shared with base.
+  BOOST_CHECK(result.get<ParameterSet>("physics.analyzers").id() ==
+              base.get<ParameterSet>("physics.analyzers").id());
+  // base itself is unchanged.
+  BOOST_CHECK(base == pset_of(base_doc));
+  BOOST_CHECK_EQUAL(result.get<int>("run"), 42);
+  BOOST_CHECK(!result.has_key("more"));
+}
+
+BOOST_AUTO_TEST_CASE(table_forms)
+{
+  intermediate_table base;
+  parse_document(base_doc, base);
+
+  // References may resolve against base's prolog.
+  std::string const ref = "physics.analyzers.ana2: @local::defaults\n";
+  std::string const with_ref = overrides + ref;
+  intermediate_table merged;
+  overlay(base, with_ref, merged);
+  intermediate_table expected;
+  parse_document(combined(ref), expected);
+  ParameterSet a, b;
+  make_ParameterSet(merged, a);
+  make_ParameterSet(expected, b);
+  BOOST_CHECK(a == b);
+
+  ParameterSet c;
+  overlay(base, with_ref, c);
+  BOOST_CHECK(c == b);
+  BOOST_CHECK(base.exists("run"));
+  BOOST_CHECK(!base.exists("x"));
+}
+
+BOOST_AUTO_TEST_CASE(errors)
+{
+  ParameterSet const base = pset_of(base_doc);
+  ParameterSet result;
+  BOOST_CHECK_THROW(overlay(base, "run.x: 1\n", result), fhicl::exception);
+  BOOST_CHECK_THROW(overlay(base, "run[0]: 1\n", result), fhicl::exception);
+  BOOST_CHECK_THROW(overlay(base, "files[0]: @erase\n", result), fhicl::exception);
+  BOOST_CHECK_THROW(overlay(base, "run: [\n", result), fhicl::exception);
+  // The base's prolog is not available to a ParameterSet overlay.
+  BOOST_CHECK_THROW(overlay(base, "x: @local::defaults\n", result), fhicl::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
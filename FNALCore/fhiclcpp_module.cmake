@@ -11,12 +11,18 @@ set(PUBLIC_HDRS
   ${fhiclcpp_INCLUDE_DIR}/ParameterSet.h
   ${fhiclcpp_INCLUDE_DIR}/ParameterSetID.h
   ${fhiclcpp_INCLUDE_DIR}/ParameterSetRegistry.h
+  ${fhiclcpp_INCLUDE_DIR}/ReloadableDocuments.h
+  ${fhiclcpp_INCLUDE_DIR}/atom_pool.h
+  ${fhiclcpp_INCLUDE_DIR}/bind.h
   ${fhiclcpp_INCLUDE_DIR}/coding.h
   ${fhiclcpp_INCLUDE_DIR}/exception.h
   ${fhiclcpp_INCLUDE_DIR}/extended_value.h
   ${fhiclcpp_INCLUDE_DIR}/fwd.h
+  ${fhiclcpp_INCLUDE_DIR}/frozen_registry.h
   ${fhiclcpp_INCLUDE_DIR}/intermediate_table.h
   ${fhiclcpp_INCLUDE_DIR}/make_ParameterSet.h
+  ${fhiclcpp_INCLUDE_DIR}/number.h
+  ${fhiclcpp_INCLUDE_DIR}/overlay.h
   ${fhiclcpp_INCLUDE_DIR}/parse.h
   ${fhiclcpp_INCLUDE_DIR}/tokens.h
   ${fhiclcpp_INCLUDE_DIR}/type_traits.h
@@ -27,11 +33,17 @@ set(SOURCES
   ${fhiclcpp_INCLUDE_DIR}/ParameterSet.cc
   ${fhiclcpp_INCLUDE_DIR}/ParameterSetID.cc
   ${fhiclcpp_INCLUDE_DIR}/ParameterSetRegistry.cc
+  ${fhiclcpp_INCLUDE_DIR}/ReloadableDocuments.cc
+  ${fhiclcpp_INCLUDE_DIR}/atom_pool.cc
+  ${fhiclcpp_INCLUDE_DIR}/bind.cc
   ${fhiclcpp_INCLUDE_DIR}/coding.cc
   ${fhiclcpp_INCLUDE_DIR}/exception.cc
   ${fhiclcpp_INCLUDE_DIR}/extended_value.cc
+  ${fhiclcpp_INCLUDE_DIR}/frozen_registry.cc
   ${fhiclcpp_INCLUDE_DIR}/intermediate_table.cc
   ${fhiclcpp_INCLUDE_DIR}/make_ParameterSet.cc
+  ${fhiclcpp_INCLUDE_DIR}/number.cc
+  ${fhiclcpp_INCLUDE_DIR}/overlay.cc
   ${fhiclcpp_INCLUDE_DIR}/parse.cc
 )
 
@@ -49,8 +61,14 @@ target_link_libraries(fhicl-write-db
   ${SQLite3_LIBRARIES}
   )
 
+add_executable(fhicl-query-db ${fhiclcpp_INCLUDE_DIR}/fhicl-query-db.cc)
+target_link_libraries(fhicl-query-db
+  FNALCore
+  ${SQLite3_LIBRARIES}
+  )
+
 # TEMP local install of exes
-install(TARGETS fhicl-expand fhicl-write-db
+install(TARGETS fhicl-expand fhicl-write-db fhicl-query-db
   EXPORT FNALCoreExports
   DESTINATION ${CMAKE_INSTALL_BINDIR}
   COMPONENT Runtime
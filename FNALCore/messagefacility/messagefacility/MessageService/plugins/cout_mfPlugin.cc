@@ -1,4 +1,4 @@
-#include "cetlib/PluginTypeDeducer.h"
+#include "cetlib/StaticPluginRegistry.h"
 #include "fhiclcpp/ParameterSet.h"
 
 #include "messagefacility/MessageService/ELdestination.h"
@@ -10,9 +10,10 @@
 using fhicl::ParameterSet;
 using mf::service::ELostreamOutput;
 
-extern "C" {
+namespace {
 
-  auto makePlugin( const std::string&,
+  std::unique_ptr<mf::service::ELdestination>
+  makeDestination( const std::string&,
                    const fhicl::ParameterSet& pset ) {
 
     return std::make_unique<ELostreamOutput>( pset, std::cout );
@@ -21,4 +22,20 @@ extern "C" {
 
 }
 
+#ifdef CET_STATIC_PLUGINS
+CET_REGISTER_STATIC_PLUGIN_FUNC(mfPlugin, cout, makePlugin, makeDestination)
+DEFINE_STATIC_BASIC_PLUGINTYPE_FUNC(mfPlugin, cout, mf::service::ELdestination)
+#else
+extern "C" {
+
+  auto makePlugin( const std::string& psetname,
+                   const fhicl::ParameterSet& pset ) {
+
+    return makeDestination( psetname, pset );
+
+  }
+
+}
+
 DEFINE_BASIC_PLUGINTYPE_FUNC(mf::service::ELdestination)
+#endif
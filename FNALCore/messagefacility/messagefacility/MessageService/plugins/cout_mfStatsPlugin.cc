@@ -1,4 +1,4 @@
-#include "cetlib/PluginTypeDeducer.h"
+#include "cetlib/StaticPluginRegistry.h"
 #include "fhiclcpp/ParameterSet.h"
 
 #include "messagefacility/MessageService/ELdestination.h"
@@ -9,9 +9,10 @@
 
 using mf::service::ELstatistics;
 
-extern "C" {
+namespace {
 
-  auto makePlugin( const std::string&,
+  std::unique_ptr<mf::service::ELdestination>
+  makeDestination( const std::string&,
                    const fhicl::ParameterSet& pset) {
 
     return std::make_unique<ELstatistics>( pset, std::cout );
@@ -20,4 +21,20 @@ extern "C" {
 
 }
 
+#ifdef CET_STATIC_PLUGINS
+CET_REGISTER_STATIC_PLUGIN_FUNC(mfStatsPlugin, cout, makePlugin, makeDestination)
+DEFINE_STATIC_BASIC_PLUGINTYPE_FUNC(mfStatsPlugin, cout, mf::service::ELdestination)
+#else
+extern "C" {
+
+  auto makePlugin( const std::string& psetname,
+                   const fhicl::ParameterSet& pset ) {
+
+    return makeDestination( psetname, pset );
+
+  }
+
+}
+
 DEFINE_BASIC_PLUGINTYPE_FUNC(mf::service::ELdestination)
+#endif
@@ -1,4 +1,4 @@
-#include "cetlib/PluginTypeDeducer.h"
+#include "cetlib/StaticPluginRegistry.h"
 #include "fhiclcpp/ParameterSet.h"
 
 #include "messagefacility/MessageService/ELdestination.h"
@@ -11,10 +11,11 @@
 
 using namespace mf::service;
 
-extern "C" {
+namespace {
 
-  auto makePlugin( const std::string& psetname,
-                   const fhicl::ParameterSet& pset ){
+  std::unique_ptr<mf::service::ELdestination>
+  makeDestination( const std::string& psetname,
+                   const fhicl::ParameterSet& pset ) {
 
     const std::string filename = mfplugins::formatFilename( psetname, pset );
     const bool        append   = pset.get<bool>("append", false);
@@ -25,4 +26,20 @@ extern "C" {
 
 }
 
+#ifdef CET_STATIC_PLUGINS
+CET_REGISTER_STATIC_PLUGIN_FUNC(mfPlugin, file, makePlugin, makeDestination)
+DEFINE_STATIC_BASIC_PLUGINTYPE_FUNC(mfPlugin, file, ELdestination)
+#else
+extern "C" {
+
+  auto makePlugin( const std::string& psetname,
+                   const fhicl::ParameterSet& pset ) {
+
+    return makeDestination( psetname, pset );
+
+  }
+
+}
+
 DEFINE_BASIC_PLUGINTYPE_FUNC(ELdestination)
+#endif
@@ -1,4 +1,4 @@
-#include "cetlib/PluginTypeDeducer.h"
+#include "cetlib/StaticPluginRegistry.h"
 #include "fhiclcpp/ParameterSet.h"
 
 #include "messagefacility/MessageService/ELdestination.h"
@@ -130,9 +130,10 @@ namespace mfplugins {
 //
 //======================================================================
 
-extern "C" {
+namespace {
 
-  auto makePlugin( const std::string&,
+  std::unique_ptr<mf::service::ELdestination>
+  makeDestination( const std::string&,
                    const fhicl::ParameterSet& pset) {
 
     return std::make_unique<mfplugins::ELsyslog>( pset );
@@ -140,4 +141,21 @@ extern "C" {
   }
 
 }
+
+#ifdef CET_STATIC_PLUGINS
+CET_REGISTER_STATIC_PLUGIN_FUNC(mfPlugin, syslog, makePlugin, makeDestination)
+DEFINE_STATIC_BASIC_PLUGINTYPE_FUNC(mfPlugin, syslog, mf::service::ELdestination)
+#else
+extern "C" {
+
+  auto makePlugin( const std::string& psetname,
+                   const fhicl::ParameterSet& pset ) {
+
+    return makeDestination( psetname, pset );
+
+  }
+
+}
+
 DEFINE_BASIC_PLUGINTYPE_FUNC(mf::service::ELdestination)
+#endif
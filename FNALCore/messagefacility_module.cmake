@@ -95,6 +95,32 @@ set(MessageLogger_HEADERS
   )
 set(MessageFacility_HEADERS ${MessageService_HEADERS} ${MessageLogger_HEADERS})
 
+#-----------------------------------------------------------------------
+# Destination plugins
+# Linked in and registered with cet::StaticPluginRegistry rather than
+# built as separate plugin libraries, so the built-in destinations are
+# found without searching LD_LIBRARY_PATH.
+#
+set(MessageFacility_Plugins_HEADERS
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/formatFilename.h
+  )
+set(MessageFacility_Plugins_SOURCES
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/cerr_mfPlugin.cc
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/cerr_mfStatsPlugin.cc
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/cout_mfPlugin.cc
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/cout_mfStatsPlugin.cc
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/file_mfPlugin.cc
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/file_mfStatsPlugin.cc
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/syslog_mfPlugin.cc
+  )
+set_source_files_properties(${MessageFacility_Plugins_SOURCES}
+  PROPERTIES
+    COMPILE_DEFINITIONS CET_STATIC_PLUGINS
+  )
+list(APPEND MessageFacility_Plugins_SOURCES
+  ${messagefacility_INCLUDE_DIR}/MessageService/plugins/formatFilename.cc
+  )
+
 set(MessageFacility_SOURCES
   ${messagefacility_INCLUDE_DIR}/MessageService/ELadministrator.cc
   ${messagefacility_INCLUDE_DIR}/MessageService/ELcollected.cc
@@ -147,6 +173,8 @@ add_library(obj-messagefacility OBJECT
   ${MessageFacility_SOURCES}
   ${MessageFacility_Utilities_HEADERS}
   ${MessageFacility_Utilities_SOURCES}
+  ${MessageFacility_Plugins_HEADERS}
+  ${MessageFacility_Plugins_SOURCES}
   )
 
 # TEMP local install of headers